@@ -81,6 +81,79 @@ class DelegateDecoderOperation
           return new_shape;
         }
    }
+   else if (op_type_ == "CONV_2D") {
+     TfLiteConvParams* data = reinterpret_cast<TfLiteConvParams*>(builtin_data_);
+     if (name == "padding")
+       return tflite::openvinodelegate::get_padding_string(data->padding);
+     if (name == "stride_h") return data->stride_height;
+     if (name == "stride_w") return data->stride_width;
+     if (name == "dilation_h_factor") return data->dilation_height_factor;
+     if (name == "dilation_w_factor") return data->dilation_width_factor;
+     if (name == "fused_activation_function")
+       return tflite::openvinodelegate::get_activation_string(data->activation);
+   }
+   else if (op_type_ == "DEPTHWISE_CONV_2D") {
+     TfLiteDepthwiseConvParams* data =
+         reinterpret_cast<TfLiteDepthwiseConvParams*>(builtin_data_);
+     if (name == "padding")
+       return tflite::openvinodelegate::get_padding_string(data->padding);
+     if (name == "stride_h") return data->stride_height;
+     if (name == "stride_w") return data->stride_width;
+     if (name == "dilation_h_factor") return data->dilation_height_factor;
+     if (name == "dilation_w_factor") return data->dilation_width_factor;
+     if (name == "depth_multiplier") return data->depth_multiplier;
+     if (name == "fused_activation_function")
+       return tflite::openvinodelegate::get_activation_string(data->activation);
+   }
+   else if (op_type_ == "AVERAGE_POOL_2D" || op_type_ == "MAX_POOL_2D") {
+     TfLitePoolParams* data = reinterpret_cast<TfLitePoolParams*>(builtin_data_);
+     if (name == "padding")
+       return tflite::openvinodelegate::get_padding_string(data->padding);
+     if (name == "stride_h") return data->stride_height;
+     if (name == "stride_w") return data->stride_width;
+     if (name == "filter_height") return data->filter_height;
+     if (name == "filter_width") return data->filter_width;
+     if (name == "fused_activation_function")
+       return tflite::openvinodelegate::get_activation_string(data->activation);
+   }
+   else if (op_type_ == "TRANSPOSE_CONV") {
+     TfLiteTransposeConvParams* data =
+         reinterpret_cast<TfLiteTransposeConvParams*>(builtin_data_);
+     if (name == "padding")
+       return tflite::openvinodelegate::get_padding_string(data->padding);
+     if (name == "stride_h") return data->stride_height;
+     if (name == "stride_w") return data->stride_width;
+     if (name == "fused_activation_function")
+       return tflite::openvinodelegate::get_activation_string(data->activation);
+   }
+   else if (op_type_ == "CONCATENATION") {
+     TfLiteConcatenationParams* data =
+         reinterpret_cast<TfLiteConcatenationParams*>(builtin_data_);
+     if (name == "axis") return static_cast<int64_t>(data->axis);
+     if (name == "fused_activation_function")
+       return tflite::openvinodelegate::get_activation_string(data->activation);
+   }
+   else if (name == "fused_activation_function" && op_type_ == "MUL") {
+     TfLiteMulParams* data = reinterpret_cast<TfLiteMulParams*>(builtin_data_);
+     return tflite::openvinodelegate::get_activation_string(data->activation);
+   }
+   else if (name == "keep_dims" && op_type_ == "MEAN") {
+     TfLiteReducerParams* data =
+         reinterpret_cast<TfLiteReducerParams*>(builtin_data_);
+     return data->keep_dims;
+   }
+   else if (name == "beta" && op_type_ == "SOFTMAX") {
+     TfLiteSoftmaxParams* data =
+         reinterpret_cast<TfLiteSoftmaxParams*>(builtin_data_);
+     return data->beta;
+   }
+   else if (op_type_ == "RESIZE_BILINEAR") {
+     TfLiteResizeBilinearParams* data =
+         reinterpret_cast<TfLiteResizeBilinearParams*>(builtin_data_);
+     if (name == "align_corners") return data->align_corners;
+     if (name == "half_pixel_centers") return data->half_pixel_centers;
+   }
+   return {};
   }
 
   void set_op_builtin_data(void* builtin_data) {
@@ -1,10 +1,173 @@
 #include "graph_iterator_delegate.h"
 
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "delegate_decoder.h"
 #include "operations/utility.h"
+#include "Eigen/Core"
+#ifndef OPENVINO_DELEGATE_STABLE_ABI
+#include "tensorflow/lite/kernels/internal/utils/sparsity_format_converter.h"
+#endif
+#include "tensorflow/lite/tools/logging.h"
 
 namespace tflite {
 namespace openvinodelegate {
+namespace {
+
+// Hands TfLite's affine quantization parameters to the frontend, which turns
+// quantized tensors into FakeQuantize patterns the CPU plugin lowers to int8
+// kernels. Returns nullptr for tensors that are not quantized.
+std::shared_ptr<ov::frontend::tensorflow_lite::QuantizationInfo>
+GetQuantizationInfo(const TfLiteOpaqueTensor* opaque_tensor) {
+  const TfLiteQuantization quantization =
+      TfLiteOpaqueTensorGetQuantization(opaque_tensor);
+  if (quantization.type != kTfLiteAffineQuantization ||
+      quantization.params == nullptr)
+    return nullptr;
+  const auto* affine_quantization =
+      reinterpret_cast<const TfLiteAffineQuantization*>(quantization.params);
+  const TfLiteFloatArray* scale = affine_quantization->scale;
+  const TfLiteIntArray* zero_point = affine_quantization->zero_point;
+  if (scale == nullptr || scale->size == 0) return nullptr;
+
+  auto quantization_info =
+      std::make_shared<ov::frontend::tensorflow_lite::QuantizationInfo>();
+  quantization_info->set_scale(
+      std::vector<float>(scale->data, scale->data + scale->size));
+  std::vector<int64_t> zero_points(scale->size, 0);
+  if (zero_point != nullptr && zero_point->size == scale->size)
+    zero_points.assign(zero_point->data, zero_point->data + zero_point->size);
+  quantization_info->set_zero_point(zero_points);
+  quantization_info->set_axis(affine_quantization->quantized_dimension);
+  return quantization_info;
+}
+
+#ifndef OPENVINO_DELEGATE_STABLE_ABI
+template <typename T>
+bool SparseToDense(const std::vector<int>& dense_shape,
+                   const TfLiteSparsity& sparsity, const void* sparse_data,
+                   std::vector<uint8_t>& dense) {
+  tflite::internal::sparsity::FormatConverter<T> converter(dense_shape,
+                                                          sparsity);
+  return converter.SparseToDense(static_cast<const T*>(sparse_data),
+                                 dense.size() / sizeof(T),
+                                 reinterpret_cast<T*>(dense.data()),
+                                 /*context=*/nullptr) == kTfLiteOk;
+}
+#endif
+
+// Maps the builtin codes CheckNodeSupportByOpenVINO claims to the op type
+// names the TfLite frontend registers translators under. Anything else gets
+// an empty type, which the frontend rejects at conversion.
+std::string GetOpType(int builtin_code) {
+  switch (builtin_code) {
+    case kTfLiteBuiltinAdd:
+      return "ADD";
+    case kTfLiteBuiltinAveragePool2d:
+      return "AVERAGE_POOL_2D";
+    case kTfLiteBuiltinConcatenation:
+      return "CONCATENATION";
+    case kTfLiteBuiltinConv2d:
+      return "CONV_2D";
+    case kTfLiteBuiltinDepthwiseConv2d:
+      return "DEPTHWISE_CONV_2D";
+    case kTfLiteBuiltinDequantize:
+      return "DEQUANTIZE";
+    case kTfLiteBuiltinHardSwish:
+      return "HARD_SWISH";
+    case kTfLiteBuiltinLogistic:
+      return "LOGISTIC";
+    case kTfLiteBuiltinMaxPool2d:
+      return "MAX_POOL_2D";
+    case kTfLiteBuiltinMean:
+      return "MEAN";
+    case kTfLiteBuiltinMul:
+      return "MUL";
+    case kTfLiteBuiltinPad:
+      return "PAD";
+    case kTfLiteBuiltinQuantize:
+      return "QUANTIZE";
+    case kTfLiteBuiltinRelu:
+      return "RELU";
+    case kTfLiteBuiltinRelu6:
+      return "RELU6";
+    case kTfLiteBuiltinReshape:
+      return "RESHAPE";
+    case kTfLiteBuiltinResizeBilinear:
+      return "RESIZE_BILINEAR";
+    case kTfLiteBuiltinSoftmax:
+      return "SOFTMAX";
+    case kTfLiteBuiltinTanh:
+      return "TANH";
+    case kTfLiteBuiltinTransposeConv:
+      return "TRANSPOSE_CONV";
+    default:
+      return "";
+  }
+}
+
+}  // namespace
+
+TfLiteStatus GraphIteratorDelegate::DensifyConstant(
+    const TfLiteOpaqueNode* densify_node) {
+#ifdef OPENVINO_DELEGATE_STABLE_ABI
+  // The delegate does not claim DENSIFY in the stable build: the sparsity
+  // parameters are only reachable through TfLiteTensor.
+  return kTfLiteError;
+#else
+  if (TfLiteOpaqueNodeNumberOfInputs(densify_node) != 1 ||
+      TfLiteOpaqueNodeNumberOfOutputs(densify_node) != 1)
+    return kTfLiteError;
+  const int* inputs_data = nullptr;
+  int num_inputs = 0;
+  const int* outputs_data = nullptr;
+  int num_outputs = 0;
+  TfLiteOpaqueNodeInputs(densify_node, &inputs_data, &num_inputs);
+  TfLiteOpaqueNodeOutputs(densify_node, &outputs_data, &num_outputs);
+
+  // The opaque API does not expose the sparsity parameters.
+  const TfLiteTensor* sparse_tensor = reinterpret_cast<const TfLiteTensor*>(
+      TfLiteOpaqueContextGetOpaqueTensor(context_, inputs_data[0]));
+  const TfLiteOpaqueTensor* dense_tensor =
+      TfLiteOpaqueContextGetOpaqueTensor(context_, outputs_data[0]);
+  if (sparse_tensor->sparsity == nullptr ||
+      sparse_tensor->data.raw == nullptr)
+    return kTfLiteError;
+
+  std::vector<int> dense_shape(TfLiteOpaqueTensorNumDims(dense_tensor));
+  for (int i = 0; i < dense_shape.size(); i++)
+    dense_shape[i] = TfLiteOpaqueTensorDim(dense_tensor, i);
+  std::vector<uint8_t> dense(TfLiteOpaqueTensorByteSize(dense_tensor));
+  bool densified = false;
+  switch (sparse_tensor->type) {
+    case kTfLiteFloat32:
+      densified = SparseToDense<float>(dense_shape, *sparse_tensor->sparsity,
+                                       sparse_tensor->data.raw, dense);
+      break;
+    case kTfLiteFloat16:
+      densified = SparseToDense<Eigen::half>(
+          dense_shape, *sparse_tensor->sparsity, sparse_tensor->data.raw,
+          dense);
+      break;
+    case kTfLiteInt8:
+      densified = SparseToDense<int8_t>(dense_shape, *sparse_tensor->sparsity,
+                                        sparse_tensor->data.raw, dense);
+      break;
+    default:
+      break;
+  }
+  if (!densified) {
+    TFLITE_LOG(ERROR) << "Could not densify sparse tensor " << inputs_data[0];
+    return kTfLiteError;
+  }
+  dense_constants_[outputs_data[0]] = std::move(dense);
+  return kTfLiteOk;
+#endif
+}
+
 size_t GraphIteratorDelegate::size() const {
   return graph_nodes_.size() + input_nodes_.size() + output_nodes_.size();
 }
@@ -38,17 +201,10 @@ GraphIteratorDelegate::get_decoder() const {
         TfLiteRegistrationExternalGetBuiltInCode(delegate_node_registration);
     std::string op_type, op_name;
 
-    // move below logic to helper function;
-    if (builtin_code == kTfLiteBuiltinLogistic) {
-      op_type = "LOGISTIC";
-    }
-    else if(builtin_code == kTfLiteBuiltinReshape) {
-      op_type = "RESHAPE";
-    }
-    else if(builtin_code == kTfLiteBuiltinAdd) {
-      op_type = "ADD";   
-    }
-    op_name = op_type + "_" + std::to_string(node_index_);
+    op_type = GetOpType(builtin_code);
+    // The TfLite node index in the name lets profiling attribute OpenVINO
+    // layers back to TfLite nodes.
+    op_name = op_type + "_" + std::to_string(delegate_node_id);
     int num_inputs = 0;
     const int* input_data = nullptr;
     int intput_index;
@@ -72,6 +228,10 @@ GraphIteratorDelegate::get_decoder() const {
       tensor_meta_info.m_element_type = ov_element_type;
       tensor_meta_info.m_tensor_name = TfLiteOpaqueTensorName(opaque_tensor); // "input";
       tensor_meta_info.m_tensor_data  = (const uint8_t*)TfLiteOpaqueTensorData(opaque_tensor);
+      auto dense_constant = dense_constants_.find(input_data[k]);
+      if (dense_constant != dense_constants_.end())
+        tensor_meta_info.m_tensor_data = dense_constant->second.data();
+      tensor_meta_info.m_quantization_info = GetQuantizationInfo(opaque_tensor);
       if (tensor_meta_info.m_tensor_data == NULL) {
         std::cout << "Line number : " << __LINE__ << " in file " << __FILE__<< ":::> nullptr : node_index = " << node_index_ << " delegate_node_id = " << delegate_node_id << "\n";
       }
@@ -102,6 +262,7 @@ GraphIteratorDelegate::get_decoder() const {
       tensor_meta_info.m_partial_shape = tensor_shape;
       tensor_meta_info.m_element_type = ov_element_type;
       tensor_meta_info.m_tensor_name = TfLiteOpaqueTensorName(opaque_tensor); // "input";
+      tensor_meta_info.m_quantization_info = GetQuantizationInfo(opaque_tensor);
 
       output_meta_info.push_back(tensor_meta_info);
     }
@@ -129,6 +290,7 @@ GraphIteratorDelegate::get_decoder() const {
     int64_t input_index = node_index_;
     int64_t output_index = -1;
     tensor_meta_info.m_tensor_name = TfLiteOpaqueTensorName(opaque_tensor); //"input" + std::to_string(input_index);
+    tensor_meta_info.m_quantization_info = GetQuantizationInfo(opaque_tensor);
     // input_index_ = input_index_ + 1;
     std::cout << __LINE__ << " " << __FILE__ << "Creating " << tensor_meta_info.m_tensor_name << " Decoder tensor ip \n";
         std::cout << __LINE__ << " " << __FILE__ << input_index << " " << output_index << " Decoder tensor\n";  
@@ -152,6 +314,7 @@ GraphIteratorDelegate::get_decoder() const {
       int64_t input_index = -1;
       int64_t output_index = node_index_ - input_nodes_.size();
       tensor_meta_info.m_tensor_name = TfLiteOpaqueTensorName(opaque_tensor); // "output" + std::to_string(output_index);
+      tensor_meta_info.m_quantization_info = GetQuantizationInfo(opaque_tensor);
     std::cout << __LINE__ << " " << __FILE__ << "Creating " << tensor_meta_info.m_tensor_name << " Decoder tensor op\n";
     std::cout << __LINE__ << " " << __FILE__ << input_index << " " << output_index << " Decoder tensor\n";
     return std::make_shared<DelegateDecoderTensor>(
@@ -1,4 +1,7 @@
+#include <cstdint>
+#include <map>
 #include <unordered_set>
+#include <vector>
 
 #include "openvino/frontend/tensorflow_lite/graph_iterator.hpp"
 
@@ -29,6 +32,13 @@ class GraphIteratorDelegate
       TfLiteOpaqueContextGetNodeAndRegistration(
               context, delegate_node_id, &delegate_node,
               &delegate_node_registration);
+      if (TfLiteRegistrationExternalGetBuiltInCode(
+              delegate_node_registration) == kTfLiteBuiltinDensify) {
+        // Sparse weights are densified once here; consumers then see the
+        // DENSIFY output as a plain constant.
+        if (DensifyConstant(delegate_node) != kTfLiteOk) status_ = kTfLiteError;
+        continue;
+      }
 
       int inputs_size = TfLiteOpaqueNodeNumberOfInputs(delegate_node);
       for (int k = 0; k < inputs_size; k++) {
@@ -69,6 +79,14 @@ class GraphIteratorDelegate
     }
     for (int i = 0; i < params->nodes_to_replace->size; i++) {
       const int delegate_node_id = params->nodes_to_replace->data[i];
+      TfLiteOpaqueNode* delegate_node;
+      TfLiteRegistrationExternal* delegate_node_registration;
+      TfLiteOpaqueContextGetNodeAndRegistration(
+              context, delegate_node_id, &delegate_node,
+              &delegate_node_registration);
+      if (TfLiteRegistrationExternalGetBuiltInCode(
+              delegate_node_registration) == kTfLiteBuiltinDensify)
+        continue;
       graph_nodes_.push_back(delegate_node_id);  // Operation : 0
     }
 /*
@@ -95,6 +113,17 @@ class GraphIteratorDelegate
   std::vector<int> get_compute_inputs() {
     return input_nodes_;
   }
+
+  // kTfLiteError if a sparse constant could not be densified; the frontend
+  // must not be handed the graph then.
+  TfLiteStatus get_status() const { return status_; }
+
+  // Bytes of the densified sparse weights held for the frontend.
+  size_t get_densified_bytes() const {
+    size_t bytes = 0;
+    for (const auto& constant : dense_constants_) bytes += constant.second.size();
+    return bytes;
+  }
   /// \brief Get a number of operation nodes in the graph
   size_t size() const override;
 
@@ -131,6 +160,11 @@ class GraphIteratorDelegate
   std::vector<int> input_nodes_;
   TfLiteOpaqueContext* context_;
   const TfLiteOpaqueDelegateParams* params_;
+  // Dense contents of DENSIFY outputs, keyed by tensor index.
+  std::map<int, std::vector<uint8_t>> dense_constants_;
+  TfLiteStatus status_ = kTfLiteOk;
+
+  TfLiteStatus DensifyConstant(const TfLiteOpaqueNode* densify_node);
   // std::unordered_set<int> ;
 };
 }  // namespace openvinodelegate
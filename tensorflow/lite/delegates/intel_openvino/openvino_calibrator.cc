@@ -0,0 +1,331 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "tensorflow/lite/delegates/intel_openvino/openvino_calibrator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <map>
+#include <utility>
+
+#include "tensorflow/lite/tools/logging.h"
+
+namespace tflite {
+namespace openvinodelegate {
+
+namespace {
+
+// A tensor of the f32 model that gets a FakeQuantize. Activation ranges are
+// observed during calibration; weights are constant and read directly.
+struct CalibrationPoint {
+  ov::Output<ov::Node> source;
+  std::vector<ov::Input<ov::Node>> consumers;
+  // Set if |source| is constant.
+  std::shared_ptr<ov::op::v0::Constant> weights;
+  float min = std::numeric_limits<float>::max();
+  float max = std::numeric_limits<float>::lowest();
+};
+
+bool IsConstant(const ov::Output<ov::Node> &output) {
+  return ov::is_type<ov::op::v0::Constant>(output.get_node_shared_ptr());
+}
+
+// The constant |output| evaluates to, folding the Transpose or Reshape the
+// frontend may put between a weight and its consumer; nullptr if |output|
+// depends on a parameter.
+std::shared_ptr<ov::op::v0::Constant> FoldConstant(
+    const ov::Output<ov::Node> &output) {
+  const std::shared_ptr<ov::Node> node = output.get_node_shared_ptr();
+  if (auto constant = ov::as_type_ptr<ov::op::v0::Constant>(node))
+    return constant;
+  ov::OutputVector inputs;
+  for (const auto &input : node->input_values()) {
+    std::shared_ptr<ov::op::v0::Constant> folded = FoldConstant(input);
+    if (folded == nullptr) return nullptr;
+    inputs.push_back(folded);
+  }
+  ov::OutputVector outputs(node->get_output_size());
+  if (inputs.empty() || !node->constant_fold(outputs, inputs)) return nullptr;
+  return ov::as_type_ptr<ov::op::v0::Constant>(
+      outputs[output.get_index()].get_node_shared_ptr());
+}
+
+// Axes of the output channels in the weights |input| reads, empty if the
+// input is not the weights of a Convolution or MatMul.
+std::vector<size_t> GetOutputChannelAxes(const ov::Input<ov::Node> &input) {
+  const ov::Node *op = input.get_node();
+  if (input.get_index() != 1) return {};
+  if (ov::is_type<ov::op::v1::Convolution>(op)) return {0};
+  // [groups, out / groups, in / groups, ...]
+  if (ov::is_type<ov::op::v1::GroupConvolution>(op)) return {0, 1};
+  // [in, out, ...]
+  if (ov::is_type<ov::op::v1::ConvolutionBackpropData>(op)) return {1};
+  if (const auto *matmul = ov::as_type<const ov::op::v0::MatMul>(op)) {
+    const size_t rank = input.get_partial_shape().rank().get_length();
+    if (rank < 2) return {};
+    return {matmul->get_transpose_b() ? rank - 2 : rank - 1};
+  }
+  return {};
+}
+
+// Symmetric 255-level FakeQuantize of |point|'s weights with one range per
+// output channel, or a single range if the consumers disagree on the
+// channels.
+std::shared_ptr<ov::op::v0::FakeQuantize> QuantizeWeights(
+    const CalibrationPoint &point) {
+  std::vector<size_t> channel_axes =
+      GetOutputChannelAxes(point.consumers.front());
+  for (const auto &consumer : point.consumers) {
+    if (GetOutputChannelAxes(consumer) != channel_axes) channel_axes.clear();
+  }
+  const ov::Shape &shape = point.weights->get_shape();
+  ov::Shape range_shape(shape.size(), 1);
+  for (size_t axis : channel_axes) range_shape[axis] = shape[axis];
+
+  const std::vector<float> values = point.weights->cast_vector<float>();
+  std::vector<float> range(ov::shape_size(range_shape), 0.0f);
+  // Walk the weights in order, tracking the coordinate of each value.
+  std::vector<size_t> coordinate(shape.size(), 0);
+  for (float value : values) {
+    size_t channel = 0;
+    for (size_t axis = 0; axis < shape.size(); axis++)
+      channel = channel * range_shape[axis] +
+                (range_shape[axis] == 1 ? 0 : coordinate[axis]);
+    if (std::isfinite(value))
+      range[channel] = std::max(range[channel], std::abs(value));
+    for (size_t axis = shape.size(); axis-- > 0;) {
+      if (++coordinate[axis] < shape[axis]) break;
+      coordinate[axis] = 0;
+    }
+  }
+  // Any range keeps an all-zero channel exact.
+  std::vector<float> low(range.size());
+  for (size_t c = 0; c < range.size(); c++) {
+    if (!(range[c] > 0)) range[c] = 1.0f;
+    low[c] = -range[c];
+  }
+  auto low_node =
+      ov::op::v0::Constant::create(ov::element::f32, range_shape, low);
+  auto high_node =
+      ov::op::v0::Constant::create(ov::element::f32, range_shape, range);
+  return std::make_shared<ov::op::v0::FakeQuantize>(
+      point.source, low_node, high_node, low_node, high_node, 255);
+}
+
+// Inputs of |op| that get a FakeQuantize. Convolutions and MatMuls quantize
+// activations and weights; element-wise ops only when both operands are
+// activations, since a constant operand is folded into the int8 kernel.
+std::vector<size_t> GetQuantizedInputs(const std::shared_ptr<ov::Node> &op) {
+  if (ov::is_type<ov::op::v1::Convolution>(op) ||
+      ov::is_type<ov::op::v1::GroupConvolution>(op) ||
+      ov::is_type<ov::op::v1::ConvolutionBackpropData>(op) ||
+      ov::is_type<ov::op::v0::MatMul>(op))
+    return {0, 1};
+  if (ov::is_type<ov::op::v1::Add>(op) ||
+      ov::is_type<ov::op::v1::Multiply>(op)) {
+    if (IsConstant(op->input_value(0)) || IsConstant(op->input_value(1)))
+      return {};
+    return {0, 1};
+  }
+  return {};
+}
+
+std::vector<CalibrationPoint> FindCalibrationPoints(
+    const std::shared_ptr<ov::Model> &model) {
+  std::vector<CalibrationPoint> points;
+  std::map<std::pair<ov::Node *, size_t>, size_t> point_index;
+  for (const auto &op : model->get_ordered_ops()) {
+    for (size_t port : GetQuantizedInputs(op)) {
+      ov::Input<ov::Node> input = op->input(port);
+      ov::Output<ov::Node> source = input.get_source_output();
+      if (source.get_element_type() != ov::element::f32) continue;
+      const auto key = std::make_pair(source.get_node(), source.get_index());
+      auto it = point_index.find(key);
+      if (it == point_index.end()) {
+        it = point_index.emplace(key, points.size()).first;
+        points.emplace_back();
+        points.back().source = source;
+        points.back().weights = FoldConstant(source);
+      }
+      points[it->second].consumers.push_back(input);
+    }
+  }
+  return points;
+}
+
+void UpdateRange(const ov::Tensor &tensor, CalibrationPoint &point) {
+  const float *data = tensor.data<float>();
+  for (size_t i = 0; i < tensor.get_size(); i++) {
+    if (!std::isfinite(data[i])) continue;
+    point.min = std::min(point.min, data[i]);
+    point.max = std::max(point.max, data[i]);
+  }
+}
+
+}  // namespace
+
+std::vector<std::vector<ov::Tensor>> LoadRepresentativeSamples(
+    const std::shared_ptr<ov::Model> &model,
+    const std::vector<int> &input_tensors,
+    const TfLiteOpenVINORepresentativeDataset &dataset, int max_samples) {
+  std::vector<std::vector<ov::Tensor>> samples;
+  for (int s = 0; s < max_samples; s++) {
+    std::vector<ov::Tensor> sample;
+    for (size_t i = 0; i < model->inputs().size(); i++) {
+      const ov::Output<ov::Node> &input = model->input(i);
+      if (input.get_element_type() != ov::element::f32 ||
+          input.get_partial_shape().is_dynamic() ||
+          i >= input_tensors.size())
+        return {};
+      ov::Tensor tensor(ov::element::f32, input.get_shape());
+      if (!dataset(s, input_tensors[i], tensor.data(), tensor.get_byte_size()))
+        return samples;
+      sample.push_back(tensor);
+    }
+    samples.push_back(sample);
+  }
+  return samples;
+}
+
+std::vector<std::vector<ov::Tensor>> RunSamples(
+    ov::CompiledModel &compiled_model,
+    const std::vector<std::vector<ov::Tensor>> &samples) {
+  std::vector<std::vector<ov::Tensor>> results;
+  ov::InferRequest infer_request = compiled_model.create_infer_request();
+  for (const auto &sample : samples) {
+    for (size_t i = 0; i < sample.size(); i++)
+      infer_request.set_input_tensor(i, sample[i]);
+    infer_request.infer();
+    std::vector<ov::Tensor> outputs;
+    for (const auto &output : compiled_model.outputs()) {
+      const ov::Tensor &tensor = infer_request.get_tensor(output);
+      ov::Tensor copy(tensor.get_element_type(), tensor.get_shape());
+      tensor.copy_to(copy);
+      outputs.push_back(copy);
+    }
+    results.push_back(outputs);
+  }
+  return results;
+}
+
+TfLiteStatus Calibrator::Calibrate(
+    const std::shared_ptr<ov::Model> &model,
+    const std::vector<int> &input_tensors,
+    const TfLiteOpenVINORepresentativeDataset &dataset, int max_samples,
+    CalibrationReport *report) {
+  if (model == nullptr || !dataset || report == nullptr) return kTfLiteError;
+  *report = CalibrationReport();
+  for (const auto &op : model->get_ordered_ops()) {
+    // Already quantized, e.g. loaded from a calibrated cache entry.
+    if (ov::is_type<ov::op::v0::FakeQuantize>(op)) return kTfLiteOk;
+  }
+
+  std::vector<std::vector<ov::Tensor>> samples =
+      LoadRepresentativeSamples(model, input_tensors, dataset, max_samples);
+  if (samples.empty()) return kTfLiteError;
+  std::vector<CalibrationPoint> points = FindCalibrationPoints(model);
+  if (points.empty()) return kTfLiteOk;
+
+  // f32 pass: expose every activation as an extra result. The outputs are
+  // also the reference the int8 model is compared against.
+  const size_t num_outputs = model->get_results().size();
+  ov::ResultVector probes;
+  std::vector<CalibrationPoint *> activations;
+  for (auto &point : points) {
+    if (point.weights != nullptr) continue;
+    probes.push_back(std::make_shared<ov::op::v0::Result>(point.source));
+    activations.push_back(&point);
+  }
+  model->add_results(probes);
+  std::vector<std::vector<ov::Tensor>> reference;
+  try {
+    ov::CompiledModel compiled_model = ov_core_->compile_model(
+        model, device_type_,
+        ov::hint::inference_precision(ov::element::f32));
+    reference = RunSamples(compiled_model, samples);
+  } catch (const std::exception &e) {
+    TFLITE_LOG(ERROR) << "Calibration run failed: " << e.what();
+  }
+  for (const auto &probe : probes) model->remove_result(probe);
+  if (reference.empty()) return kTfLiteError;
+
+  for (const auto &outputs : reference) {
+    for (size_t p = 0; p < activations.size(); p++)
+      UpdateRange(outputs[num_outputs + p], *activations[p]);
+  }
+
+  // Quantize: activations over the observed range, widened to include 0 so
+  // that zero padding stays exact; weights per output channel.
+  for (auto &point : points) {
+    if (point.weights != nullptr) {
+      auto fake_quantize = QuantizeWeights(point);
+      for (auto &consumer : point.consumers)
+        consumer.replace_source_output(fake_quantize->output(0));
+      report->quantized_tensors++;
+      continue;
+    }
+    const float low = std::min(point.min, 0.0f);
+    const float high = std::max(point.max, 0.0f);
+    if (!(high > low)) continue;
+    auto low_node =
+        ov::op::v0::Constant::create(ov::element::f32, ov::Shape{}, {low});
+    auto high_node =
+        ov::op::v0::Constant::create(ov::element::f32, ov::Shape{}, {high});
+    auto fake_quantize = std::make_shared<ov::op::v0::FakeQuantize>(
+        point.source, low_node, high_node, low_node, high_node, 256);
+    for (auto &consumer : point.consumers)
+      consumer.replace_source_output(fake_quantize->output(0));
+    report->quantized_tensors++;
+  }
+  model->validate_nodes_and_infer_types();
+
+  // Accuracy of the int8 model against the f32 outputs.
+  std::vector<std::vector<ov::Tensor>> quantized;
+  try {
+    ov::CompiledModel compiled_model =
+        ov_core_->compile_model(model, device_type_);
+    quantized = RunSamples(compiled_model, samples);
+  } catch (const std::exception &e) {
+    TFLITE_LOG(ERROR) << "Quantized model failed to run: " << e.what();
+  }
+  if (quantized.empty()) {
+    for (auto &point : points) {
+      for (auto &consumer : point.consumers)
+        consumer.replace_source_output(point.source);
+    }
+    model->validate_nodes_and_infer_types();
+    *report = CalibrationReport();
+    return kTfLiteError;
+  }
+
+  double max_abs_error = 0;
+  double sum_abs_error = 0;
+  size_t count = 0;
+  for (size_t s = 0; s < samples.size(); s++) {
+    for (size_t o = 0; o < num_outputs; o++) {
+      const ov::Tensor &expected = reference[s][o];
+      const ov::Tensor &actual = quantized[s][o];
+      if (expected.get_element_type() != ov::element::f32 ||
+          actual.get_size() != expected.get_size())
+        continue;
+      for (size_t i = 0; i < expected.get_size(); i++) {
+        const double error =
+            std::abs(expected.data<float>()[i] - actual.data<float>()[i]);
+        max_abs_error = std::max(max_abs_error, error);
+        sum_abs_error += error;
+        count++;
+      }
+    }
+  }
+  report->samples = samples.size();
+  report->max_abs_error = max_abs_error;
+  report->mean_abs_error = count > 0 ? sum_abs_error / count : 0;
+  return kTfLiteOk;
+}
+
+}  // namespace openvinodelegate
+}  // namespace tflite
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef DELEGATE_INTEL_OPENVINO_OPENVINO_CALIBRATOR_H_
+#define DELEGATE_INTEL_OPENVINO_OPENVINO_CALIBRATOR_H_
+
+#include <openvino/openvino.hpp>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_delegate.h"
+
+namespace tflite {
+namespace openvinodelegate {
+
+// Outcome of calibrating one partition, comparing the int8 model against the
+// f32 one on the calibration samples.
+struct CalibrationReport {
+  int samples = 0;
+  // Tensors a FakeQuantize was inserted on.
+  int quantized_tensors = 0;
+  double max_abs_error = -1;
+  double mean_abs_error = -1;
+};
+
+// Draws up to |max_samples| samples from |dataset| for the parameters of
+// |model|, which are fed from the TfLite tensors |input_tensors|. Returns no
+// samples if the model has a parameter that is not a static f32 tensor.
+std::vector<std::vector<ov::Tensor>> LoadRepresentativeSamples(
+    const std::shared_ptr<ov::Model> &model,
+    const std::vector<int> &input_tensors,
+    const TfLiteOpenVINORepresentativeDataset &dataset, int max_samples);
+
+// Runs |samples| through |compiled_model| and returns copies of all outputs
+// of every sample.
+std::vector<std::vector<ov::Tensor>> RunSamples(
+    ov::CompiledModel &compiled_model,
+    const std::vector<std::vector<ov::Tensor>> &samples);
+
+// Post-training int8 calibration of a converted partition. The f32 model is
+// run over the representative dataset with the activation inputs of every
+// Convolution, MatMul, Add and Multiply exposed as extra results to collect
+// their ranges; a FakeQuantize with those ranges is then inserted in front
+// of each of them so that the CPU plugin's low precision transformations run
+// the ops in int8. Weights need no samples: they get a symmetric FakeQuantize
+// with one range per output channel, taken from the constant itself.
+class Calibrator {
+ public:
+  Calibrator(std::shared_ptr<ov::Core> ov_core, std::string device_type)
+      : ov_core_(std::move(ov_core)), device_type_(std::move(device_type)) {}
+
+  // Quantizes |model| in place. |input_tensors| are the TfLite tensors the
+  // model parameters are fed from, in order. On failure the model is left
+  // in f32.
+  TfLiteStatus Calibrate(const std::shared_ptr<ov::Model> &model,
+                         const std::vector<int> &input_tensors,
+                         const TfLiteOpenVINORepresentativeDataset &dataset,
+                         int max_samples, CalibrationReport *report);
+
+ private:
+  std::shared_ptr<ov::Core> ov_core_;
+  std::string device_type_;
+};
+
+}  // namespace openvinodelegate
+}  // namespace tflite
+
+#endif  // DELEGATE_INTEL_OPENVINO_OPENVINO_CALIBRATOR_H_
@@ -5,17 +5,81 @@
 
 #include "tensorflow/lite/delegates/intel_openvino/openvino_delegate.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "tensorflow/lite/delegates/intel_openvino/openvino_delegate_kernel.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_partition_compiler.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_tracer.h"
 #include "tensorflow/lite/builtin_ops.h"
 #include "tensorflow/lite/c/c_api_opaque.h"
 #include "tensorflow/lite/c/c_api_types.h"
 #include "tensorflow/lite/delegates/utils/simple_opaque_delegate.h"
+#include "tensorflow/lite/tools/logging.h"
 
 namespace tflite {
 namespace openvinodelegate {
+namespace {
+
+// Partitions are calibrated on the partition compiler's workers, so the
+// callbacks of one delegate are called under |mutex| one at a time.
+TfLiteOpenVINORepresentativeDataset SerializeDataset(
+    TfLiteOpenVINORepresentativeDataset dataset,
+    std::shared_ptr<std::mutex> mutex) {
+  if (!dataset) return dataset;
+  return [dataset = std::move(dataset), mutex = std::move(mutex)](
+             int sample_index, int tensor_index, void *data,
+             size_t bytes) -> bool {
+    std::lock_guard<std::mutex> lock(*mutex);
+    return dataset(sample_index, tensor_index, data, bytes);
+  };
+}
+
+}  // namespace
+
+OpenVINODelegate::OpenVINODelegate(
+    const TfLiteOpenVINODelegateOptions *options) {
+  if (options == nullptr) {
+    TfLiteOpenVINODelegateOptions default_opt;
+    options_ = default_opt;
+  } else {
+    options_ = *options;
+  }
+  auto dataset_mutex = std::make_shared<std::mutex>();
+  options_.representative_dataset =
+      SerializeDataset(options_.representative_dataset, dataset_mutex);
+  options_.validation_dataset =
+      SerializeDataset(options_.validation_dataset, dataset_mutex);
+#ifdef OPENVINO_DELEGATE_STABLE_ABI
+  // The TfLite kernel fallback needs TfLiteContext internals that the opaque
+  // ABI does not expose.
+  if (options_.async_compilation) {
+    TFLITE_LOG(WARN) << "async_compilation is not available in the stable "
+                        "delegate build; compiling synchronously";
+    options_.async_compilation = false;
+  }
+#endif
+  if (options_.enable_tracing) tracer_ = std::make_shared<Tracer>();
+  partition_compiler_ = std::make_unique<PartitionCompiler>(
+      options_.num_compile_threads, tracer_);
+  // VLOGF(1) << DUMP(options_);
+}
+
+OpenVINODelegate::~OpenVINODelegate() {
+  // Background compilations may still add events until the pool is gone.
+  partition_compiler_.reset();
+  if (tracer_ != nullptr && !options_.trace_file.empty() &&
+      tracer_->WriteChromeTrace(options_.trace_file) != kTfLiteOk)
+    TFLITE_LOG(ERROR) << "Could not write trace to " << options_.trace_file;
+}
+
 bool OpenVINODelegate::CheckInputType(TfLiteType tensor_type,
                                       TfLiteType expected_type) const {
   return expected_type == tensor_type;
@@ -71,6 +135,79 @@ bool OpenVINODelegate::CheckDims(
   return true;
 }
 
+bool OpenVINODelegate::CheckQuantization(const TfLiteOpaqueContext *context,
+                                         const TfLiteOpaqueNode *node) const {
+  const int *inputs;
+  int num_inputs;
+  const int *outputs;
+  int num_outputs;
+  if (TfLiteOpaqueNodeInputs(node, &inputs, &num_inputs) != kTfLiteOk ||
+      TfLiteOpaqueNodeOutputs(node, &outputs, &num_outputs) != kTfLiteOk)
+    return false;
+
+  std::vector<int> tensors(inputs, inputs + num_inputs);
+  tensors.insert(tensors.end(), outputs, outputs + num_outputs);
+  for (int tensor_id : tensors) {
+    if (tensor_id == kTfLiteOptionalTensor) continue;
+    const TfLiteOpaqueTensor *opaque_tensor =
+        TfLiteOpaqueContextGetOpaqueTensor(context, tensor_id);
+    TfLiteType type = TfLiteOpaqueTensorType(opaque_tensor);
+    if (type != kTfLiteInt8 && type != kTfLiteUInt8 && type != kTfLiteInt4)
+      continue;
+
+    // Integer tensors are only meaningful to OpenVINO with their affine
+    // quantization parameters, per tensor or per channel.
+    const TfLiteQuantization quantization =
+        TfLiteOpaqueTensorGetQuantization(opaque_tensor);
+    if (quantization.type != kTfLiteAffineQuantization ||
+        quantization.params == nullptr)
+      return false;
+    const auto *affine_quantization =
+        reinterpret_cast<const TfLiteAffineQuantization *>(quantization.params);
+    if (affine_quantization->scale == nullptr ||
+        affine_quantization->scale->size == 0)
+      return false;
+    const int num_channels = affine_quantization->scale->size;
+    if (affine_quantization->zero_point != nullptr &&
+        affine_quantization->zero_point->size != num_channels)
+      return false;
+    if (num_channels > 1) {
+      const int axis = affine_quantization->quantized_dimension;
+      if (axis < 0 || axis >= TfLiteOpaqueTensorNumDims(opaque_tensor) ||
+          TfLiteOpaqueTensorDim(opaque_tensor, axis) != num_channels)
+        return false;
+    }
+  }
+  return true;
+}
+
+bool OpenVINODelegate::CheckConsumersSupported(
+    const TfLiteOpaqueContext *context, int tensor_id) const {
+  // The opaque API only hands out nodes through a non-const context.
+  auto *mutable_context = const_cast<TfLiteOpaqueContext *>(context);
+  TfLiteIntArray *execution_plan;
+  if (TfLiteOpaqueContextGetExecutionPlan(mutable_context, &execution_plan) !=
+      kTfLiteOk)
+    return false;
+  for (int i = 0; i < execution_plan->size; i++) {
+    TfLiteOpaqueNode *node;
+    TfLiteRegistrationExternal *registration;
+    if (TfLiteOpaqueContextGetNodeAndRegistration(
+            mutable_context, execution_plan->data[i], &node, &registration) !=
+        kTfLiteOk)
+      return false;
+    const int *inputs;
+    int num_inputs;
+    if (TfLiteOpaqueNodeInputs(node, &inputs, &num_inputs) != kTfLiteOk)
+      return false;
+    if (std::find(inputs, inputs + num_inputs, tensor_id) ==
+        inputs + num_inputs)
+      continue;
+    if (!CheckNodeSupportByOpenVINO(registration, node, context)) return false;
+  }
+  return true;
+}
+
 bool OpenVINODelegate::CheckNodeSupportByOpenVINO(
     const TfLiteRegistrationExternal *registration,
     const TfLiteOpaqueNode *node, const TfLiteOpaqueContext *context) const {
@@ -80,8 +217,11 @@ bool OpenVINODelegate::CheckNodeSupportByOpenVINO(
     return false;
   switch (TfLiteRegistrationExternalGetBuiltInCode(registration)) {
     case kTfLiteBuiltinAdd: {
-      return CheckDataTypeSupported(context, node,
-                                    {{kTfLiteFloat32}, {kTfLiteFloat32}}) &&
+      return CheckDataTypeSupported(
+                 context, node,
+                 {{kTfLiteFloat32, kTfLiteInt8, kTfLiteUInt8},
+                  {kTfLiteFloat32, kTfLiteInt8, kTfLiteUInt8}}) &&
+             CheckQuantization(context, node) &&
              CheckDims(context, node, {{1, 2, 3, 4}, {1, 2, 3, 4}});
     }
     case kTfLiteBuiltinAveragePool2d: {
@@ -89,6 +229,13 @@ bool OpenVINODelegate::CheckNodeSupportByOpenVINO(
              CheckDims(context, node, {{4}});
     }
     case kTfLiteBuiltinConv2d: {
+      // Full-integer: int8 activations and per-channel int8 filters with an
+      // int32 bias, lowered by the frontend to FakeQuantize.
+      if (num_inputs == 3 &&
+          CheckDataTypeSupported(
+              context, node, {{kTfLiteInt8}, {kTfLiteInt8}, {kTfLiteInt32}}))
+        return CheckQuantization(context, node) &&
+               CheckDims(context, node, {{4}, {4}, {1}});
       if (num_inputs == 2) {
         return CheckDataTypeSupported(context, node,
                                       {{kTfLiteFloat32}, {kTfLiteFloat32}}) &&
@@ -110,6 +257,11 @@ bool OpenVINODelegate::CheckNodeSupportByOpenVINO(
                                     {{kTfLiteFloat32}, {kTfLiteFloat32}});
     }
     case kTfLiteBuiltinDepthwiseConv2d: {
+      if (num_inputs == 3 &&
+          CheckDataTypeSupported(
+              context, node, {{kTfLiteInt8}, {kTfLiteInt8}, {kTfLiteInt32}}))
+        return CheckQuantization(context, node) &&
+               CheckDims(context, node, {{4}, {4}, {1}});
       if (num_inputs == 2) {
         return CheckDataTypeSupported(context, node,
                                       {{kTfLiteFloat32}, {kTfLiteFloat32}}) &&
@@ -124,7 +276,47 @@ bool OpenVINODelegate::CheckNodeSupportByOpenVINO(
       }
     }
     case kTfLiteBuiltinDequantize: {
-      return CheckDataTypeSupported(context, node, {{kTfLiteFloat16}});
+      // int4 only comes as weight-only compressed constants.
+      if (num_inputs < 1) return false;
+      const TfLiteOpaqueTensor *input =
+          TfLiteOpaqueContextGetOpaqueTensor(context, inputs[0]);
+      if (TfLiteOpaqueTensorType(input) == kTfLiteInt4 &&
+          TfLiteOpaqueTensorGetAllocationType(input) != kTfLiteMmapRo)
+        return false;
+      return CheckDataTypeSupported(
+                 context, node,
+                 {{kTfLiteFloat16, kTfLiteInt8, kTfLiteUInt8, kTfLiteInt4}}) &&
+             CheckQuantization(context, node);
+    }
+    case kTfLiteBuiltinDensify: {
+#ifdef OPENVINO_DELEGATE_STABLE_ABI
+      // The sparsity parameters are only reachable through TfLiteTensor,
+      // whose layout is not part of the stable delegate ABI.
+      return false;
+#else
+      // Only sparse constants, which are densified once at conversion. The
+      // dense tensor only exists inside the OpenVINO model, so a consumer left
+      // to TfLite would have nothing to read.
+      const int *outputs;
+      int num_outputs;
+      if (num_inputs != 1 ||
+          TfLiteOpaqueNodeOutputs(node, &outputs, &num_outputs) != kTfLiteOk ||
+          num_outputs != 1 || !CheckConsumersSupported(context, outputs[0]))
+        return false;
+      const TfLiteOpaqueTensor *input =
+          TfLiteOpaqueContextGetOpaqueTensor(context, inputs[0]);
+      if (TfLiteOpaqueTensorGetAllocationType(input) != kTfLiteMmapRo ||
+          reinterpret_cast<const TfLiteTensor *>(input)->sparsity == nullptr)
+        return false;
+      return CheckDataTypeSupported(
+          context, node, {{kTfLiteFloat32, kTfLiteFloat16, kTfLiteInt8}});
+#endif
+    }
+    case kTfLiteBuiltinQuantize: {
+      return CheckDataTypeSupported(
+                 context, node,
+                 {{kTfLiteFloat32, kTfLiteInt8, kTfLiteUInt8}}) &&
+             CheckQuantization(context, node);
     }
     case kTfLiteBuiltinResizeBilinear: {
       return CheckDataTypeSupported(context, node,
@@ -137,7 +329,10 @@ bool OpenVINODelegate::CheckNodeSupportByOpenVINO(
       return CheckDataTypeSupported(context, node, {{kTfLiteFloat32}});
     }
     case kTfLiteBuiltinLogistic: {
-      return CheckDataTypeSupported(context, node, {{kTfLiteFloat32}});
+      return CheckDataTypeSupported(
+                 context, node,
+                 {{kTfLiteFloat32, kTfLiteInt8, kTfLiteUInt8}}) &&
+             CheckQuantization(context, node);
     }
     case kTfLiteBuiltinHardSwish: {
       return CheckDataTypeSupported(context, node, {{kTfLiteFloat32}});
@@ -160,8 +355,11 @@ bool OpenVINODelegate::CheckNodeSupportByOpenVINO(
       return CheckDataTypeSupported(context, node, {{kTfLiteFloat32}});
     }
     case kTfLiteBuiltinReshape: {
-      return CheckDataTypeSupported(context, node,
-                                    {{kTfLiteFloat32}, {kTfLiteInt32}}) &&
+      return CheckDataTypeSupported(
+                 context, node,
+                 {{kTfLiteFloat32, kTfLiteInt8, kTfLiteUInt8},
+                  {kTfLiteInt32}}) &&
+             CheckQuantization(context, node) &&
              CheckDims(context, node, {{1, 2, 3, 4}, {1}});
     }
     case kTfLiteBuiltinMaxPool2d: {
@@ -206,10 +404,125 @@ bool OpenVINODelegate::IsNodeSupportedByDelegate(
     const TfLiteOpaqueNode *node, TfLiteOpaqueContext *context) const {
   if (registration == nullptr || node == nullptr || context == nullptr)
     return false;
+  if (split_densify_nodes_.count(node) != 0) return false;
   return CheckNodeSupportByOpenVINO(registration, node, context);
 }
 
 TfLiteStatus OpenVINODelegate::Initialize(TfLiteOpaqueContext *context) {
+  ScopedTrace trace(tracer_.get(), "Initialize", kTraceStartup);
+  const auto start = std::chrono::steady_clock::now();
+  next_partition_index_ = 0;
+  split_densify_nodes_.clear();
+  {
+    std::lock_guard<std::mutex> lock(metrics_mutex_);
+    init_ms_ = -1;
+    partition_metrics_.clear();
+  }
+
+  TfLiteIntArray *execution_plan;
+  TfLiteStatus status =
+      TfLiteOpaqueContextGetExecutionPlan(context, &execution_plan);
+  if (status != kTfLiteOk) return status;
+
+  std::vector<int> supported_nodes;
+  for (int i = 0; i < execution_plan->size; i++) {
+    const int node_id = execution_plan->data[i];
+    TfLiteOpaqueNode *node;
+    TfLiteRegistrationExternal *registration;
+    if (TfLiteOpaqueContextGetNodeAndRegistration(context, node_id, &node,
+                                                  &registration) != kTfLiteOk)
+      continue;
+    if (IsNodeSupportedByDelegate(registration, node, context))
+      supported_nodes.push_back(node_id);
+  }
+  status = DropSplitDensifyNodes(context, &supported_nodes);
+  if (status != kTfLiteOk) return status;
+
+  // Convert every partition up front and compile them in the background.
+  // Should this fail, each kernel falls back to compiling its partition in
+  // Init.
+  partition_compiler_->CompilePartitions(context, supported_nodes, options_);
+
+  std::lock_guard<std::mutex> lock(metrics_mutex_);
+  init_ms_ = std::chrono::duration<double, std::milli>(
+                 std::chrono::steady_clock::now() - start)
+                 .count();
+  return kTfLiteOk;
+}
+
+TfLiteStatus OpenVINODelegate::DropSplitDensifyNodes(
+    TfLiteOpaqueContext *context, std::vector<int> *supported_nodes) {
+  // Dropping a DENSIFY can change how the remaining nodes are split, so
+  // check again until none is left apart from its consumers.
+  bool dropped = true;
+  while (dropped && !supported_nodes->empty()) {
+    dropped = false;
+    TfLiteIntArray *nodes = TfLiteIntArrayCreate(supported_nodes->size());
+    std::copy(supported_nodes->begin(), supported_nodes->end(), nodes->data);
+    TfLiteOpaqueDelegateParams *partition_params_array = nullptr;
+    int num_partitions = 0;
+    TfLiteStatus status = TfLiteOpaqueContextPreviewDelegatePartitioning(
+        context, nodes, &partition_params_array, &num_partitions);
+    TfLiteIntArrayFree(nodes);
+    if (status != kTfLiteOk) return status;
+    std::unordered_map<int, int> partition_of_node;
+    for (int p = 0; p < num_partitions; p++) {
+      const TfLiteIntArray *partition_nodes =
+          partition_params_array[p].nodes_to_replace;
+      for (int i = 0; i < partition_nodes->size; i++)
+        partition_of_node[partition_nodes->data[i]] = p;
+    }
+
+    // DENSIFY node of each dense tensor.
+    std::unordered_map<int, int> densify_of_tensor;
+    for (int node_id : *supported_nodes) {
+      TfLiteOpaqueNode *node;
+      TfLiteRegistrationExternal *registration;
+      const int *outputs;
+      int num_outputs;
+      if (TfLiteOpaqueContextGetNodeAndRegistration(context, node_id, &node,
+                                                    &registration) !=
+              kTfLiteOk ||
+          TfLiteRegistrationExternalGetBuiltInCode(registration) !=
+              kTfLiteBuiltinDensify ||
+          TfLiteOpaqueNodeOutputs(node, &outputs, &num_outputs) != kTfLiteOk)
+        continue;
+      for (int o = 0; o < num_outputs; o++)
+        densify_of_tensor[outputs[o]] = node_id;
+    }
+    if (densify_of_tensor.empty()) return kTfLiteOk;
+
+    std::unordered_set<int> split;
+    for (int node_id : *supported_nodes) {
+      TfLiteOpaqueNode *node;
+      TfLiteRegistrationExternal *registration;
+      const int *inputs;
+      int num_inputs;
+      if (TfLiteOpaqueContextGetNodeAndRegistration(context, node_id, &node,
+                                                    &registration) !=
+              kTfLiteOk ||
+          TfLiteOpaqueNodeInputs(node, &inputs, &num_inputs) != kTfLiteOk)
+        continue;
+      for (int i = 0; i < num_inputs; i++) {
+        auto densify = densify_of_tensor.find(inputs[i]);
+        if (densify != densify_of_tensor.end() &&
+            partition_of_node[densify->second] != partition_of_node[node_id])
+          split.insert(densify->second);
+      }
+    }
+    for (int node_id : split) {
+      TfLiteOpaqueNode *node;
+      TfLiteRegistrationExternal *registration;
+      if (TfLiteOpaqueContextGetNodeAndRegistration(context, node_id, &node,
+                                                    &registration) == kTfLiteOk)
+        split_densify_nodes_.insert(node);
+    }
+    auto end = std::remove_if(
+        supported_nodes->begin(), supported_nodes->end(),
+        [&split](int node_id) { return split.count(node_id) != 0; });
+    dropped = end != supported_nodes->end();
+    supported_nodes->erase(end, supported_nodes->end());
+  }
   return kTfLiteOk;
 }
 
@@ -219,9 +532,79 @@ const char *OpenVINODelegate::Name() const {
 
 std::unique_ptr<tflite::SimpleOpaqueDelegateKernelInterface>
 OpenVINODelegate::CreateDelegateKernelInterface() {
+  auto metrics = std::make_shared<PartitionMetrics>(next_partition_index_);
+  {
+    std::lock_guard<std::mutex> lock(metrics_mutex_);
+    partition_metrics_.push_back(metrics);
+  }
   return std::unique_ptr<tflite::openvinodelegate::OpenVINODelegateKernel>(
-      new tflite::openvinodelegate::OpenVINODelegateKernel(options_));
+      new tflite::openvinodelegate::OpenVINODelegateKernel(
+          options_, next_partition_index_++, partition_compiler_.get(),
+          std::move(metrics), tracer_));
+}
+
+TfLiteStatus OpenVINODelegate::GetMetrics(
+    TfLiteOpenVINODelegateMetrics *metrics) const {
+  if (metrics == nullptr) return kTfLiteError;
+  std::memset(metrics, 0, sizeof(*metrics));
+  std::lock_guard<std::mutex> lock(metrics_mutex_);
+  metrics->init_ms = init_ms_;
+  metrics->peak_rss_bytes = ReadProcessMemory().peak_rss_bytes;
+  metrics->num_partitions = partition_metrics_.size();
+  for (const auto &partition_metrics : partition_metrics_) {
+    const TfLiteOpenVINOPartitionMetrics partition =
+        partition_metrics->Snapshot();
+    if (partition.cache_hit == 1) metrics->cache_hits++;
+    if (partition.cache_hit == 0) metrics->cache_misses++;
+    metrics->evals += partition.evals + partition.fallback_evals;
+    metrics->bytes_copied +=
+        partition.input_bytes_copied + partition.output_bytes_copied;
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus OpenVINODelegate::GetPartitionMetrics(
+    int partition_index, TfLiteOpenVINOPartitionMetrics *metrics) const {
+  if (metrics == nullptr) return kTfLiteError;
+  std::lock_guard<std::mutex> lock(metrics_mutex_);
+  if (partition_index < 0 ||
+      static_cast<size_t>(partition_index) >= partition_metrics_.size())
+    return kTfLiteError;
+  *metrics = partition_metrics_[partition_index]->Snapshot();
+  return kTfLiteOk;
 }
 
 }  // namespace openvinodelegate
 }  // namespace tflite
+
+namespace {
+
+// The interface behind |delegate| if it is an OpenVINODelegate. Compares the
+// name rather than using dynamic_cast so the delegate builds without RTTI.
+tflite::openvinodelegate::OpenVINODelegate *GetOpenVINODelegate(
+    TfLiteOpaqueDelegate *delegate) {
+  if (delegate == nullptr) return nullptr;
+  auto *interface = static_cast<tflite::SimpleOpaqueDelegateInterface *>(
+      TfLiteOpaqueDelegateGetData(delegate));
+  if (interface == nullptr ||
+      std::strcmp(interface->Name(), "OpenVINO SimpleOpaqueDelegate") != 0)
+    return nullptr;
+  return static_cast<tflite::openvinodelegate::OpenVINODelegate *>(interface);
+}
+
+}  // namespace
+
+TfLiteStatus TfLiteOpenVINODelegateGetMetrics(
+    TfLiteOpaqueDelegate *delegate, TfLiteOpenVINODelegateMetrics *metrics) {
+  auto *openvino_delegate = GetOpenVINODelegate(delegate);
+  if (openvino_delegate == nullptr) return kTfLiteError;
+  return openvino_delegate->GetMetrics(metrics);
+}
+
+TfLiteStatus TfLiteOpenVINODelegateGetPartitionMetrics(
+    TfLiteOpaqueDelegate *delegate, int partition_index,
+    TfLiteOpenVINOPartitionMetrics *metrics) {
+  auto *openvino_delegate = GetOpenVINODelegate(delegate);
+  if (openvino_delegate == nullptr) return kTfLiteError;
+  return openvino_delegate->GetPartitionMetrics(partition_index, metrics);
+}
@@ -6,16 +6,29 @@
 #ifndef DELEGATE_INTEL_OPENVINO_OPENVINO_DELEGATE_H_
 #define DELEGATE_INTEL_OPENVINO_OPENVINO_DELEGATE_H_
 
+#include <cstddef>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
+#include "tensorflow/lite/delegates/intel_openvino/openvino_delegate_metrics.h"
 #include "tensorflow/lite/delegates/utils/simple_opaque_delegate.h"
 // #include "tensorflow/lite/delegates/intel_openvino/log.h"
 
 static const char kOpenVINOStableDelegateName[] = "intel_openvino_delegate";
 static const char kOpenVINOStableDelegateVersion[] = "1.0.0";
 
+// Fills |data| (|bytes| long) with calibration sample |sample_index| of the
+// TfLite tensor |tensor_index|. Returns false once the dataset is exhausted.
+// Partitions are converted on worker threads; an OpenVINODelegate never
+// calls its datasets concurrently, but delegates sharing a dataset do, so a
+// dataset shared between delegates must be thread-safe.
+using TfLiteOpenVINORepresentativeDataset = std::function<bool(
+    int sample_index, int tensor_index, void *data, size_t bytes)>;
+
 struct TfLiteOpenVINODelegateOptions {
   // Directory to store compilation cache.
   // TODO(b/344503269): Integrate this with OpenVINO.
@@ -24,6 +37,105 @@ struct TfLiteOpenVINODelegateOptions {
   // Unique token identifying the model that will run on this delegate instance.
   // TODO(b/344503269): Integrate this with OpenVINO.
   std::string model_token;
+
+  // plugins.xml used to register the OpenVINO device plugins. Ignored when
+  // the CPU plugin is linked statically.
+  std::string plugins_path = "/etc/openvino/plugins.xml";
+
+  // OpenVINO device the partitions are compiled for. Only the plugin of this
+  // device is loaded.
+  std::string device_type = "CPU";
+
+  // Number of worker threads compiling partitions in parallel after delegate
+  // initialization converted them. 0 uses the hardware concurrency.
+  int num_compile_threads = 0;
+
+  // Return from kernel Init without waiting for compile_model. Until the
+  // OpenVINO model of a partition is ready, its original TfLite kernels are
+  // run instead. Ignored in the stable delegate build, whose opaque ABI gives
+  // no access to the kernels.
+  bool async_compilation = false;
+
+  // Compile each partition first with settings that are cheap to compile,
+  // then recompile it with the full configuration in the background and swap
+  // the result in between two invokes.
+  bool tiered_compilation = false;
+
+  // Number of inferences run on synthetic inputs right after compilation, so
+  // that lazy allocations and primitive caches are set up before the first
+  // real invoke.
+  int warmup_iterations = 0;
+
+  // Post-training int8 calibration of float models. When set, every freshly
+  // converted partition is run in f32 over the dataset to collect activation
+  // ranges and is quantized with FakeQuantize before it is compiled and
+  // cached; later loads from cache_dir run int8 without recalibrating.
+  TfLiteOpenVINORepresentativeDataset representative_dataset;
+
+  // Upper bound on the samples drawn from |representative_dataset|.
+  int calibration_samples = 100;
+
+  // How partitions are converted to OpenVINO models: "frontend" goes through
+  // OpenVINO's TfLite frontend, "graph_builder" builds the model directly
+  // from the delegate's own converters, skipping the decoder and frontend.
+  // Partitions with an op the graph builder does not cover fall back to the
+  // frontend. Partitions with int8/int4 weight-only compressed constants are
+  // always tried on the graph builder first, as only it keeps them
+  // compressed.
+  std::string conversion_backend = "frontend";
+
+  // Inference precision the partitions are compiled with: "f32", "bf16" or
+  // "f16". Empty keeps the device default.
+  std::string inference_precision;
+
+  // Accuracy-aware mixed precision. When set together with a reduced
+  // |inference_precision|, every freshly converted partition is run over the
+  // dataset and its most sensitive layers are raised back to f32 until the
+  // outputs are within |max_precision_error| of f32. The resulting precision
+  // map is saved next to the partition's cache entry and applied whenever the
+  // entry is loaded.
+  TfLiteOpenVINORepresentativeDataset validation_dataset;
+
+  // Upper bound on the samples drawn from |validation_dataset|.
+  int validation_samples = 20;
+
+  // Largest absolute output error against f32 the tuned partition may have.
+  float max_precision_error = 1e-2f;
+
+  // Sweep performance mode, streams, threads and CPU pinning when a partition
+  // is compiled, timing real infer requests, and save the best settings as
+  // <entry>.tuned next to the partition's cache entry. Without it, a tuned
+  // file is loaded if it was tuned on a host with the same fingerprint.
+  bool tune_runtime_config = false;
+
+  // What the sweep optimizes: "latency" or "throughput".
+  std::string tuning_objective = "latency";
+
+  // Inferences timed per candidate of the sweep.
+  int tuning_iterations = 20;
+
+  // Compile with OpenVINO profiling and, after every Eval, report the time of
+  // each layer to the interpreter's profiler as an operator event of the
+  // TfLite node it was converted from. Slows inference down; for analysis
+  // only. The stable delegate cannot reach the interpreter's profiler and
+  // reports no events.
+  bool enable_profiling = false;
+
+  // Record the phases of startup (plugin load, conversion, cache import and
+  // export, compile_model, ...) and of every Eval (input copy, start, wait,
+  // output copy). Builds with --define=openvino_delegate_itt=true also emit
+  // them as ITT tasks for VTune.
+  bool enable_tracing = false;
+
+  // Chrome trace JSON the recorded phases are written to when the delegate
+  // is destroyed. Ignored unless |enable_tracing| is set.
+  std::string trace_file;
+
+  // Analyze every partition once it is compiled and write the report as
+  // <analysis_dir>/partition_<index>.json: TfLite ops, estimated FLOPs,
+  // bytes copied per Eval, Transpose and Convert operations added by
+  // conversion, and the layers of the compiled model.
+  std::string analysis_dir;
 };
 
 namespace tflite {
@@ -31,18 +143,14 @@ namespace openvinodelegate {
 
 // forward declaration
 class OpenVINODelegateTestPeer;
+class PartitionCompiler;
+class PartitionMetrics;
+class Tracer;
 
 class OpenVINODelegate : public SimpleOpaqueDelegateInterface {
  public:
-  explicit OpenVINODelegate(const TfLiteOpenVINODelegateOptions *options) {
-    if (options == nullptr) {
-      TfLiteOpenVINODelegateOptions default_opt;
-      options_ = default_opt;
-    } else {
-      options_ = *options;
-    }
-    // VLOGF(1) << DUMP(options_);
-  }
+  explicit OpenVINODelegate(const TfLiteOpenVINODelegateOptions *options);
+  ~OpenVINODelegate() override;
 
   bool IsNodeSupportedByDelegate(const TfLiteRegistrationExternal *registration,
                                  const TfLiteOpaqueNode *node,
@@ -55,8 +163,24 @@ class OpenVINODelegate : public SimpleOpaqueDelegateInterface {
   std::unique_ptr<SimpleOpaqueDelegateKernelInterface>
   CreateDelegateKernelInterface() override;
 
+  // Totals over the partitions of the last Initialize; safe to call while
+  // other threads invoke the interpreter.
+  TfLiteStatus GetMetrics(TfLiteOpenVINODelegateMetrics *metrics) const;
+  TfLiteStatus GetPartitionMetrics(
+      int partition_index, TfLiteOpenVINOPartitionMetrics *metrics) const;
+
  private:
   TfLiteOpenVINODelegateOptions options_;
+  std::unique_ptr<PartitionCompiler> partition_compiler_;
+  // Set when options_.enable_tracing is.
+  std::shared_ptr<Tracer> tracer_;
+  int next_partition_index_ = 0;
+  mutable std::mutex metrics_mutex_;
+  double init_ms_ = -1;
+  std::vector<std::shared_ptr<PartitionMetrics>> partition_metrics_;
+  // DENSIFY nodes Initialize left to TfLite because partitioning would have
+  // put them apart from their consumers.
+  std::unordered_set<const TfLiteOpaqueNode *> split_densify_nodes_;
   friend class OpenVINODelegateTestPeer;
   bool CheckInputType(TfLiteType tensor_type, TfLiteType expected_type) const;
   bool CheckDataTypeSupported(
@@ -65,9 +189,19 @@ class OpenVINODelegate : public SimpleOpaqueDelegateInterface {
   bool CheckDims(const TfLiteOpaqueContext *context,
                  const TfLiteOpaqueNode *node,
                  const std::vector<std::vector<int>> &dims_size) const;
+  bool CheckQuantization(const TfLiteOpaqueContext *context,
+                         const TfLiteOpaqueNode *node) const;
+  // True if every node that reads |tensor_id| is supported as well.
+  bool CheckConsumersSupported(const TfLiteOpaqueContext *context,
+                               int tensor_id) const;
   bool CheckNodeSupportByOpenVINO(
       const TfLiteRegistrationExternal *registration,
       const TfLiteOpaqueNode *node, const TfLiteOpaqueContext *context) const;
+  // Removes from |supported_nodes| every DENSIFY that would not share a
+  // partition with all of its consumers: its dense tensor only exists inside
+  // the OpenVINO model of that partition.
+  TfLiteStatus DropSplitDensifyNodes(TfLiteOpaqueContext *context,
+                                     std::vector<int> *supported_nodes);
 };
 
 }  // namespace openvinodelegate
@@ -0,0 +1,279 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// Benchmarks of the OpenVINO delegate's lifecycle and of its per-Eval
+// overhead on synthetic models built in-process, so numbers can be compared
+// across delegate and OpenVINO upgrades:
+//
+//   bazel run -c opt :openvino_delegate_benchmark -- \
+//     --benchmark_filter=EvalOverhead
+//
+// Init is timed end to end. Convert, Compile and CacheImport report the
+// delegate's own timing of that step as manual time; Convert and Compile
+// run once per conversion backend (graph_builder:0 is the TfLite frontend,
+// graph_builder:1 the direct graph builder). GraphBuild times conversion of
+// graphs of 10k and 50k tensors, where per-tensor bookkeeping shows.
+// EvalOverhead runs an identity-like ADD of zero, where copying and dispatch
+// dominate, once with the delegate and once on TfLite's kernels.
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "tensorflow/lite/delegates/intel_openvino/openvino_delegate.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_delegate_metrics.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_test_model_builder.h"
+#include "tensorflow/lite/delegates/utils/simple_opaque_delegate.h"
+#include "tensorflow/lite/interpreter.h"
+#include "tensorflow/lite/model_builder.h"
+
+namespace tflite {
+namespace openvinodelegate {
+namespace {
+
+constexpr char kCacheDir[] = "/tmp/openvino_delegate_benchmark_cache";
+
+// |num_layers| 3x3 convolutions with ReLU on a 56x56x64 feature map.
+std::vector<char> BuildConvChainModel(int num_layers) {
+  constexpr int kChannels = 64;
+  const std::vector<int32_t> shape = {1, 56, 56, kChannels};
+  std::vector<float> filter(kChannels * 3 * 3 * kChannels);
+  for (size_t i = 0; i < filter.size(); i++) filter[i] = (i % 5) * 1e-3f;
+  const auto *filter_bytes = reinterpret_cast<const uint8_t *>(filter.data());
+
+  TestModelBuilder builder;
+  const int input = builder.AddTensor(shape, TensorType_FLOAT32);
+  int previous = input;
+  for (int layer = 0; layer < num_layers; layer++) {
+    const int weights = builder.AddTensor(
+        {kChannels, 3, 3, kChannels}, TensorType_FLOAT32, {},
+        std::vector<uint8_t>(filter_bytes,
+                             filter_bytes + filter.size() * sizeof(float)));
+    const int output = builder.AddTensor(shape, TensorType_FLOAT32);
+    builder.AddOperator(
+        BuiltinOperator_CONV_2D, {previous, weights}, {output},
+        BuiltinOptions_Conv2DOptions,
+        CreateConv2DOptions(builder.builder(), Padding_SAME, 1, 1,
+                            ActivationFunctionType_RELU)
+            .Union());
+    previous = output;
+  }
+  return builder.Finish({input}, {previous});
+}
+
+// A chain of ADDs, each adding the input to the previous result, with
+// |num_tensors| tensors in total; small tensors keep the conversion itself
+// cheap.
+std::vector<char> BuildLargeGraphModel(int num_tensors) {
+  const std::vector<int32_t> shape = {1, 8};
+  TestModelBuilder builder;
+  const int input = builder.AddTensor(shape, TensorType_FLOAT32);
+  int previous = input;
+  for (int t = 1; t < num_tensors; t++) {
+    const int output = builder.AddTensor(shape, TensorType_FLOAT32);
+    builder.AddOperator(BuiltinOperator_ADD, {previous, input}, {output},
+                        BuiltinOptions_AddOptions,
+                        CreateAddOptions(builder.builder()).Union());
+    previous = output;
+  }
+  return builder.Finish({input}, {previous});
+}
+
+// |bytes| of float input plus a zero constant: what OpenVINO computes is
+// negligible next to copying the tensors in and out.
+std::vector<char> BuildIdentityModel(int64_t bytes) {
+  const std::vector<int32_t> shape = {
+      1, static_cast<int32_t>(bytes / sizeof(float))};
+  const float zero = 0.0f;
+  const auto *zero_bytes = reinterpret_cast<const uint8_t *>(&zero);
+  TestModelBuilder builder;
+  const int input = builder.AddTensor(shape, TensorType_FLOAT32);
+  const int constant = builder.AddTensor(
+      {1}, TensorType_FLOAT32, {},
+      std::vector<uint8_t>(zero_bytes, zero_bytes + sizeof(zero)));
+  const int output = builder.AddTensor(shape, TensorType_FLOAT32);
+  builder.AddOperator(BuiltinOperator_ADD, {input, constant}, {output},
+                      BuiltinOptions_AddOptions,
+                      CreateAddOptions(builder.builder()).Union());
+  return builder.Finish({input}, {output});
+}
+
+// The interpreter is declared last so it goes before its delegate.
+struct DelegatedInterpreter {
+  TfLiteOpaqueDelegateUniquePtr delegate = TfLiteOpaqueDelegateUniquePtr(
+      nullptr, TfLiteOpaqueDelegateFactory::DeleteSimpleDelegate);
+  std::unique_ptr<Interpreter> interpreter;
+};
+
+// Builds an interpreter for |model|, with the OpenVINO delegate unless
+// |options| is null, and allocates its tensors.
+bool CreateInterpreter(const FlatBufferModel &model,
+                       const TfLiteOpenVINODelegateOptions *options,
+                       DelegatedInterpreter *result) {
+  if (options != nullptr) result->delegate = CreateOpenVINODelegate(*options);
+  result->interpreter = BuildInterpreter(model, result->delegate.get());
+  return result->interpreter != nullptr;
+}
+
+std::unique_ptr<FlatBufferModel> LoadModel(const std::vector<char> &data) {
+  return FlatBufferModel::BuildFromBuffer(data.data(), data.size());
+}
+
+void BM_Init(benchmark::State &state) {
+  const std::vector<char> model_data = BuildConvChainModel(state.range(0));
+  std::unique_ptr<FlatBufferModel> model = LoadModel(model_data);
+  TfLiteOpenVINODelegateOptions options;
+  for (auto _ : state) {
+    DelegatedInterpreter delegated;
+    if (!CreateInterpreter(*model, &options, &delegated)) {
+      state.SkipWithError("Could not create the interpreter");
+      return;
+    }
+  }
+}
+BENCHMARK(BM_Init)->Arg(1)->Arg(8)->Arg(32)->Unit(benchmark::kMillisecond);
+
+// Runs Init and reports the step |field| of partition 0 timed, in ms.
+void RunTimedStep(benchmark::State &state, const FlatBufferModel &model,
+                  const TfLiteOpenVINODelegateOptions &options,
+                  double TfLiteOpenVINOPartitionMetrics::*field) {
+  for (auto _ : state) {
+    DelegatedInterpreter delegated;
+    TfLiteOpenVINOPartitionMetrics metrics;
+    if (!CreateInterpreter(model, &options, &delegated) ||
+        TfLiteOpenVINODelegateGetPartitionMetrics(delegated.delegate.get(), 0,
+                                                  &metrics) != kTfLiteOk ||
+        metrics.*field < 0) {
+      state.SkipWithError("Step did not run");
+      return;
+    }
+    state.SetIterationTime(metrics.*field / 1000);
+  }
+}
+
+// Options converting with the backend selected by the benchmark's second
+// argument.
+TfLiteOpenVINODelegateOptions ConversionOptions(
+    const benchmark::State &state) {
+  TfLiteOpenVINODelegateOptions options;
+  options.conversion_backend = state.range(1) ? "graph_builder" : "frontend";
+  return options;
+}
+
+void BM_Convert(benchmark::State &state) {
+  const std::vector<char> model_data = BuildConvChainModel(state.range(0));
+  std::unique_ptr<FlatBufferModel> model = LoadModel(model_data);
+  RunTimedStep(state, *model, ConversionOptions(state),
+               &TfLiteOpenVINOPartitionMetrics::convert_ms);
+}
+BENCHMARK(BM_Convert)
+    ->ArgsProduct({{1, 8, 32}, {0, 1}})
+    ->ArgNames({"layers", "graph_builder"})
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+
+// Compile time also reflects how much the plugin has to clean up after the
+// conversion.
+void BM_Compile(benchmark::State &state) {
+  const std::vector<char> model_data = BuildConvChainModel(state.range(0));
+  std::unique_ptr<FlatBufferModel> model = LoadModel(model_data);
+  RunTimedStep(state, *model, ConversionOptions(state),
+               &TfLiteOpenVINOPartitionMetrics::compile_ms);
+}
+BENCHMARK(BM_Compile)
+    ->ArgsProduct({{1, 8, 32}, {0, 1}})
+    ->ArgNames({"layers", "graph_builder"})
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+
+// Args: tensors, conversion backend.
+void BM_GraphBuild(benchmark::State &state) {
+  const std::vector<char> model_data = BuildLargeGraphModel(state.range(0));
+  std::unique_ptr<FlatBufferModel> model = LoadModel(model_data);
+  RunTimedStep(state, *model, ConversionOptions(state),
+               &TfLiteOpenVINOPartitionMetrics::convert_ms);
+  state.counters["tensors_per_s"] = benchmark::Counter(
+      state.range(0), benchmark::Counter::kIsIterationInvariantRate);
+}
+// Every iteration also compiles the whole graph.
+BENCHMARK(BM_GraphBuild)
+    ->ArgsProduct({{10000, 50000}, {0, 1}})
+    ->ArgNames({"tensors", "graph_builder"})
+    ->Iterations(3)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+
+void BM_CacheImport(benchmark::State &state) {
+  const std::vector<char> model_data = BuildConvChainModel(state.range(0));
+  std::unique_ptr<FlatBufferModel> model = LoadModel(model_data);
+  TfLiteOpenVINODelegateOptions options;
+  options.cache_dir = kCacheDir;
+  options.model_token = "conv_chain_" + std::to_string(state.range(0));
+  std::filesystem::remove_all(kCacheDir);
+  std::filesystem::create_directories(kCacheDir);
+  {
+    // Populates the cache entry.
+    DelegatedInterpreter delegated;
+    if (!CreateInterpreter(*model, &options, &delegated)) {
+      state.SkipWithError("Could not create the interpreter");
+      return;
+    }
+  }
+  RunTimedStep(state, *model, options,
+               &TfLiteOpenVINOPartitionMetrics::cache_import_ms);
+  std::filesystem::remove_all(kCacheDir);
+}
+BENCHMARK(BM_CacheImport)
+    ->Arg(1)
+    ->Arg(8)
+    ->Arg(32)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+
+// Args: tensor bytes, 1 to run on the delegate or 0 on TfLite's kernels.
+void BM_EvalOverhead(benchmark::State &state) {
+  const int64_t bytes = state.range(0);
+  const std::vector<char> model_data = BuildIdentityModel(bytes);
+  std::unique_ptr<FlatBufferModel> model = LoadModel(model_data);
+  TfLiteOpenVINODelegateOptions options;
+  DelegatedInterpreter delegated;
+  if (!CreateInterpreter(*model, state.range(1) ? &options : nullptr,
+                         &delegated)) {
+    state.SkipWithError("Could not create the interpreter");
+    return;
+  }
+  Interpreter *interpreter = delegated.interpreter.get();
+  // Otherwise both variants would time TfLite's ADD kernel.
+  if (state.range(1) && interpreter->execution_plan().size() != 1) {
+    state.SkipWithError("The model was not delegated");
+    return;
+  }
+  std::fill_n(interpreter->typed_input_tensor<float>(0),
+              bytes / sizeof(float), 1.0f);
+  for (auto _ : state) {
+    if (interpreter->Invoke() != kTfLiteOk) {
+      state.SkipWithError("Invoke failed");
+      return;
+    }
+  }
+  // The input is read and the output written once per Eval.
+  state.SetBytesProcessed(state.iterations() * 2 * bytes);
+}
+BENCHMARK(BM_EvalOverhead)
+    ->ArgNames({"bytes", "delegate"})
+    ->ArgsProduct({benchmark::CreateRange(1 << 10, 64 << 20, /*multi=*/4),
+                   {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace
+}  // namespace openvinodelegate
+}  // namespace tflite
+
+BENCHMARK_MAIN();
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "tensorflow/lite/delegates/intel_openvino/openvino_delegate.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_delegate_metrics.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_test_model_builder.h"
+#include "tensorflow/lite/delegates/utils/simple_opaque_delegate.h"
+#include "tensorflow/lite/interpreter.h"
+#include "tensorflow/lite/model_builder.h"
+
+/* Many interpreters with their own delegates sharing one model */
+
+namespace tflite {
+namespace openvinodelegate {
+namespace {
+
+constexpr int kNumThreads = 8;
+constexpr int kNumInvokes = 100;
+
+// RELU(input0 + input1) on a 1x16x16x8 tensor, as an ADD with a fused
+// activation so that both conversion backends decode it.
+std::vector<char> BuildAddReluModel() {
+  const std::vector<int32_t> shape = {1, 16, 16, 8};
+  TestModelBuilder builder;
+  const int input0 = builder.AddTensor(shape, TensorType_FLOAT32);
+  const int input1 = builder.AddTensor(shape, TensorType_FLOAT32);
+  const int output = builder.AddTensor(shape, TensorType_FLOAT32);
+  builder.AddOperator(
+      BuiltinOperator_ADD, {input0, input1}, {output},
+      BuiltinOptions_AddOptions,
+      CreateAddOptions(builder.builder(), ActivationFunctionType_RELU).Union());
+  return builder.Finish({input0, input1}, {output});
+}
+
+// Invoke |round| with inputs unique to |thread_index|. Returns 0 if the
+// result was right, 1 if it was wrong, or -1 if Invoke failed.
+int InvokeRound(Interpreter *interpreter, int thread_index, int round) {
+  const size_t size = 16 * 16 * 8;
+  float *input0 = interpreter->typed_input_tensor<float>(0);
+  float *input1 = interpreter->typed_input_tensor<float>(1);
+  for (size_t j = 0; j < size; j++) {
+    input0[j] = thread_index;
+    input1[j] = (j % 2 == 0 ? round : -round - thread_index - 1);
+  }
+  if (interpreter->Invoke() != kTfLiteOk) return -1;
+  const float *output = interpreter->typed_output_tensor<float>(0);
+  for (size_t j = 0; j < size; j++) {
+    const float expected = j % 2 == 0 ? thread_index + round : 0;
+    if (output[j] != expected) return 1;
+  }
+  return 0;
+}
+
+// Builds an interpreter with its own delegate on |model| and checks
+// |kNumInvokes| invokes with inputs unique to |thread_index|. Returns the
+// number of wrong results, or -1 if the interpreter could not be built.
+int RunInterpreter(const FlatBufferModel &model,
+                   const TfLiteOpenVINODelegateOptions &options,
+                   int thread_index) {
+  TfLiteOpaqueDelegateUniquePtr delegate = CreateOpenVINODelegate(options);
+  std::unique_ptr<Interpreter> interpreter =
+      BuildInterpreter(model, delegate.get());
+  if (interpreter == nullptr || interpreter->execution_plan().size() != 1)
+    return -1;
+
+  int errors = 0;
+  for (int i = 0; i < kNumInvokes; i++) {
+    const int result = InvokeRound(interpreter.get(), thread_index, i);
+    if (result < 0) return -1;
+    errors += result;
+  }
+  return errors;
+}
+
+void RunConcurrently(const TfLiteOpenVINODelegateOptions &options) {
+  const std::vector<char> model_data = BuildAddReluModel();
+  std::unique_ptr<FlatBufferModel> model =
+      FlatBufferModel::BuildFromBuffer(model_data.data(), model_data.size());
+  ASSERT_NE(model, nullptr);
+
+  std::vector<int> results(kNumThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kNumThreads; t++) {
+    threads.emplace_back([&, t] {
+      results[t] = RunInterpreter(*model, options, t);
+    });
+  }
+  for (std::thread &thread : threads) thread.join();
+  for (int t = 0; t < kNumThreads; t++)
+    EXPECT_EQ(0, results[t]) << "interpreter " << t;
+}
+
+TEST(OpenVINODelegateConcurrencyTest, InterpretersOnSeparateThreads) {
+  TfLiteOpenVINODelegateOptions options;
+  RunConcurrently(options);
+}
+
+TEST(OpenVINODelegateConcurrencyTest, GraphBuilderOnSeparateThreads) {
+  TfLiteOpenVINODelegateOptions options;
+  options.conversion_backend = "graph_builder";
+  RunConcurrently(options);
+}
+
+TEST(OpenVINODelegateConcurrencyTest, AsyncTieredCompilation) {
+  // Evals race the background compile and the swap of the optimized tier.
+  TfLiteOpenVINODelegateOptions options;
+  options.async_compilation = true;
+  options.tiered_compilation = true;
+  RunConcurrently(options);
+}
+
+TEST(OpenVINODelegateConcurrencyTest, TierSwapDuringInvoke) {
+  const std::vector<char> model_data = BuildAddReluModel();
+  std::unique_ptr<FlatBufferModel> model =
+      FlatBufferModel::BuildFromBuffer(model_data.data(), model_data.size());
+  ASSERT_NE(model, nullptr);
+  TfLiteOpenVINODelegateOptions options;
+  options.tiered_compilation = true;
+  TfLiteOpaqueDelegateUniquePtr delegate = CreateOpenVINODelegate(options);
+  std::unique_ptr<Interpreter> interpreter =
+      BuildInterpreter(*model, delegate.get());
+  ASSERT_NE(interpreter, nullptr);
+  ASSERT_EQ(1u, interpreter->execution_plan().size());
+
+  // The fast tier serves invokes until an Eval swaps in the optimized one;
+  // the results must not change across the swap.
+  TfLiteOpenVINOPartitionMetrics metrics;
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(60);
+  int round = 0;
+  do {
+    ASSERT_EQ(0, InvokeRound(interpreter.get(), 0, round)) << "round " << round;
+    round++;
+    ASSERT_EQ(kTfLiteOk, TfLiteOpenVINODelegateGetPartitionMetrics(
+                             delegate.get(), 0, &metrics));
+  } while (metrics.time_to_peak_throughput_ms < 0 &&
+           std::chrono::steady_clock::now() < deadline);
+  ASSERT_GE(metrics.time_to_peak_throughput_ms, 0)
+      << "optimized tier was not swapped in";
+  EXPECT_GE(metrics.time_to_first_inference_ms, 0);
+  EXPECT_LE(metrics.time_to_first_inference_ms,
+            metrics.time_to_peak_throughput_ms);
+  for (int i = 0; i < kNumInvokes; i++, round++)
+    EXPECT_EQ(0, InvokeRound(interpreter.get(), 0, round)) << "round " << round;
+}
+
+TEST(OpenVINODelegateConcurrencyTest, CreateAndDestroyRepeatedly) {
+  const std::vector<char> model_data = BuildAddReluModel();
+  std::unique_ptr<FlatBufferModel> model =
+      FlatBufferModel::BuildFromBuffer(model_data.data(), model_data.size());
+  ASSERT_NE(model, nullptr);
+  TfLiteOpenVINODelegateOptions options;
+  options.async_compilation = true;
+
+  // Interpreters are torn down while their partitions may still compile.
+  std::atomic<int> failures(0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kNumThreads; t++) {
+    threads.emplace_back([&] {
+      for (int round = 0; round < 5; round++) {
+        TfLiteOpaqueDelegateUniquePtr delegate =
+            CreateOpenVINODelegate(options);
+        if (BuildInterpreter(*model, delegate.get()) == nullptr) failures++;
+      }
+    });
+  }
+  for (std::thread &thread : threads) thread.join();
+  EXPECT_EQ(0, failures.load());
+}
+
+}  // namespace
+}  // namespace openvinodelegate
+}  // namespace tflite
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
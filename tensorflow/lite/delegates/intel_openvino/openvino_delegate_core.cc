@@ -5,8 +5,13 @@
 
 #include "tensorflow/lite/delegates/intel_openvino/openvino_delegate_core.h"
 
+#include <algorithm>
 #include <cstring>
+#include <exception>
 #include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
 #include <memory>
 #include <string>
 #include <unistd.h>
@@ -14,35 +19,179 @@
 
 #include "graph_iterator_delegate.h"
 #include "openvino/frontend/tensorflow_lite/frontend.hpp"
+#include "openvino/op/ops.hpp"
+#include "openvino/op/util/binary_elementwise_arithmetic.hpp"
+#include "openvino/runtime/intel_cpu/properties.hpp"
 #include "tensorflow/lite/c/c_api_opaque.h"
 #include "tensorflow/lite/delegates/intel_openvino/operations/openvino_node_manager.h"
+#include "tensorflow/lite/delegates/intel_openvino/operations/utility.h"
+#include "tensorflow/lite/tools/logging.h"
 
 namespace tflite {
 namespace openvinodelegate {
 
-TfLiteStatus OpenVINODelegateCore::Init() {
-  std::vector<std::string> ov_devices = ov_core_.get_available_devices();
-  if (std::find(ov_devices.begin(), ov_devices.end(), "CPU") ==
-      ov_devices.end()) {
-    // TFLITE_LOG(ERROR) << "Could not find plugin for CPU";
+namespace {
+
+// First tier of tiered compilation: a single stream and no snippets code
+// generation keep compile_model short at the cost of peak throughput.
+ov::AnyMap GetFastTierConfig() {
+  return {ov::hint::performance_mode(ov::hint::PerformanceMode::LATENCY),
+          ov::num_streams(1),
+          ov::intel_cpu::snippets_mode(ov::intel_cpu::SnippetsMode::DISABLE)};
+}
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+// True if |node| reads or writes integer tensors other than through a
+// DEQUANTIZE of a constant. The graph builder's converters compute in float,
+// so quantized activations are left to the frontend's FakeQuantize lowering.
+bool HasQuantizedTensors(TfLiteOpaqueContext *context,
+                         TfLiteRegistrationExternal *registration,
+                         const TfLiteOpaqueNode *node) {
+  if (TfLiteRegistrationExternalGetBuiltInCode(registration) ==
+      kTfLiteBuiltinDequantize)
+    return false;
+  const int *inputs;
+  int num_inputs;
+  const int *outputs;
+  int num_outputs;
+  if (TfLiteOpaqueNodeInputs(node, &inputs, &num_inputs) != kTfLiteOk ||
+      TfLiteOpaqueNodeOutputs(node, &outputs, &num_outputs) != kTfLiteOk)
+    return true;
+  std::vector<int> tensors(inputs, inputs + num_inputs);
+  tensors.insert(tensors.end(), outputs, outputs + num_outputs);
+  for (int t : tensors) {
+    if (t == kTfLiteOptionalTensor) continue;
+    const TfLiteType type =
+        TfLiteOpaqueTensorType(TfLiteOpaqueContextGetOpaqueTensor(context, t));
+    if (type == kTfLiteInt8 || type == kTfLiteUInt8 || type == kTfLiteInt4)
+      return true;
+  }
+  return false;
+}
+
+// True if the partition dequantizes integer weight-only compressed
+// constants. Only the graph builder emits the decompression subgraph that
+// keeps them compressed; the frontend would expand them to f32.
+bool HasCompressedWeights(TfLiteOpaqueContext *context,
+                          const TfLiteOpaqueDelegateParams *params) {
+  for (int i = 0; i < params->nodes_to_replace->size; i++) {
+    TfLiteOpaqueNode *node;
+    TfLiteRegistrationExternal *registration;
+    if (TfLiteOpaqueContextGetNodeAndRegistration(
+            context, params->nodes_to_replace->data[i], &node,
+            &registration) != kTfLiteOk ||
+        TfLiteRegistrationExternalGetBuiltInCode(registration) !=
+            kTfLiteBuiltinDequantize)
+      continue;
+    const int *inputs;
+    int num_inputs;
+    if (TfLiteOpaqueNodeInputs(node, &inputs, &num_inputs) != kTfLiteOk ||
+        num_inputs < 1)
+      continue;
+    const TfLiteOpaqueTensor *weights =
+        TfLiteOpaqueContextGetOpaqueTensor(context, inputs[0]);
+    const TfLiteType type = TfLiteOpaqueTensorType(weights);
+    if (TfLiteOpaqueTensorGetAllocationType(weights) == kTfLiteMmapRo &&
+        (type == kTfLiteInt8 || type == kTfLiteUInt8 || type == kTfLiteInt4))
+      return true;
+  }
+  return false;
+}
+
+// True for constants holding weights: floating point or low precision
+// integer data read as the data input of an op, or as an operand of a
+// convolution, MatMul or elementwise arithmetic. Shapes, axes and paddings
+// are left out.
+bool IsWeight(const std::shared_ptr<ov::op::v0::Constant> &constant) {
+  const ov::element::Type type = constant->get_element_type();
+  if (!type.is_real() && type != ov::element::i8 && type != ov::element::u8 &&
+      type != ov::element::i4 && type != ov::element::u4)
+    return false;
+  for (const ov::Input<ov::Node> &input :
+       constant->get_output_target_inputs(0)) {
+    const ov::Node *consumer = input.get_node();
+    if (input.get_index() == 0 ||
+        ov::is_type<ov::op::v1::Convolution>(consumer) ||
+        ov::is_type<ov::op::v1::GroupConvolution>(consumer) ||
+        ov::is_type<ov::op::v1::ConvolutionBackpropData>(consumer) ||
+        ov::is_type<ov::op::v0::MatMul>(consumer) ||
+        ov::is_type<ov::op::util::BinaryElementwiseArithmetic>(consumer))
+      return true;
+  }
+  return false;
+}
+
+WeightStats ComputeWeightStats(const std::shared_ptr<ov::Model> &model) {
+  WeightStats stats;
+  for (const auto &op : model->get_ordered_ops()) {
+    auto constant = ov::as_type_ptr<ov::op::v0::Constant>(op);
+    if (constant == nullptr || !IsWeight(constant)) continue;
+    stats.resident_weight_bytes += constant->get_byte_size();
+    stats.f32_weight_bytes +=
+        ov::shape_size(constant->get_shape()) * ov::element::f32.size();
+  }
+  return stats;
+}
+
+}  // namespace
+
+std::shared_ptr<ov::Core> CreateOVCore(const std::string &plugins_path) {
+#ifdef OPENVINO_DELEGATE_STATIC_CPU_PLUGIN
+  // Static OpenVINO builds register their plugins at link time.
+  return std::make_shared<ov::Core>();
+#else
+  return std::make_shared<ov::Core>(plugins_path);
+#endif
+}
+
+std::string GetCacheEntryPath(const TfLiteOpenVINODelegateOptions &options,
+                              int partition_index,
+                              const std::string &extension) {
+  // The first partition keeps the plain token so single-partition models map
+  // to <cache_dir>/<model_token>.xml.
+  std::string file_name = options.model_token;
+  if (partition_index > 0) file_name += "_" + std::to_string(partition_index);
+  return options.cache_dir + "/" + file_name + extension;
+}
+
+OpenVINODelegateCore::OpenVINODelegateCore(std::string plugins_path,
+                                           int partition_index)
+    : partition_index_(partition_index) {
+  auto start = std::chrono::steady_clock::now();
+  ov_core_ = CreateOVCore(plugins_path);
+  plugin_init_stats_.core_create_ms = MillisecondsSince(start);
+}
+
+TfLiteStatus OpenVINODelegateCore::Init(const std::string &device_type) {
+  // get_available_devices() would load and probe every registered plugin;
+  // querying the versions of one device loads only its plugin.
+  ScopedTrace trace(tracer_.get(), "LoadDevicePlugin", kTraceStartup,
+                    partition_index_);
+  auto start = std::chrono::steady_clock::now();
+  try {
+    if (ov_core_->get_versions(device_type).count(device_type) == 0) {
+      // TFLITE_LOG(ERROR) << "Could not find plugin for " << device_type;
+      return kTfLiteDelegateError;
+    }
+  } catch (const std::exception &e) {
+    // TFLITE_LOG(ERROR) << "Could not load plugin for " << device_type;
     return kTfLiteDelegateError;
-  } else {
-    return kTfLiteOk;
   }
+  plugin_init_stats_.device_init_ms = MillisecondsSince(start);
+  return kTfLiteOk;
 }
 
 TfLiteStatus OpenVINODelegateCore::InitializeBuilder(
     TfLiteOpaqueContext *context, const TfLiteOpaqueDelegateParams *params) {
   if (context == nullptr || params == nullptr)
     return kTfLiteError;
+  ScopedTrace trace(tracer_.get(), "Convert", kTraceStartup, partition_index_);
 
-  auto tflite_fe = std::make_shared<ov::frontend::tensorflow_lite::FrontEnd>();
-  std::shared_ptr<ov::frontend::tensorflow_lite::GraphIterator> graph_delegate =
-      std::make_shared<GraphIteratorDelegate>(context, params);
-  std::cout << "Num entries in graph_delegate " << graph_delegate->size();
-  auto input_model = tflite_fe->load(graph_delegate);
-  auto model = tflite_fe->convert(input_model);
-  
   const std::unordered_set<int> inputs(
       &params->input_tensors->data[0],
       &params->input_tensors->data[params->input_tensors->size]);
@@ -85,22 +234,108 @@ TfLiteStatus OpenVINODelegateCore::InitializeBuilder(
 
   }
 
+  if (delegate_options_.conversion_backend == "graph_builder" ||
+      HasCompressedWeights(context, params)) {
+    const TfLiteStatus status = BuildModel(context, params);
+    // model_ holds the nodes it needs.
+    openvino_graph_builder_.reset();
+    if (status == kTfLiteOk) {
+      build_stats_.conversion = BuildStats::Conversion::kGraphBuilder;
+      RecordPhaseMemory(&memory_stats_.convert,
+                        ComputeWeightStats(model_).resident_weight_bytes);
+      return kTfLiteOk;
+    }
+    TFLITE_LOG(INFO) << "Partition " << partition_index_
+                     << ": not covered by the graph builder, converting "
+                        "with the frontend";
+  }
+
+  auto tflite_fe = std::make_shared<ov::frontend::tensorflow_lite::FrontEnd>();
+  auto graph_iterator = std::make_shared<GraphIteratorDelegate>(context, params);
+  if (graph_iterator->get_status() != kTfLiteOk) {
+    TFLITE_LOG(ERROR) << "Partition " << partition_index_
+                      << ": could not densify its sparse weights";
+    return kTfLiteError;
+  }
+  std::shared_ptr<ov::frontend::tensorflow_lite::GraphIterator> graph_delegate =
+      graph_iterator;
+  std::cout << "Num entries in graph_delegate " << graph_delegate->size();
+  auto input_model = tflite_fe->load(graph_delegate);
+  RecordPhaseMemory(&memory_stats_.graph_iteration,
+                    graph_iterator->get_densified_bytes());
+  auto model = tflite_fe->convert(input_model);
+  RecordPhaseMemory(&memory_stats_.convert,
+                    graph_iterator->get_densified_bytes() +
+                        ComputeWeightStats(model).resident_weight_bytes);
+
+  build_stats_.conversion = BuildStats::Conversion::kFrontend;
   model_ = model;
   return kTfLiteOk;
 }
 
-TfLiteStatus OpenVINODelegateCore::BuildModel() {
-  if (!openvino_graph_builder_)
+TfLiteStatus OpenVINODelegateCore::BuildModel(
+    TfLiteOpaqueContext *context, const TfLiteOpaqueDelegateParams *params) {
+  openvino_graph_builder_ = std::make_unique<OpenVINOGraphBuilder>(
+      std::make_unique<NodeManager>(
+          TfLiteOpaqueContextGetNumTensors(context)));
+  try {
+    for (int t : compute_inputs_) {
+      if (openvino_graph_builder_->hasOutput(t)) continue;
+      if (openvino_graph_builder_->AddInputParams(
+              TfLiteOpaqueContextGetOpaqueTensor(context, t), t) != kTfLiteOk)
+        return kTfLiteError;
+    }
+
+    for (int i = 0; i < params->nodes_to_replace->size; i++) {
+      TfLiteOpaqueNode *node;
+      TfLiteRegistrationExternal *registration;
+      if (TfLiteOpaqueContextGetNodeAndRegistration(
+              context, params->nodes_to_replace->data[i], &node,
+              &registration) != kTfLiteOk ||
+          HasQuantizedTensors(context, registration, node))
+        return kTfLiteError;
+
+      const int *inputs_data = nullptr;
+      int num_inputs = 0;
+      if (TfLiteOpaqueNodeInputs(node, &inputs_data, &num_inputs) != kTfLiteOk)
+        return kTfLiteError;
+      for (int k = 0; k < num_inputs; k++) {
+        const int t = inputs_data[k];
+        if (t == kTfLiteOptionalTensor || openvino_graph_builder_->hasOutput(t))
+          continue;
+        if (TfLiteOpaqueTensorGetAllocationType(
+                TfLiteOpaqueContextGetOpaqueTensor(context, t)) !=
+            kTfLiteMmapRo)
+          continue;
+        if (openvino_graph_builder_->CreateConstNode(context, t) != kTfLiteOk)
+          return kTfLiteError;
+      }
+      if (openvino_graph_builder_->CreateNodeFromTfLiteOp(registration, node,
+                                                          context) != kTfLiteOk)
+        return kTfLiteError;
+    }
+
+    if (openvino_graph_builder_->UpdateResultNodes(context, outputs_) !=
+        kTfLiteOk)
+      return kTfLiteError;
+    model_ =
+        std::make_shared<ov::Model>(openvino_graph_builder_->getResultNodes(),
+                                    openvino_graph_builder_->getInputParams());
+  } catch (const std::exception &e) {
+    // Shape or type inference rejected a converted op.
+    TFLITE_LOG(ERROR) << "Partition " << partition_index_
+                      << ": graph builder failed: " << e.what();
+    model_ = nullptr;
     return kTfLiteError;
-  model_ =
-      std::make_shared<ov::Model>(openvino_graph_builder_->getResultNodes(),
-                                  openvino_graph_builder_->getInputParams());
+  }
   return kTfLiteOk;
 }
 
 TfLiteStatus OpenVINODelegateCore::BuildModelFromCache(
     TfLiteOpaqueContext *context, const TfLiteOpaqueDelegateParams *params,
     std::string cached_openvino_ir) {
+  ScopedTrace trace(tracer_.get(), "ImportCache", kTraceStartup,
+                    partition_index_);
 
   const std::unordered_set<int> inputs(
       &params->input_tensors->data[0],
@@ -137,44 +372,385 @@ TfLiteStatus OpenVINODelegateCore::BuildModelFromCache(
     const int output_tensor_idx = params->output_tensors->data[o];
     outputs_.push_back(output_tensor_idx);
   }
-  model_ = ov_core_.read_model(cached_openvino_ir);
+  model_ = ov_core_->read_model(cached_openvino_ir);
   if (!model_)
     return kTfLiteError;
+  FinalizeModel();
   return kTfLiteOk;
 }
 
-TfLiteStatus OpenVINODelegateCore::CompileAndInfer() {
-  // TODO: get device string from flags
-  std::string deviceStr = "CPU";
+void OpenVINODelegateCore::FinalizeModel() {
+  KeepCompressedWeights(model_);
+  weight_stats_ = ComputeWeightStats(model_);
+  TFLITE_LOG(INFO) << "Partition " << partition_index_ << ": "
+                   << weight_stats_.resident_weight_bytes
+                   << " bytes of resident weights ("
+                   << weight_stats_.f32_weight_bytes << " bytes as f32)";
+}
+
+void OpenVINODelegateCore::AnalyzePartition(
+    TfLiteOpaqueContext *context, const TfLiteOpaqueDelegateParams *params) {
+  if (delegate_options_.analysis_dir.empty()) return;
+  partition_report_.partition_index = partition_index_;
+  if (AnalyzeTfLitePartition(context, params, compute_inputs_, outputs_,
+                             &partition_report_) != kTfLiteOk)
+    TFLITE_LOG(ERROR) << "Partition " << partition_index_
+                      << ": could not analyze the TfLite ops";
+  AnalyzeConvertedModel(model_, &partition_report_);
+}
+
+void OpenVINODelegateCore::RecordPhaseMemory(PhaseMemory *phase,
+                                             int64_t delegate_bytes) {
+  const ProcessMemory memory = ReadProcessMemory();
+  phase->rss_bytes = memory.rss_bytes;
+  phase->delegate_bytes = delegate_bytes;
+  memory_stats_.peak_rss_bytes = memory.peak_rss_bytes;
+}
+
+int64_t OpenVINODelegateCore::ComputeDuplicatedConstantBytes(
+    TfLiteOpaqueContext *context, const TfLiteOpaqueDelegateParams *params) {
+  // Read-only TfLite tensors of the partition by start address.
+  std::map<const uint8_t *, size_t> tflite_buffers;
+  for (int i = 0; i < params->nodes_to_replace->size; i++) {
+    TfLiteOpaqueNode *node;
+    TfLiteRegistrationExternal *registration;
+    const int *inputs = nullptr;
+    int num_inputs = 0;
+    if (TfLiteOpaqueContextGetNodeAndRegistration(
+            context, params->nodes_to_replace->data[i], &node,
+            &registration) != kTfLiteOk ||
+        TfLiteOpaqueNodeInputs(node, &inputs, &num_inputs) != kTfLiteOk)
+      continue;
+    for (int k = 0; k < num_inputs; k++) {
+      if (inputs[k] == kTfLiteOptionalTensor) continue;
+      const TfLiteOpaqueTensor *tensor =
+          TfLiteOpaqueContextGetOpaqueTensor(context, inputs[k]);
+      if (TfLiteOpaqueTensorGetAllocationType(tensor) != kTfLiteMmapRo ||
+          TfLiteOpaqueTensorData(tensor) == nullptr)
+        continue;
+      tflite_buffers[static_cast<const uint8_t *>(
+          TfLiteOpaqueTensorData(tensor))] = TfLiteOpaqueTensorByteSize(tensor);
+    }
+  }
+
+  int64_t duplicated_bytes = 0;
+  for (const auto &op : model_->get_ordered_ops()) {
+    auto constant = ov::as_type_ptr<ov::op::v0::Constant>(op);
+    if (constant == nullptr) continue;
+    const auto *data = static_cast<const uint8_t *>(constant->get_data_ptr());
+    // The buffer starting at or before |data|, if it covers |data|.
+    auto buffer = tflite_buffers.upper_bound(data);
+    const bool shared = buffer != tflite_buffers.begin() &&
+                        data < std::prev(buffer)->first +
+                                   std::prev(buffer)->second;
+    if (!shared) duplicated_bytes += constant->get_byte_size();
+  }
+  return duplicated_bytes;
+}
+
+void OpenVINODelegateCore::RecordCompileMemory(int64_t rss_before_compile) {
+  const ProcessMemory memory = ReadProcessMemory();
+  if (memory.rss_bytes < 0 || rss_before_compile < 0) return;
+  memory_stats_.compiled_model_bytes =
+      std::max<int64_t>(0, memory.rss_bytes - rss_before_compile);
+  memory_stats_.compile.rss_bytes = memory.rss_bytes;
+  memory_stats_.compile.delegate_bytes =
+      weight_stats_.resident_weight_bytes + memory_stats_.compiled_model_bytes;
+  memory_stats_.peak_rss_bytes = memory.peak_rss_bytes;
+}
+
+bool OpenVINODelegateCore::RecordFirstInferMemory() {
+  if (memory_stats_.first_infer.rss_bytes >= 0 ||
+      memory_stats_.compile.rss_bytes < 0)
+    return false;
+  const ProcessMemory memory = ReadProcessMemory();
+  if (memory.rss_bytes < 0) return false;
+  // Growth over the first inference is taken as the request's lazily
+  // allocated buffers.
+  memory_stats_.first_infer.rss_bytes = memory.rss_bytes;
+  memory_stats_.first_infer.delegate_bytes =
+      memory_stats_.compile.delegate_bytes +
+      std::max<int64_t>(0, memory.rss_bytes - memory_stats_.compile.rss_bytes);
+  memory_stats_.peak_rss_bytes = memory.peak_rss_bytes;
+  return true;
+}
+
+void OpenVINODelegateCore::AnalyzeCompiledPartition() {
+  if (delegate_options_.analysis_dir.empty()) return;
+  AnalyzeCompiledModel(compiled_model_, &partition_report_);
+  const std::string report_path = delegate_options_.analysis_dir +
+                                  "/partition_" +
+                                  std::to_string(partition_index_) + ".json";
+  std::ofstream report_file(report_path);
+  report_file << partition_report_.ToJson() << "\n";
+  if (!report_file) {
+    TFLITE_LOG(ERROR) << "Partition " << partition_index_
+                      << ": could not write " << report_path;
+    return;
+  }
+  TFLITE_LOG(INFO) << "Partition " << partition_index_ << ": "
+                   << partition_report_.estimated_flops << " FLOPs, "
+                   << partition_report_.input_bytes_per_eval << " + "
+                   << partition_report_.output_bytes_per_eval
+                   << " bytes copied per Eval, "
+                   << partition_report_.inserted_transposes
+                   << " transposes and "
+                   << partition_report_.inserted_converts
+                   << " converts inserted, "
+                   << partition_report_.runtime_model_ops
+                   << " runtime layers";
+}
+
+void OpenVINODelegateCore::TunePrecision() {
+  const std::string &precision = delegate_options_.inference_precision;
+  if (!delegate_options_.validation_dataset || precision.empty() ||
+      precision == "f32")
+    return;
+  ScopedTrace trace(tracer_.get(), "TunePrecision", kTraceStartup,
+                    partition_index_);
+  PrecisionTuner tuner(ov_core_, delegate_options_.device_type);
+  if (tuner.Tune(model_, compute_inputs_,
+                 delegate_options_.validation_dataset,
+                 delegate_options_.validation_samples, precision,
+                 delegate_options_.max_precision_error, &precision_map_,
+                 &precision_tuning_report_) != kTfLiteOk) {
+    TFLITE_LOG(ERROR) << "Partition " << partition_index_
+                      << ": precision tuning failed, running in " << precision;
+    return;
+  }
+  TFLITE_LOG(INFO) << "Partition " << partition_index_ << ": "
+                   << precision_tuning_report_.f32_layers << " of "
+                   << precision_tuning_report_.candidate_layers
+                   << " layers kept in f32 after "
+                   << precision_tuning_report_.iterations
+                   << " rounds, max abs error vs f32 "
+                   << precision_tuning_report_.max_abs_error
+                   << (precision_tuning_report_.threshold_met
+                           ? ""
+                           : " (above max_precision_error)");
+}
+
+void OpenVINODelegateCore::TuneRuntimeConfig() {
+  ScopedTrace trace(tracer_.get(), "TuneRuntimeConfig", kTraceStartup,
+                    partition_index_);
+  RuntimeTuner tuner(ov_core_, delegate_options_.device_type);
+  if (tuner.Tune(model_, GetCompileConfig(),
+                 delegate_options_.tuning_objective == "throughput",
+                 delegate_options_.tuning_iterations, &runtime_config_,
+                 &runtime_tuning_report_) != kTfLiteOk) {
+    TFLITE_LOG(ERROR) << "Partition " << partition_index_
+                      << ": runtime tuning failed, using plugin defaults";
+    return;
+  }
+  has_runtime_config_ = true;
+  TFLITE_LOG(INFO) << "Partition " << partition_index_ << ": best of "
+                   << runtime_tuning_report_.candidates << " configs is "
+                   << runtime_config_.performance_mode << " with "
+                   << runtime_config_.num_streams << " streams, "
+                   << runtime_config_.inference_num_threads << " threads, "
+                   << "pinning " << runtime_config_.enable_cpu_pinning << ": "
+                   << runtime_tuning_report_.latency_ms << " ms, "
+                   << runtime_tuning_report_.throughput_fps << " fps";
+  if (delegate_options_.cache_dir.empty() ||
+      delegate_options_.model_token.empty())
+    return;
+  SaveRuntimeConfig(
+      runtime_config_,
+      GetHostFingerprint(*ov_core_, delegate_options_.device_type),
+      GetCacheFilePath(&delegate_options_, ".tuned"));
+}
+
+ov::AnyMap OpenVINODelegateCore::GetCompileConfig() const {
   ov::AnyMap config;
+  if (has_runtime_config_) config = runtime_config_.ToAnyMap();
+  // A tuned precision map takes precedence over the requested precision.
+  const std::string &precision = precision_map_.inference_precision.empty()
+                                     ? delegate_options_.inference_precision
+                                     : precision_map_.inference_precision;
+  if (!precision.empty())
+    config.insert(ov::hint::inference_precision(ov::element::Type(precision)));
+  if (delegate_options_.enable_profiling)
+    config.insert(ov::enable_profiling(true));
+  return config;
+}
+
+TfLiteStatus OpenVINODelegateCore::CompileAndInfer() {
+  if (optimize_converted_model_) {
+    OptimizeConvertedModel();
+    optimize_converted_model_ = false;
+  }
+  std::string deviceStr = delegate_options_.device_type;
+  ApplyPrecisionMap(model_, precision_map_);
+  if (delegate_options_.tune_runtime_config) TuneRuntimeConfig();
+  ov::AnyMap config = GetCompileConfig();
   // Below param helps accelerate inference on NPU device. It helps in HW
   // acceleration.
   // config["NPU_COMPILATION_MODE_PARAMS"] = "enable-se-ptrs-operations=true";
 
-  compiled_model_ = ov_core_.compile_model(model_, deviceStr);
-  //, config);
+  const int64_t rss_before_compile = ReadProcessMemory().rss_bytes;
+  compile_start_ = std::chrono::steady_clock::now();
+  if (delegate_options_.tiered_compilation) {
+    ov::AnyMap fast_tier_config = GetFastTierConfig();
+    fast_tier_config.insert(config.begin(), config.end());
+    {
+      ScopedTrace trace(tracer_.get(), "CompileModel", kTraceStartup,
+                        partition_index_);
+      compiled_model_ =
+          ov_core_->compile_model(model_, deviceStr, fast_tier_config);
+    }
+    build_stats_.compile_ms = MillisecondsSince(compile_start_);
+    AnalyzeCompiledPartition();
+    infer_request_ = compiled_model_.create_infer_request();
+    RecordCompileMemory(rss_before_compile);
+    warmup_stats_ = WarmUp(infer_request_, delegate_options_.warmup_iterations,
+                           tracer_.get(), partition_index_);
+    if (warmup_stats_.iterations > 0) RecordFirstInferMemory();
+    compile_tier_stats_.time_to_first_inference_ms =
+        MillisecondsSince(compile_start_);
+
+    // The task only holds copies: the core may be destroyed while it runs,
+    // with its destructor blocking on the task.
+    optimized_model_ = std::async(
+        std::launch::async,
+        [ov_core = ov_core_, model = model_, deviceStr, config,
+         tracer = tracer_, partition_index = partition_index_,
+         compile_start = compile_start_,
+         warmup_iterations = delegate_options_.warmup_iterations]() {
+          OptimizedTier tier;
+          {
+            ScopedTrace trace(tracer.get(), "CompileOptimizedTier",
+                              kTraceStartup, partition_index);
+            tier.compiled_model =
+                ov_core->compile_model(model, deviceStr, config);
+          }
+          tier.compiled_ms = MillisecondsSince(compile_start);
+          // Warm the optimized tier up before it replaces the fast one, so
+          // the swap does not bring back the first-invoke latency spike.
+          tier.infer_request = tier.compiled_model.create_infer_request();
+          tier.warmup_stats = WarmUp(tier.infer_request, warmup_iterations,
+                                     tracer.get(), partition_index);
+          return tier;
+        });
+    return kTfLiteOk;
+  }
+
+  {
+    ScopedTrace trace(tracer_.get(), "CompileModel", kTraceStartup,
+                      partition_index_);
+    compiled_model_ = ov_core_->compile_model(model_, deviceStr, config);
+  }
+  build_stats_.compile_ms = MillisecondsSince(compile_start_);
+  AnalyzeCompiledPartition();
   infer_request_ = compiled_model_.create_infer_request();
+  RecordCompileMemory(rss_before_compile);
+  warmup_stats_ = WarmUp(infer_request_, delegate_options_.warmup_iterations,
+                         tracer_.get(), partition_index_);
+  if (warmup_stats_.iterations > 0) RecordFirstInferMemory();
+  compile_tier_stats_.time_to_first_inference_ms =
+      MillisecondsSince(compile_start_);
+  compile_tier_stats_.time_to_peak_throughput_ms =
+      compile_tier_stats_.time_to_first_inference_ms;
   return kTfLiteOk;
 }
 
+WarmupStats OpenVINODelegateCore::WarmUp(ov::InferRequest &infer_request,
+                                         int iterations, Tracer *tracer,
+                                         int partition_index) {
+  WarmupStats stats;
+  if (iterations <= 0) return stats;
+  ScopedTrace trace(tracer, "WarmUp", kTraceStartup, partition_index);
+  // Zero-filled inputs are enough to trigger the lazy allocations; the
+  // results are overwritten by the first real invoke.
+  for (const auto &input : infer_request.get_compiled_model().inputs()) {
+    ov::Tensor tensor = infer_request.get_tensor(input);
+    std::memset(tensor.data(), 0, tensor.get_byte_size());
+  }
+  for (int i = 0; i < iterations; i++) {
+    auto start = std::chrono::steady_clock::now();
+    infer_request.infer();
+    double latency_ms = MillisecondsSince(start);
+    if (i == 0) stats.cold_latency_ms = latency_ms;
+    stats.warm_latency_ms = latency_ms;
+  }
+  stats.iterations = iterations;
+  return stats;
+}
+
+bool OpenVINODelegateCore::SwapInOptimizedModel() {
+  if (!optimized_model_.valid() ||
+      optimized_model_.wait_for(std::chrono::seconds(0)) !=
+          std::future_status::ready)
+    return false;
+  try {
+    OptimizedTier tier = optimized_model_.get();
+    compile_tier_stats_.optimized_tier_compiled_ms = tier.compiled_ms;
+    compiled_model_ = tier.compiled_model;
+    infer_request_ = tier.infer_request;
+    if (tier.warmup_stats.iterations > 0) warmup_stats_ = tier.warmup_stats;
+    AnalyzeCompiledPartition();
+  } catch (const std::exception &e) {
+    // Keep serving from the fast tier.
+    TFLITE_LOG(ERROR) << "Optimized tier compilation failed: " << e.what();
+    return false;
+  }
+  compile_tier_stats_.time_to_peak_throughput_ms =
+      MillisecondsSince(compile_start_);
+  TFLITE_LOG(INFO) << "Partition " << partition_index_
+                   << ": time to first inference "
+                   << compile_tier_stats_.time_to_first_inference_ms
+                   << " ms, time to peak throughput "
+                   << compile_tier_stats_.time_to_peak_throughput_ms << " ms";
+  return true;
+}
+
+std::string OpenVINODelegateCore::GetCacheFilePath(
+    const TfLiteOpenVINODelegateOptions *delegate_options,
+    const std::string &extension) const {
+  return GetCacheEntryPath(*delegate_options, partition_index_, extension);
+}
+
 TfLiteStatus OpenVINODelegateCore::CreateModel(
     TfLiteOpaqueContext *context, const TfLiteOpaqueDelegateParams *params,
     const TfLiteOpenVINODelegateOptions *delegate_options) {
+  if (delegate_options == nullptr) return kTfLiteError;
+  delegate_options_ = *delegate_options;
   // If cache_dir is set, and
   //    if cached model exists BuildModelFromCache
   //    else initialize and build model from tflite runtime
   if (!delegate_options->cache_dir.empty() &&
       !delegate_options->model_token.empty()) {
-    std::string cache_file_name = delegate_options->cache_dir + "/" +
-                                  delegate_options->model_token + ".xml";
+    std::string cache_file_name = GetCacheFilePath(delegate_options);
 
-    ov_core_.set_property(ov::cache_dir(delegate_options->cache_dir));
+    ov_core_->set_property(ov::cache_dir(delegate_options->cache_dir));
+    // Settings tuned on another host are ignored; they would be as likely
+    // to hurt as to help.
+    const std::string tuned_file_name =
+        GetCacheFilePath(delegate_options, ".tuned");
+    if (!delegate_options->tune_runtime_config &&
+        std::filesystem::exists(tuned_file_name) &&
+        LoadRuntimeConfig(
+            tuned_file_name,
+            GetHostFingerprint(*ov_core_, delegate_options->device_type),
+            &runtime_config_) == kTfLiteOk)
+      has_runtime_config_ = true;
     if (access(delegate_options->cache_dir.c_str(), R_OK) == 0) {
       // TFLITE_LOG(ERROR) << "Read access is there\n";
       if (std::filesystem::exists(cache_file_name)) {
+        auto import_start = std::chrono::steady_clock::now();
         auto status = BuildModelFromCache(context, params, cache_file_name);
-        if (status == kTfLiteOk)
+        if (status == kTfLiteOk) {
+          build_stats_.cache_result = BuildStats::CacheResult::kHit;
+          build_stats_.cache_import_ms = MillisecondsSince(import_start);
+          RecordPhaseMemory(&memory_stats_.cache_import,
+                            weight_stats_.resident_weight_bytes);
+          memory_stats_.duplicated_constant_bytes =
+              ComputeDuplicatedConstantBytes(context, params);
+          // Partitions that were never tuned have no precision map.
+          LoadPrecisionMap(GetCacheFilePath(delegate_options, ".precision"),
+                           &precision_map_);
+          AnalyzePartition(context, params);
           return status;
+        }
       }
       // TFLITE_LOG(ERROR) << "File absent\n";
     }
@@ -182,25 +758,61 @@ TfLiteStatus OpenVINODelegateCore::CreateModel(
   // If cache file is absent or caching is not enabled
   // Initialize model from TFLite runtime
 
+  if (!delegate_options->cache_dir.empty() &&
+      !delegate_options->model_token.empty())
+    build_stats_.cache_result = BuildStats::CacheResult::kMiss;
+  auto convert_start = std::chrono::steady_clock::now();
   auto status = InitializeBuilder(context, params);
   if (status != kTfLiteOk)
     return status;
+  build_stats_.convert_ms = MillisecondsSince(convert_start);
+  memory_stats_.duplicated_constant_bytes =
+      ComputeDuplicatedConstantBytes(context, params);
+  AnalyzePartition(context, params);
+  FinalizeModel();
+  // Calibration, tuning and serialization only need model_; they run with
+  // compilation, which may be off the delegate's thread.
+  optimize_converted_model_ = true;
+  return kTfLiteOk;
+}
 
-  //status = BuildModel();
-  //if (status != kTfLiteOk)
-  //    return status;
-  if (!delegate_options->cache_dir.empty() &&
-      !delegate_options->model_token.empty()) {
-    std::string cache_file_name = delegate_options->cache_dir + "/" +
-                                  delegate_options->model_token + ".xml";
-    if (access(delegate_options->cache_dir.c_str(), W_OK) == 0) {
-      ov::serialize(model_, cache_file_name);
+void OpenVINODelegateCore::OptimizeConvertedModel() {
+  if (delegate_options_.representative_dataset) {
+    ScopedTrace trace(tracer_.get(), "Calibrate", kTraceStartup,
+                      partition_index_);
+    Calibrator calibrator(ov_core_, delegate_options_.device_type);
+    if (calibrator.Calibrate(model_, compute_inputs_,
+                             delegate_options_.representative_dataset,
+                             delegate_options_.calibration_samples,
+                             &calibration_report_) == kTfLiteOk) {
+      TFLITE_LOG(INFO) << "Partition " << partition_index_ << ": calibrated "
+                       << calibration_report_.quantized_tensors
+                       << " tensors on " << calibration_report_.samples
+                       << " samples, max abs error vs f32 "
+                       << calibration_report_.max_abs_error << ", mean "
+                       << calibration_report_.mean_abs_error;
     } else {
-      // TFLITE_LOG(ERROR) << "Serialization failed\n Continue from built
-      // model\n";
+      TFLITE_LOG(ERROR) << "Partition " << partition_index_
+                        << ": calibration failed, running in f32";
     }
   }
-  return kTfLiteOk;
+  TunePrecision();
+
+  if (delegate_options_.cache_dir.empty() ||
+      delegate_options_.model_token.empty() ||
+      access(delegate_options_.cache_dir.c_str(), W_OK) != 0)
+    return;
+  ScopedTrace trace(tracer_.get(), "Serialize", kTraceStartup,
+                    partition_index_);
+  auto export_start = std::chrono::steady_clock::now();
+  ov::serialize(model_, GetCacheFilePath(&delegate_options_));
+  build_stats_.cache_export_ms = MillisecondsSince(export_start);
+  RecordPhaseMemory(&memory_stats_.serialize,
+                    weight_stats_.resident_weight_bytes);
+  if (!precision_map_.inference_precision.empty()) {
+    SavePrecisionMap(precision_map_,
+                     GetCacheFilePath(&delegate_options_, ".precision"));
+  }
 }
 } // namespace openvinodelegate
 } // namespace tflite
@@ -8,20 +8,129 @@
 
 #include <openvino/openvino.hpp>
 
+#include <chrono>
+#include <future>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "tensorflow/lite/delegates/intel_openvino/openvino_calibrator.h"
 #include "tensorflow/lite/delegates/intel_openvino/openvino_delegate.h"
 #include "tensorflow/lite/delegates/intel_openvino/openvino_graph_builder.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_partition_analyzer.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_precision_tuner.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_runtime_tuner.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_tracer.h"
 
 namespace tflite {
 namespace openvinodelegate {
+
+// Milestones of tiered compilation, in milliseconds since CompileAndInfer was
+// entered. A value of -1 means the milestone was not reached yet.
+struct CompileTierStats {
+  // The fast tier infer request exists; the partition can serve invokes.
+  double time_to_first_inference_ms = -1;
+  // The optimized tier finished compiling.
+  double optimized_tier_compiled_ms = -1;
+  // The optimized tier replaced the fast tier; peak throughput from here on.
+  double time_to_peak_throughput_ms = -1;
+};
+
+// Weights held by the OpenVINO model of one partition.
+struct WeightStats {
+  // Bytes of the weight constants in the precision they are kept resident
+  // in. Shape and axis constants are not weights and are left out.
+  int64_t resident_weight_bytes = 0;
+  // Bytes the same constants would take if expanded to f32.
+  int64_t f32_weight_bytes = 0;
+};
+
+// Time spent bringing up OpenVINO for one partition.
+struct PluginInitStats {
+  // Constructing ov::Core; 0 if the core is shared with other partitions.
+  double core_create_ms = 0;
+  // Loading and probing the plugin of the target device.
+  double device_init_ms = -1;
+};
+
+// Where the OpenVINO model of one partition came from and what it cost, in
+// milliseconds; -1 for steps that did not run.
+struct BuildStats {
+  enum class CacheResult { kDisabled, kHit, kMiss };
+  CacheResult cache_result = CacheResult::kDisabled;
+  // read_model of the cached IR.
+  double cache_import_ms = -1;
+  // Conversion of the TfLite partition.
+  double convert_ms = -1;
+  enum class Conversion { kNone, kFrontend, kGraphBuilder };
+  Conversion conversion = Conversion::kNone;
+  // serialize into cache_dir.
+  double cache_export_ms = -1;
+  // compile_model of the tier that serves the first inference.
+  double compile_ms = -1;
+};
+
+// Process RSS and the memory the delegate holds for one partition after a
+// startup phase, in bytes; -1 if the phase did not run.
+struct PhaseMemory {
+  int64_t rss_bytes = -1;
+  int64_t delegate_bytes = -1;
+};
+
+// Memory footprint of bringing up one partition.
+struct MemoryStats {
+  // Iterating the TfLite graph; the delegate holds densified weights only.
+  PhaseMemory graph_iteration;
+  // Frontend conversion; the delegate holds the model's constants.
+  PhaseMemory convert;
+  // read_model of a cache entry, in place of the two above.
+  PhaseMemory cache_import;
+  PhaseMemory serialize;
+  // compile_model and infer request creation; adds compiled_model_bytes.
+  PhaseMemory compile;
+  // The first inference, in warm-up or in the first Eval.
+  PhaseMemory first_infer;
+  // Process high-water mark at the last recorded phase.
+  int64_t peak_rss_bytes = -1;
+  // RSS growth over compile_model and infer request creation. RSS is
+  // process-wide, so partitions compiled at the same time (the parallel
+  // partition compiler, a background optimized tier) are counted in each
+  // other's numbers: under concurrent compilation this is an upper bound.
+  int64_t compiled_model_bytes = -1;
+  // Constants of the model that copy TfLite's read-only tensors instead of
+  // pointing into them.
+  int64_t duplicated_constant_bytes = -1;
+};
+
+// Latencies of the warm-up inferences run after compilation.
+struct WarmupStats {
+  int iterations = 0;
+  // Latency of the first, cold inference.
+  double cold_latency_ms = -1;
+  // Latency of the last warm-up inference.
+  double warm_latency_ms = -1;
+};
+
 class OpenVINODelegateCore {
  public:
-  explicit OpenVINODelegateCore(std::string plugins_path)
-      : ov_core_(ov::Core(plugins_path)) {}
-  TfLiteStatus Init();
+  // |partition_index| tells apart the cache entries of the partitions of one
+  // model.
+  explicit OpenVINODelegateCore(std::string plugins_path,
+                                int partition_index = 0);
+  // Uses an ov::Core shared with the other partitions of the delegate, so
+  // plugins are registered and loaded only once.
+  OpenVINODelegateCore(std::shared_ptr<ov::Core> ov_core, int partition_index)
+      : ov_core_(std::move(ov_core)), partition_index_(partition_index) {}
+
+  // Loads the plugin of |device_type| only, instead of probing every
+  // registered device.
+  TfLiteStatus Init(const std::string &device_type = "CPU");
+
+  // Phases run after this call are recorded to |tracer|, which may be null.
+  void SetTracer(std::shared_ptr<Tracer> tracer) {
+    tracer_ = std::move(tracer);
+  }
 
   std::vector<int> getComputeInputs() { return compute_inputs_; }
 
@@ -29,27 +138,167 @@ class OpenVINODelegateCore {
 
   ov::InferRequest getInferRequest() const { return infer_request_; }
 
+  std::shared_ptr<ov::Model> getModel() const { return model_; }
+
+  const ov::CompiledModel &getCompiledModel() const { return compiled_model_; }
+
+  // Converts the partition or imports it from the cache. The only step that
+  // reads the TfLite context; CompileAndInfer may run on another thread.
   TfLiteStatus CreateModel(TfLiteOpaqueContext *context,
                            const TfLiteOpaqueDelegateParams *params,
                            const TfLiteOpenVINODelegateOptions *options);
+  // Calibrates, tunes and caches a converted model, then compiles it.
   TfLiteStatus CompileAndInfer();
 
+  // Swaps in the optimized tier once its background compilation finished.
+  // Must be called between two invokes; never blocks. Returns true if the
+  // tier was swapped in by this call.
+  bool SwapInOptimizedModel();
+
+  const CompileTierStats &getCompileTierStats() const {
+    return compile_tier_stats_;
+  }
+
+  const WarmupStats &getWarmupStats() const { return warmup_stats_; }
+
+  const PluginInitStats &getPluginInitStats() const {
+    return plugin_init_stats_;
+  }
+
+  const WeightStats &getWeightStats() const { return weight_stats_; }
+
+  const BuildStats &getBuildStats() const { return build_stats_; }
+
+  const MemoryStats &getMemoryStats() const { return memory_stats_; }
+
+  // Records the memory after the first inference unless warm-up or an
+  // earlier call did. Returns true if it recorded.
+  bool RecordFirstInferMemory();
+
+  // Valid when the partition was calibrated, which happens in the
+  // CompileAndInfer call following the CreateModel that converted it.
+  const CalibrationReport &getCalibrationReport() const {
+    return calibration_report_;
+  }
+
+  // Per-layer precision applied at compile time, tuned in CompileAndInfer
+  // or loaded with the cache entry by CreateModel.
+  const PrecisionMap &getPrecisionMap() const { return precision_map_; }
+
+  // Valid when the partition was tuned in CompileAndInfer.
+  const PrecisionTuningReport &getPrecisionTuningReport() const {
+    return precision_tuning_report_;
+  }
+
+  // Settings the partition is compiled with, if tuned here or loaded with
+  // the cache entry; nullptr leaves them to the plugin.
+  const RuntimeConfig *getRuntimeConfig() const {
+    return has_runtime_config_ ? &runtime_config_ : nullptr;
+  }
+
+  // Valid when the settings were tuned in this CompileAndInfer call.
+  const RuntimeTuningReport &getRuntimeTuningReport() const {
+    return runtime_tuning_report_;
+  }
+
+  // Filled when options.analysis_dir is set.
+  const PartitionReport &getPartitionReport() const {
+    return partition_report_;
+  }
+
  private:
   TfLiteStatus BuildModelFromCache(TfLiteOpaqueContext *context,
                                    const TfLiteOpaqueDelegateParams *params,
                                    std::string cached_ir);
-  TfLiteStatus BuildModel();
+  // Converts the partition with OpenVINOGraphBuilder. Fails, leaving model_
+  // unset, if the partition has an op the builder does not cover.
+  TfLiteStatus BuildModel(TfLiteOpaqueContext *context,
+                          const TfLiteOpaqueDelegateParams *params);
+  // Keeps compressed weights compressed and accounts for their size.
+  void FinalizeModel();
+  // Fill partition_report_ from the TfLite partition and model_, and from
+  // compiled_model_; the latter also writes it to options.analysis_dir.
+  void AnalyzePartition(TfLiteOpaqueContext *context,
+                        const TfLiteOpaqueDelegateParams *params);
+  void AnalyzeCompiledPartition();
+  // Samples the process memory into |phase|.
+  void RecordPhaseMemory(PhaseMemory *phase, int64_t delegate_bytes);
+  // Attributes the RSS growth since |rss_before_compile| to the compiled
+  // model of the tier serving the first inference.
+  void RecordCompileMemory(int64_t rss_before_compile);
+  // Bytes of model_'s constants not backed by the read-only TfLite tensors
+  // of the partition.
+  int64_t ComputeDuplicatedConstantBytes(
+      TfLiteOpaqueContext *context, const TfLiteOpaqueDelegateParams *params);
+  // Runs the precision tuner if the options ask for mixed precision.
+  void TunePrecision();
+  // Calibrates and tunes the model CreateModel converted and writes it to
+  // the cache entry. Run by CompileAndInfer.
+  void OptimizeConvertedModel();
+  // Sweeps the runtime settings and saves the best next to the cache entry.
+  void TuneRuntimeConfig();
+  // Compile configuration carrying the inference precision and the tuned
+  // runtime settings, if any.
+  ov::AnyMap GetCompileConfig() const;
+  // Static so the background optimized tier can call it without the core.
+  static WarmupStats WarmUp(ov::InferRequest &infer_request, int iterations,
+                            Tracer *tracer, int partition_index);
+  // |extension| tells apart the files of one cache entry.
+  std::string GetCacheFilePath(
+      const TfLiteOpenVINODelegateOptions *delegate_options,
+      const std::string &extension = ".xml") const;
   TfLiteStatus InitializeBuilder(TfLiteOpaqueContext *context,
                                  const TfLiteOpaqueDelegateParams *params);
   std::unique_ptr<OpenVINOGraphBuilder> openvino_graph_builder_;
-  ov::Core ov_core_;
+  std::shared_ptr<ov::Core> ov_core_;
   std::shared_ptr<ov::Model> model_;
   ov::CompiledModel compiled_model_;
   std::vector<int> compute_inputs_;
   std::vector<int> outputs_;
   ov::InferRequest infer_request_;
+  int partition_index_;
+  TfLiteOpenVINODelegateOptions delegate_options_;
+  std::chrono::steady_clock::time_point compile_start_;
+  // Set by CreateModel when model_ was converted rather than imported.
+  bool optimize_converted_model_ = false;
+  // Optimized tier compiled and warmed up in the background.
+  struct OptimizedTier {
+    ov::CompiledModel compiled_model;
+    ov::InferRequest infer_request;
+    double compiled_ms;
+    WarmupStats warmup_stats;
+  };
+  CompileTierStats compile_tier_stats_;
+  WarmupStats warmup_stats_;
+  PluginInitStats plugin_init_stats_;
+  WeightStats weight_stats_;
+  BuildStats build_stats_;
+  MemoryStats memory_stats_;
+  CalibrationReport calibration_report_;
+  PrecisionMap precision_map_;
+  PrecisionTuningReport precision_tuning_report_;
+  RuntimeConfig runtime_config_;
+  bool has_runtime_config_ = false;
+  RuntimeTuningReport runtime_tuning_report_;
+  PartitionReport partition_report_;
+  std::shared_ptr<Tracer> tracer_;
+  // Last, so that its destructor, which waits for the background compile,
+  // runs while every other member is still alive.
+  std::future<OptimizedTier> optimized_model_;
 };
 
+// Creates the ov::Core for |plugins_path|. With a statically linked CPU
+// plugin (OPENVINO_DELEGATE_STATIC_CPU_PLUGIN) no plugins.xml is read and no
+// plugin library is dlopen'ed.
+std::shared_ptr<ov::Core> CreateOVCore(const std::string &plugins_path);
+
+// Path of one file of the cache entry of partition |partition_index|:
+// <cache_dir>/<model_token>[_<partition_index>]<extension>. |extension| tells
+// apart the files of one entry (".xml", ".bin", ".tuned", ".precision").
+std::string GetCacheEntryPath(const TfLiteOpenVINODelegateOptions &options,
+                              int partition_index,
+                              const std::string &extension);
+
 }  // namespace openvinodelegate
 }  // namespace tflite
 
@@ -8,11 +8,23 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
-#include <memory>
+#include <algorithm>
+#include <cmath>
 #include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
 #include <unordered_set>
+#include <vector>
+
+#include <openvino/runtime/exec_model_info.hpp>
+#include <transformations/rt_info/decompression.hpp>
+#include <transformations/rt_info/keep_const_precision.hpp>
 
 #include "tensorflow/lite/delegates/intel_openvino/openvino_graph_builder.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_test_model_builder.h"
 #include "tensorflow/lite/builtin_ops.h"
 #include "tensorflow/lite/c/c_api.h"
 #include "tensorflow/lite/core/kernels/builtin_op_kernels.h"
@@ -20,6 +32,7 @@
 #include "tensorflow/lite/interpreter_builder.h"
 #include "tensorflow/lite/kernels/kernel_util.h"
 #include "tensorflow/lite/kernels/register.h"
+#include "tensorflow/lite/model_builder.h"
 
 /* This file creates unit tests for openvino_delegate_core.cc to be run on host
  * machine without NPU */
@@ -27,6 +40,10 @@
 namespace tflite {
 namespace openvinodelegate {
 
+// Reduced precision CreateModelWithPrecisionTuning runs at; the kernel Init
+// it is read from cannot capture.
+std::string tuning_precision;
+
 class OpenVINODelegateCoreTest : public testing::Test {
  protected:
   TfLiteInterpreter* interpreter_ = nullptr;
@@ -238,6 +255,8 @@ TEST_F(OpenVINODelegateCoreTest, CreateModelAndCache) {
           std::filesystem::create_directory("/tmp/cache_test");
           EXPECT_EQ(kTfLiteOk, ov_delegate_core_test->CreateModel(
                                    opaque_context, params, &delegate_options));
+          // The cache entry is written before compile_model.
+          EXPECT_EQ(kTfLiteOk, ov_delegate_core_test->CompileAndInfer());
           EXPECT_EQ(true, std::filesystem::exists("/tmp/cache_test/abcdefgh.xml"));
           EXPECT_EQ(true, std::filesystem::exists("/tmp/cache_test/abcdefgh.bin"));
           void* void_fake_ptr = nullptr;
@@ -277,6 +296,431 @@ TEST_F(OpenVINODelegateCoreTest, CreateModelAndCache) {
   TfLiteOpaqueDelegateDelete(opaque_delegate_);
 }
 
+TEST_F(OpenVINODelegateCoreTest, CreateModelWithCalibration) {
+  TfLiteOpaqueDelegateBuilder opaque_delegate_builder{};
+  opaque_delegate_builder.Prepare = [](TfLiteOpaqueContext* opaque_context,
+                                       TfLiteOpaqueDelegate* opaque_delegate_,
+                                       void* data) -> TfLiteStatus {
+    auto reg_ex = TfLiteRegistrationExternalCreate(
+        kTfLiteBuiltinDelegate, "Test driver Openvino delegate", /*version=*/1);
+    TfLiteRegistrationExternalSetInit(
+        reg_ex,
+        [](TfLiteOpaqueContext* opaque_context, const char* buffer,
+           size_t length) -> void* {
+          const TfLiteOpaqueDelegateParams* params =
+              reinterpret_cast<const TfLiteOpaqueDelegateParams*>(buffer);
+
+          auto ov_delegate_core_test =
+              std::make_unique<tflite::openvinodelegate::OpenVINODelegateCore>(
+                  "");
+          TfLiteOpenVINODelegateOptions delegate_options;
+          delegate_options.cache_dir = "/tmp/calibration_test";
+          delegate_options.model_token = "calibrated";
+          delegate_options.calibration_samples = 8;
+          delegate_options.representative_dataset =
+              [](int sample_index, int tensor_index, void* data,
+                 size_t bytes) -> bool {
+            float* values = static_cast<float*>(data);
+            for (size_t i = 0; i < bytes / sizeof(float); i++)
+              values[i] = std::sin(0.1f * (i + 7 * sample_index));
+            return true;
+          };
+          std::filesystem::remove_all("/tmp/calibration_test");
+          std::filesystem::create_directory("/tmp/calibration_test");
+          EXPECT_EQ(kTfLiteOk, ov_delegate_core_test->CreateModel(
+                                   opaque_context, params, &delegate_options));
+          // Calibration runs with compilation, not with the conversion.
+          EXPECT_EQ(0, ov_delegate_core_test->getCalibrationReport().samples);
+          EXPECT_EQ(kTfLiteOk, ov_delegate_core_test->CompileAndInfer());
+          const CalibrationReport& report =
+              ov_delegate_core_test->getCalibrationReport();
+          EXPECT_EQ(8, report.samples);
+          EXPECT_GT(report.quantized_tensors, 0);
+          EXPECT_GE(report.max_abs_error, 0);
+          EXPECT_LT(report.max_abs_error, 0.1);
+
+          // The cache holds the quantized model.
+          std::ifstream cached_ir("/tmp/calibration_test/calibrated.xml");
+          std::string ir((std::istreambuf_iterator<char>(cached_ir)),
+                         std::istreambuf_iterator<char>());
+          EXPECT_NE(std::string::npos, ir.find("FakeQuantize"));
+          void* void_fake_ptr = nullptr;
+          return void_fake_ptr;
+        });
+
+    TfLiteRegistrationExternalSetInvoke(
+        reg_ex,
+        [](TfLiteOpaqueContext* context, TfLiteOpaqueNode* opaque_node)
+            -> TfLiteStatus { return kTfLiteOk; });
+
+    TfLiteRegistrationExternalSetFree(
+        reg_ex, [](TfLiteOpaqueContext* context, void* data) {});
+
+    TfLiteIntArray* execution_plan;
+    TF_LITE_ENSURE_STATUS(
+        TfLiteOpaqueContextGetExecutionPlan(opaque_context, &execution_plan));
+    TfLiteOpaqueContextReplaceNodeSubsetsWithDelegateKernels(
+        opaque_context, reg_ex, execution_plan, opaque_delegate_);
+    return kTfLiteOk;
+  };
+
+  model_ = TfLiteModelCreateFromFile(
+      "external/org_tensorflow/tensorflow/lite/testdata/add.bin");
+  ASSERT_NE(model_, nullptr);
+  opaque_delegate_ = TfLiteOpaqueDelegateCreate(&opaque_delegate_builder);
+  TfLiteInterpreterOptions* options = TfLiteInterpreterOptionsCreate();
+  ASSERT_NE(options, nullptr);
+  TfLiteInterpreterOptionsAddDelegate(options, opaque_delegate_);
+  interpreter_ = TfLiteInterpreterCreate(model_, options);
+  ASSERT_NE(interpreter_, nullptr);
+
+  TfLiteInterpreterOptionsDelete(options);
+  TfLiteInterpreterDelete(interpreter_);
+  TfLiteModelDelete(model_);
+  TfLiteOpaqueDelegateDelete(opaque_delegate_);
+}
+
+TEST_F(OpenVINODelegateCoreTest, CreateModelWithPrecisionTuning) {
+  const std::vector<std::string> capabilities =
+      CreateOVCore("")->get_property("CPU", ov::device::capabilities);
+  auto has_capability = [&capabilities](const std::string &capability) {
+    return std::find(capabilities.begin(), capabilities.end(), capability) !=
+           capabilities.end();
+  };
+  if (has_capability(ov::device::capability::BF16)) {
+    tuning_precision = "bf16";
+  } else if (has_capability(ov::device::capability::FP16)) {
+    tuning_precision = "f16";
+  } else {
+    GTEST_SKIP() << "The CPU supports neither bf16 nor f16 inference";
+  }
+
+  TfLiteOpaqueDelegateBuilder opaque_delegate_builder{};
+  opaque_delegate_builder.Prepare = [](TfLiteOpaqueContext* opaque_context,
+                                       TfLiteOpaqueDelegate* opaque_delegate_,
+                                       void* data) -> TfLiteStatus {
+    auto reg_ex = TfLiteRegistrationExternalCreate(
+        kTfLiteBuiltinDelegate, "Test driver Openvino delegate", /*version=*/1);
+    TfLiteRegistrationExternalSetInit(
+        reg_ex,
+        [](TfLiteOpaqueContext* opaque_context, const char* buffer,
+           size_t length) -> void* {
+          const TfLiteOpaqueDelegateParams* params =
+              reinterpret_cast<const TfLiteOpaqueDelegateParams*>(buffer);
+
+          TfLiteOpenVINODelegateOptions delegate_options;
+          delegate_options.cache_dir = "/tmp/precision_tuning_test";
+          delegate_options.model_token = "tuned";
+          delegate_options.inference_precision = tuning_precision;
+          // Tight enough that any bf16 or f16 rounding raises layers to f32.
+          delegate_options.max_precision_error = 1e-6f;
+          delegate_options.validation_samples = 4;
+          delegate_options.validation_dataset =
+              [](int sample_index, int tensor_index, void* data,
+                 size_t bytes) -> bool {
+            float* values = static_cast<float*>(data);
+            for (size_t i = 0; i < bytes / sizeof(float); i++)
+              values[i] = 1.0f + std::sin(0.37f * (i + 11 * sample_index));
+            return true;
+          };
+          std::filesystem::remove_all("/tmp/precision_tuning_test");
+          std::filesystem::create_directory("/tmp/precision_tuning_test");
+
+          auto tuned_core =
+              std::make_unique<tflite::openvinodelegate::OpenVINODelegateCore>(
+                  "");
+          EXPECT_EQ(kTfLiteOk, tuned_core->CreateModel(opaque_context, params,
+                                                       &delegate_options));
+          EXPECT_EQ(kTfLiteOk, tuned_core->CompileAndInfer());
+          const PrecisionTuningReport& report =
+              tuned_core->getPrecisionTuningReport();
+          EXPECT_EQ(4, report.samples);
+          EXPECT_GT(report.candidate_layers, 0);
+          EXPECT_TRUE(report.threshold_met);
+          EXPECT_LE(report.max_abs_error, 1e-6);
+          EXPECT_EQ(static_cast<size_t>(report.f32_layers),
+                    tuned_core->getPrecisionMap().f32_layers.size());
+          EXPECT_TRUE(std::filesystem::exists(
+              "/tmp/precision_tuning_test/tuned.precision"));
+
+          // A later load from the cache applies the same map without tuning.
+          delegate_options.validation_dataset = nullptr;
+          auto cached_core =
+              std::make_unique<tflite::openvinodelegate::OpenVINODelegateCore>(
+                  "");
+          EXPECT_EQ(kTfLiteOk, cached_core->CreateModel(opaque_context, params,
+                                                        &delegate_options));
+          EXPECT_EQ(0, cached_core->getPrecisionTuningReport().iterations);
+          EXPECT_EQ(tuning_precision,
+                    cached_core->getPrecisionMap().inference_precision);
+          EXPECT_EQ(tuned_core->getPrecisionMap().f32_layers,
+                    cached_core->getPrecisionMap().f32_layers);
+          EXPECT_EQ(kTfLiteOk, cached_core->CompileAndInfer());
+
+          // The plugin honoured the map: every f32 layer still runs in f32.
+          const std::shared_ptr<const ov::Model> runtime_model =
+              cached_core->getCompiledModel().get_runtime_model();
+          for (const std::string &layer :
+               cached_core->getPrecisionMap().f32_layers) {
+            bool runs_in_f32 = false;
+            for (const auto &op : runtime_model->get_ordered_ops()) {
+              const ov::RTMap &rt_info = op->get_rt_info();
+              auto names = rt_info.find(ov::exec_model_info::ORIGINAL_NAMES);
+              auto precision =
+                  rt_info.find(ov::exec_model_info::RUNTIME_PRECISION);
+              if (names == rt_info.end() || precision == rt_info.end())
+                continue;
+              std::stringstream name_list(names->second.as<std::string>());
+              for (std::string name; std::getline(name_list, name, ',');) {
+                if (name == layer &&
+                    precision->second.as<std::string>() == "f32")
+                  runs_in_f32 = true;
+              }
+            }
+            EXPECT_TRUE(runs_in_f32) << layer;
+          }
+          void* void_fake_ptr = nullptr;
+          return void_fake_ptr;
+        });
+
+    TfLiteRegistrationExternalSetInvoke(
+        reg_ex,
+        [](TfLiteOpaqueContext* context, TfLiteOpaqueNode* opaque_node)
+            -> TfLiteStatus { return kTfLiteOk; });
+
+    TfLiteRegistrationExternalSetFree(
+        reg_ex, [](TfLiteOpaqueContext* context, void* data) {});
+
+    TfLiteIntArray* execution_plan;
+    TF_LITE_ENSURE_STATUS(
+        TfLiteOpaqueContextGetExecutionPlan(opaque_context, &execution_plan));
+    TfLiteOpaqueContextReplaceNodeSubsetsWithDelegateKernels(
+        opaque_context, reg_ex, execution_plan, opaque_delegate_);
+    return kTfLiteOk;
+  };
+
+  model_ = TfLiteModelCreateFromFile(
+      "external/org_tensorflow/tensorflow/lite/testdata/add.bin");
+  ASSERT_NE(model_, nullptr);
+  opaque_delegate_ = TfLiteOpaqueDelegateCreate(&opaque_delegate_builder);
+  TfLiteInterpreterOptions* options = TfLiteInterpreterOptionsCreate();
+  ASSERT_NE(options, nullptr);
+  TfLiteInterpreterOptionsAddDelegate(options, opaque_delegate_);
+  interpreter_ = TfLiteInterpreterCreate(model_, options);
+  ASSERT_NE(interpreter_, nullptr);
+
+  TfLiteInterpreterOptionsDelete(options);
+  TfLiteInterpreterDelete(interpreter_);
+  TfLiteModelDelete(model_);
+  TfLiteOpaqueDelegateDelete(opaque_delegate_);
+}
+
+TEST_F(OpenVINODelegateCoreTest, CompileAndInferWithWarmup) {
+  TfLiteOpaqueDelegateBuilder opaque_delegate_builder{};
+  opaque_delegate_builder.Prepare = [](TfLiteOpaqueContext* opaque_context,
+                                       TfLiteOpaqueDelegate* opaque_delegate_,
+                                       void* data) -> TfLiteStatus {
+    auto reg_ex = TfLiteRegistrationExternalCreate(
+        kTfLiteBuiltinDelegate, "Test driver Openvino delegate", /*version=*/1);
+    TfLiteRegistrationExternalSetInit(
+        reg_ex,
+        [](TfLiteOpaqueContext* opaque_context, const char* buffer,
+           size_t length) -> void* {
+          const TfLiteOpaqueDelegateParams* params =
+              reinterpret_cast<const TfLiteOpaqueDelegateParams*>(buffer);
+
+          auto ov_delegate_core_test =
+              std::make_unique<tflite::openvinodelegate::OpenVINODelegateCore>(
+                  "");
+          TfLiteOpenVINODelegateOptions delegate_options;
+          delegate_options.warmup_iterations = 3;
+          EXPECT_EQ(kTfLiteOk, ov_delegate_core_test->CreateModel(
+                                   opaque_context, params, &delegate_options));
+          EXPECT_EQ(kTfLiteOk, ov_delegate_core_test->CompileAndInfer());
+          const WarmupStats& stats = ov_delegate_core_test->getWarmupStats();
+          EXPECT_EQ(3, stats.iterations);
+          EXPECT_GE(stats.cold_latency_ms, 0);
+          EXPECT_GE(stats.warm_latency_ms, 0);
+          void* void_fake_ptr = nullptr;
+          return void_fake_ptr;
+        });
+
+    TfLiteRegistrationExternalSetInvoke(
+        reg_ex,
+        [](TfLiteOpaqueContext* context, TfLiteOpaqueNode* opaque_node)
+            -> TfLiteStatus { return kTfLiteOk; });
+
+    TfLiteRegistrationExternalSetFree(
+        reg_ex, [](TfLiteOpaqueContext* context, void* data) {});
+
+    TfLiteIntArray* execution_plan;
+    TF_LITE_ENSURE_STATUS(
+        TfLiteOpaqueContextGetExecutionPlan(opaque_context, &execution_plan));
+    TfLiteOpaqueContextReplaceNodeSubsetsWithDelegateKernels(
+        opaque_context, reg_ex, execution_plan, opaque_delegate_);
+    return kTfLiteOk;
+  };
+
+  model_ = TfLiteModelCreateFromFile(
+      "external/org_tensorflow/tensorflow/lite/testdata/add.bin");
+  ASSERT_NE(model_, nullptr);
+  opaque_delegate_ = TfLiteOpaqueDelegateCreate(&opaque_delegate_builder);
+  TfLiteInterpreterOptions* options = TfLiteInterpreterOptionsCreate();
+  ASSERT_NE(options, nullptr);
+  TfLiteInterpreterOptionsAddDelegate(options, opaque_delegate_);
+  interpreter_ = TfLiteInterpreterCreate(model_, options);
+  ASSERT_NE(interpreter_, nullptr);
+
+  TfLiteInterpreterOptionsDelete(options);
+  TfLiteInterpreterDelete(interpreter_);
+  TfLiteModelDelete(model_);
+  TfLiteOpaqueDelegateDelete(opaque_delegate_);
+}
+
+TEST_F(OpenVINODelegateCoreTest, InitLoadsRequestedDeviceOnly) {
+  auto ov_delegate_core_test =
+      std::make_unique<tflite::openvinodelegate::OpenVINODelegateCore>("");
+  EXPECT_EQ(kTfLiteOk, ov_delegate_core_test->Init("CPU"));
+  EXPECT_GE(ov_delegate_core_test->getPluginInitStats().core_create_ms, 0);
+  EXPECT_GE(ov_delegate_core_test->getPluginInitStats().device_init_ms, 0);
+
+  EXPECT_EQ(kTfLiteDelegateError,
+            ov_delegate_core_test->Init("NOT_A_DEVICE"));
+}
+
+TEST_F(OpenVINODelegateCoreTest, InitWithSharedCore) {
+  std::shared_ptr<ov::Core> ov_core = CreateOVCore("");
+  auto first_core =
+      std::make_unique<tflite::openvinodelegate::OpenVINODelegateCore>(
+          ov_core, /*partition_index=*/0);
+  auto second_core =
+      std::make_unique<tflite::openvinodelegate::OpenVINODelegateCore>(
+          ov_core, /*partition_index=*/1);
+  EXPECT_EQ(kTfLiteOk, first_core->Init("CPU"));
+  EXPECT_EQ(kTfLiteOk, second_core->Init("CPU"));
+  EXPECT_EQ(0, second_core->getPluginInitStats().core_create_ms);
+}
+
+TEST_F(OpenVINODelegateCoreTest, CacheEntryPath) {
+  TfLiteOpenVINODelegateOptions options;
+  options.cache_dir = "/tmp/cache";
+  options.model_token = "model";
+  EXPECT_EQ("/tmp/cache/model.xml", GetCacheEntryPath(options, 0, ".xml"));
+  EXPECT_EQ("/tmp/cache/model_2.tuned",
+            GetCacheEntryPath(options, 2, ".tuned"));
+}
+
+TEST_F(OpenVINODelegateCoreTest, RuntimeConfigRequiresMatchingHost) {
+  std::shared_ptr<ov::Core> ov_core = CreateOVCore("");
+  const std::string fingerprint = GetHostFingerprint(*ov_core, "CPU");
+  RuntimeConfig config;
+  config.performance_mode = "THROUGHPUT";
+  config.num_streams = 2;
+  config.inference_num_threads = 3;
+  config.enable_cpu_pinning = false;
+  ASSERT_EQ(kTfLiteOk,
+            SaveRuntimeConfig(config, fingerprint, "/tmp/runtime_config.tuned"));
+
+  RuntimeConfig loaded;
+  ASSERT_EQ(kTfLiteOk, LoadRuntimeConfig("/tmp/runtime_config.tuned",
+                                         fingerprint, &loaded));
+  EXPECT_EQ("THROUGHPUT", loaded.performance_mode);
+  EXPECT_EQ(2, loaded.num_streams);
+  EXPECT_EQ(3, loaded.inference_num_threads);
+  EXPECT_FALSE(loaded.enable_cpu_pinning);
+  EXPECT_EQ(kTfLiteError, LoadRuntimeConfig("/tmp/runtime_config.tuned",
+                                            fingerprint + " elsewhere",
+                                            &loaded));
+}
+
+TEST_F(OpenVINODelegateCoreTest, TuneRuntimeConfigAndReload) {
+  TfLiteOpaqueDelegateBuilder opaque_delegate_builder{};
+  opaque_delegate_builder.Prepare = [](TfLiteOpaqueContext* opaque_context,
+                                       TfLiteOpaqueDelegate* opaque_delegate_,
+                                       void* data) -> TfLiteStatus {
+    auto reg_ex = TfLiteRegistrationExternalCreate(
+        kTfLiteBuiltinDelegate, "Test driver Openvino delegate", /*version=*/1);
+    TfLiteRegistrationExternalSetInit(
+        reg_ex,
+        [](TfLiteOpaqueContext* opaque_context, const char* buffer,
+           size_t length) -> void* {
+          const TfLiteOpaqueDelegateParams* params =
+              reinterpret_cast<const TfLiteOpaqueDelegateParams*>(buffer);
+
+          TfLiteOpenVINODelegateOptions delegate_options;
+          delegate_options.cache_dir = "/tmp/runtime_tuning_test";
+          delegate_options.model_token = "tuned";
+          delegate_options.tune_runtime_config = true;
+          delegate_options.tuning_iterations = 2;
+          std::filesystem::remove_all("/tmp/runtime_tuning_test");
+          std::filesystem::create_directory("/tmp/runtime_tuning_test");
+
+          auto tuned_core =
+              std::make_unique<tflite::openvinodelegate::OpenVINODelegateCore>(
+                  "");
+          EXPECT_EQ(kTfLiteOk, tuned_core->Init("CPU"));
+          EXPECT_EQ(kTfLiteOk, tuned_core->CreateModel(opaque_context, params,
+                                                       &delegate_options));
+          EXPECT_EQ(kTfLiteOk, tuned_core->CompileAndInfer());
+          EXPECT_GT(tuned_core->getRuntimeTuningReport().candidates, 1);
+          EXPECT_GT(tuned_core->getRuntimeTuningReport().latency_ms, 0);
+          ASSERT_NE(nullptr, tuned_core->getRuntimeConfig());
+          EXPECT_TRUE(std::filesystem::exists(
+              "/tmp/runtime_tuning_test/tuned.tuned"));
+
+          // The next run on this host picks the tuned settings up.
+          delegate_options.tune_runtime_config = false;
+          auto cached_core =
+              std::make_unique<tflite::openvinodelegate::OpenVINODelegateCore>(
+                  "");
+          EXPECT_EQ(kTfLiteOk, cached_core->Init("CPU"));
+          EXPECT_EQ(kTfLiteOk, cached_core->CreateModel(opaque_context, params,
+                                                        &delegate_options));
+          ASSERT_NE(nullptr, cached_core->getRuntimeConfig());
+          EXPECT_EQ(tuned_core->getRuntimeConfig()->performance_mode,
+                    cached_core->getRuntimeConfig()->performance_mode);
+          EXPECT_EQ(tuned_core->getRuntimeConfig()->num_streams,
+                    cached_core->getRuntimeConfig()->num_streams);
+          EXPECT_EQ(tuned_core->getRuntimeConfig()->inference_num_threads,
+                    cached_core->getRuntimeConfig()->inference_num_threads);
+          EXPECT_EQ(kTfLiteOk, cached_core->CompileAndInfer());
+          EXPECT_EQ(0, cached_core->getRuntimeTuningReport().candidates);
+          void* void_fake_ptr = nullptr;
+          return void_fake_ptr;
+        });
+
+    TfLiteRegistrationExternalSetInvoke(
+        reg_ex,
+        [](TfLiteOpaqueContext* context, TfLiteOpaqueNode* opaque_node)
+            -> TfLiteStatus { return kTfLiteOk; });
+
+    TfLiteRegistrationExternalSetFree(
+        reg_ex, [](TfLiteOpaqueContext* context, void* data) {});
+
+    TfLiteIntArray* execution_plan;
+    TF_LITE_ENSURE_STATUS(
+        TfLiteOpaqueContextGetExecutionPlan(opaque_context, &execution_plan));
+    TfLiteOpaqueContextReplaceNodeSubsetsWithDelegateKernels(
+        opaque_context, reg_ex, execution_plan, opaque_delegate_);
+    return kTfLiteOk;
+  };
+
+  model_ = TfLiteModelCreateFromFile(
+      "external/org_tensorflow/tensorflow/lite/testdata/add.bin");
+  ASSERT_NE(model_, nullptr);
+  opaque_delegate_ = TfLiteOpaqueDelegateCreate(&opaque_delegate_builder);
+  TfLiteInterpreterOptions* options = TfLiteInterpreterOptionsCreate();
+  ASSERT_NE(options, nullptr);
+  TfLiteInterpreterOptionsAddDelegate(options, opaque_delegate_);
+  interpreter_ = TfLiteInterpreterCreate(model_, options);
+  ASSERT_NE(interpreter_, nullptr);
+
+  TfLiteInterpreterOptionsDelete(options);
+  TfLiteInterpreterDelete(interpreter_);
+  TfLiteModelDelete(model_);
+  TfLiteOpaqueDelegateDelete(opaque_delegate_);
+}
+
 void demo_perms(std::filesystem::perms p)
 {
     using std::filesystem::perms;
@@ -377,6 +821,252 @@ TEST_F(OpenVINODelegateCoreTest, CreateModelAndCache_Invalidcache_dir) {
   TfLiteOpaqueDelegateDelete(opaque_delegate_);
 }
 
+TEST_F(OpenVINODelegateCoreTest, AnalyzePartition) {
+  TfLiteOpaqueDelegateBuilder opaque_delegate_builder{};
+  opaque_delegate_builder.Prepare = [](TfLiteOpaqueContext* opaque_context,
+                                       TfLiteOpaqueDelegate* opaque_delegate_,
+                                       void* data) -> TfLiteStatus {
+    auto reg_ex = TfLiteRegistrationExternalCreate(
+        kTfLiteBuiltinDelegate, "Test driver Openvino delegate", /*version=*/1);
+    TfLiteRegistrationExternalSetInit(
+        reg_ex,
+        [](TfLiteOpaqueContext* opaque_context, const char* buffer,
+           size_t length) -> void* {
+          const TfLiteOpaqueDelegateParams* params =
+              reinterpret_cast<const TfLiteOpaqueDelegateParams*>(buffer);
+
+          auto ov_delegate_core_test =
+              std::make_unique<tflite::openvinodelegate::OpenVINODelegateCore>(
+                  "");
+          TfLiteOpenVINODelegateOptions delegate_options;
+          delegate_options.analysis_dir = "/tmp/analysis_test";
+          std::filesystem::remove_all("/tmp/analysis_test");
+          std::filesystem::create_directory("/tmp/analysis_test");
+          EXPECT_EQ(kTfLiteOk, ov_delegate_core_test->Init("CPU"));
+          EXPECT_EQ(kTfLiteOk, ov_delegate_core_test->CreateModel(
+                                   opaque_context, params, &delegate_options));
+          EXPECT_EQ(kTfLiteOk, ov_delegate_core_test->CompileAndInfer());
+
+          const PartitionReport& report =
+              ov_delegate_core_test->getPartitionReport();
+          EXPECT_EQ(0, report.partition_index);
+          ASSERT_EQ(1, report.tflite_ops.count("ADD"));
+          EXPECT_EQ(params->nodes_to_replace->size,
+                    report.tflite_ops.at("ADD"));
+          // One operation per output element of every ADD.
+          EXPECT_GT(report.estimated_flops, 0);
+          int64_t input_bytes = 0;
+          for (int t : ov_delegate_core_test->getComputeInputs())
+            input_bytes += TfLiteOpaqueTensorByteSize(
+                TfLiteOpaqueContextGetOpaqueTensor(opaque_context, t));
+          EXPECT_EQ(input_bytes, report.input_bytes_per_eval);
+          EXPECT_GT(report.output_bytes_per_eval, 0);
+          EXPECT_GE(report.model_ops, params->nodes_to_replace->size);
+          // Elementwise adds need no layout changes.
+          EXPECT_EQ(0, report.inserted_transposes);
+          EXPECT_EQ(0, report.inserted_converts);
+          EXPECT_GT(report.runtime_model_ops, 0);
+          EXPECT_GE(report.runtime_reorders, 0);
+
+          std::ifstream report_file("/tmp/analysis_test/partition_0.json");
+          EXPECT_TRUE(report_file.good());
+          std::string json((std::istreambuf_iterator<char>(report_file)),
+                           std::istreambuf_iterator<char>());
+          EXPECT_THAT(json, testing::HasSubstr("\"tflite_ops\":{\"ADD\":"));
+          EXPECT_THAT(json, testing::HasSubstr("\"runtime_model_ops\":"));
+          void* void_fake_ptr = nullptr;
+          return void_fake_ptr;
+        });
+
+    TfLiteRegistrationExternalSetInvoke(
+        reg_ex,
+        [](TfLiteOpaqueContext* context, TfLiteOpaqueNode* opaque_node)
+            -> TfLiteStatus { return kTfLiteOk; });
+
+    TfLiteRegistrationExternalSetFree(
+        reg_ex, [](TfLiteOpaqueContext* context, void* data) {});
+
+    TfLiteIntArray* execution_plan;
+    TF_LITE_ENSURE_STATUS(
+        TfLiteOpaqueContextGetExecutionPlan(opaque_context, &execution_plan));
+    TfLiteOpaqueContextReplaceNodeSubsetsWithDelegateKernels(
+        opaque_context, reg_ex, execution_plan, opaque_delegate_);
+    return kTfLiteOk;
+  };
+
+  model_ = TfLiteModelCreateFromFile(
+      "external/org_tensorflow/tensorflow/lite/testdata/add.bin");
+  ASSERT_NE(model_, nullptr);
+  opaque_delegate_ = TfLiteOpaqueDelegateCreate(&opaque_delegate_builder);
+  TfLiteInterpreterOptions* options = TfLiteInterpreterOptionsCreate();
+  ASSERT_NE(options, nullptr);
+  TfLiteInterpreterOptionsAddDelegate(options, opaque_delegate_);
+  interpreter_ = TfLiteInterpreterCreate(model_, options);
+  ASSERT_NE(interpreter_, nullptr);
+
+  TfLiteInterpreterOptionsDelete(options);
+  TfLiteInterpreterDelete(interpreter_);
+  TfLiteModelDelete(model_);
+  TfLiteOpaqueDelegateDelete(opaque_delegate_);
+}
+
+// A partition converted by OpenVINODelegateCore::CreateModel, from inside
+// the kernel Init of a test delegate that takes the whole graph.
+struct CreatedModel {
+  TfLiteOpenVINODelegateOptions options;
+  std::unique_ptr<FlatBufferModel> tflite_model;
+  std::unique_ptr<OpenVINODelegateCore> core;
+  TfLiteStatus status = kTfLiteError;
+};
+
+// Runs CreateModel on the model in |buffer|, which must outlive |created|.
+void CreateModelFromBuffer(const std::vector<char>& buffer,
+                           CreatedModel* created) {
+  created->tflite_model =
+      FlatBufferModel::BuildFromBuffer(buffer.data(), buffer.size());
+  ASSERT_NE(created->tflite_model, nullptr);
+
+  TfLiteOpaqueDelegateBuilder opaque_delegate_builder{};
+  opaque_delegate_builder.data = created;
+  opaque_delegate_builder.Prepare = [](TfLiteOpaqueContext* opaque_context,
+                                       TfLiteOpaqueDelegate* opaque_delegate,
+                                       void* data) -> TfLiteStatus {
+    auto reg_ex = TfLiteRegistrationExternalCreate(
+        kTfLiteBuiltinDelegate, "Test driver Openvino delegate", /*version=*/1);
+    TfLiteRegistrationExternalSetInit(
+        reg_ex,
+        [](TfLiteOpaqueContext* opaque_context, const char* buffer,
+           size_t length) -> void* {
+          const TfLiteOpaqueDelegateParams* params =
+              reinterpret_cast<const TfLiteOpaqueDelegateParams*>(buffer);
+          auto* created = static_cast<CreatedModel*>(params->delegate_data);
+          created->core = std::make_unique<OpenVINODelegateCore>("");
+          created->status = created->core->CreateModel(opaque_context, params,
+                                                       &created->options);
+          return nullptr;
+        });
+    TfLiteRegistrationExternalSetInvoke(
+        reg_ex,
+        [](TfLiteOpaqueContext* context, TfLiteOpaqueNode* opaque_node)
+            -> TfLiteStatus { return kTfLiteOk; });
+    TfLiteRegistrationExternalSetFree(
+        reg_ex, [](TfLiteOpaqueContext* context, void* data) {});
+
+    TfLiteIntArray* execution_plan;
+    TF_LITE_ENSURE_STATUS(
+        TfLiteOpaqueContextGetExecutionPlan(opaque_context, &execution_plan));
+    return TfLiteOpaqueContextReplaceNodeSubsetsWithDelegateKernels(
+        opaque_context, reg_ex, execution_plan, opaque_delegate);
+  };
+
+  TfLiteOpaqueDelegate* opaque_delegate =
+      TfLiteOpaqueDelegateCreate(&opaque_delegate_builder);
+  {
+    ops::builtin::BuiltinOpResolver resolver;
+    InterpreterBuilder builder(*created->tflite_model, resolver);
+    builder.AddDelegate(opaque_delegate);
+    std::unique_ptr<Interpreter> interpreter;
+    EXPECT_EQ(kTfLiteOk, builder(&interpreter));
+  }
+  TfLiteOpaqueDelegateDelete(opaque_delegate);
+}
+
+// DEQUANTIZE(|weights|) + ADD(input, dequantized) on a 1x2x2x3 tensor.
+std::vector<char> BuildDequantizeAddModel(TensorType weights_type,
+                                          const TestQuantization& quantization,
+                                          const std::vector<uint8_t>& weights) {
+  const std::vector<int32_t> shape = {1, 2, 2, 3};
+  TestModelBuilder builder;
+  const int input = builder.AddTensor(shape, TensorType_FLOAT32);
+  const int quantized =
+      builder.AddTensor(shape, weights_type, quantization, weights);
+  const int dequantized = builder.AddTensor(shape, TensorType_FLOAT32);
+  const int output = builder.AddTensor(shape, TensorType_FLOAT32);
+  builder.AddOperator(BuiltinOperator_DEQUANTIZE, {quantized}, {dequantized});
+  builder.AddOperator(BuiltinOperator_ADD, {input, dequantized}, {output},
+                      BuiltinOptions_AddOptions,
+                      CreateAddOptions(builder.builder()).Union());
+  return builder.Finish({input}, {output});
+}
+
+// The weights constant of |model| behind a decompression Convert, or null.
+std::shared_ptr<ov::Node> GetDecompressedWeights(
+    const std::shared_ptr<ov::Model>& model) {
+  for (const auto& op : model->get_ordered_ops()) {
+    if (!ov::is_type<ov::op::v0::Convert>(op) || !ov::is_decompression(op))
+      continue;
+    auto weights = op->get_input_node_shared_ptr(0);
+    if (ov::is_type<ov::op::v0::Constant>(weights) &&
+        ov::shape_size(weights->get_shape()) == 12)
+      return weights;
+  }
+  return nullptr;
+}
+
+TEST_F(OpenVINODelegateCoreTest, Int8WeightsStayCompressedByDefault) {
+  const std::vector<int8_t> weights = {-8, 4,  6,  10,  -3,   0,
+                                       2,  1, -2, 127, -128, 30};
+  const std::vector<char> buffer = BuildDequantizeAddModel(
+      TensorType_INT8, {{0.5f}, {1}},
+      std::vector<uint8_t>(weights.begin(), weights.end()));
+  CreatedModel created;
+  ASSERT_EQ("frontend", created.options.conversion_backend);
+  CreateModelFromBuffer(buffer, &created);
+  ASSERT_EQ(kTfLiteOk, created.status);
+
+  // The frontend would expand the weights to f32, so the partition went
+  // through the graph builder's decompression subgraph.
+  EXPECT_EQ(BuildStats::Conversion::kGraphBuilder,
+            created.core->getBuildStats().conversion);
+  std::shared_ptr<ov::Node> weights_node =
+      GetDecompressedWeights(created.core->getModel());
+  ASSERT_NE(weights_node, nullptr);
+  EXPECT_EQ(ov::element::i8, weights_node->get_output_element_type(0));
+  EXPECT_TRUE(ov::is_keep_const_precision(weights_node));
+  EXPECT_EQ(kTfLiteOk, created.core->CompileAndInfer());
+}
+
+TEST_F(OpenVINODelegateCoreTest, CompressedWeightsSurviveCacheImport) {
+  std::vector<uint8_t> weights;
+  for (int i = 0; i < 12; i++) {
+    const uint16_t bits = ov::float16(0.25f * i - 1.0f).to_bits();
+    weights.push_back(bits & 0xff);
+    weights.push_back(bits >> 8);
+  }
+  const std::vector<char> buffer =
+      BuildDequantizeAddModel(TensorType_FLOAT16, {}, weights);
+  std::filesystem::remove_all("/tmp/compressed_weights_test");
+  std::filesystem::create_directory("/tmp/compressed_weights_test");
+
+  // Converted by the frontend and serialized, then imported from the cache.
+  for (const BuildStats::CacheResult cache_result :
+       {BuildStats::CacheResult::kMiss, BuildStats::CacheResult::kHit}) {
+    CreatedModel created;
+    created.options.cache_dir = "/tmp/compressed_weights_test";
+    created.options.model_token = "compressed";
+    CreateModelFromBuffer(buffer, &created);
+    ASSERT_EQ(kTfLiteOk, created.status);
+    EXPECT_EQ(cache_result, created.core->getBuildStats().cache_result);
+    if (cache_result == BuildStats::CacheResult::kMiss) {
+      EXPECT_EQ(BuildStats::Conversion::kFrontend,
+                created.core->getBuildStats().conversion);
+    }
+
+    std::shared_ptr<ov::Node> weights_node =
+        GetDecompressedWeights(created.core->getModel());
+    ASSERT_NE(weights_node, nullptr);
+    EXPECT_EQ(ov::element::f16, weights_node->get_output_element_type(0));
+    EXPECT_TRUE(ov::is_keep_const_precision(weights_node));
+    // Only the weights count, at their f16 size.
+    EXPECT_EQ(static_cast<int64_t>(weights.size()),
+              created.core->getWeightStats().resident_weight_bytes);
+    EXPECT_EQ(static_cast<int64_t>(2 * weights.size()),
+              created.core->getWeightStats().f32_weight_bytes);
+    // Writes the cache entry the next round imports.
+    EXPECT_EQ(kTfLiteOk, created.core->CompileAndInfer());
+  }
+}
+
 }  // namespace openvinodelegate
 }  // namespace tflite
 
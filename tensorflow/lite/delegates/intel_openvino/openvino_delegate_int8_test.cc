@@ -0,0 +1,285 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "tensorflow/lite/delegates/intel_openvino/openvino_delegate.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_test_model_builder.h"
+#include "tensorflow/lite/delegates/utils/simple_opaque_delegate.h"
+#include "tensorflow/lite/interpreter.h"
+#include "tensorflow/lite/kernels/register_ref.h"
+#include "tensorflow/lite/model_builder.h"
+
+/* End-to-end tests of full-integer quantized models against TfLite's
+ * reference kernels */
+
+namespace tflite {
+namespace openvinodelegate {
+namespace {
+
+constexpr int kLatencyIterations = 50;
+
+// float -> QUANTIZE -> ADD -> LOGISTIC -> DEQUANTIZE -> float, with both ADD
+// inputs quantized per tensor to int8.
+std::vector<char> BuildQuantizedAddLogisticModel() {
+  TestModelBuilder builder;
+  const std::vector<int32_t> shape = {1, 8, 8, 16};
+  const int input0 = builder.AddTensor(shape, TensorType_FLOAT32);
+  const int input1 = builder.AddTensor(shape, TensorType_FLOAT32);
+  const int quantized0 =
+      builder.AddTensor(shape, TensorType_INT8, {{0.05f}, {0}});
+  const int quantized1 =
+      builder.AddTensor(shape, TensorType_INT8, {{0.04f}, {-3}});
+  const int sum = builder.AddTensor(shape, TensorType_INT8, {{0.1f}, {2}});
+  // TfLite requires this output quantization for int8 LOGISTIC.
+  const int logistic =
+      builder.AddTensor(shape, TensorType_INT8, {{1.0f / 256}, {-128}});
+  const int output = builder.AddTensor(shape, TensorType_FLOAT32);
+
+  builder.AddOperator(BuiltinOperator_QUANTIZE, {input0}, {quantized0});
+  builder.AddOperator(BuiltinOperator_QUANTIZE, {input1}, {quantized1});
+  builder.AddOperator(
+      BuiltinOperator_ADD, {quantized0, quantized1}, {sum},
+      BuiltinOptions_AddOptions,
+      CreateAddOptions(builder.builder(), ActivationFunctionType_NONE).Union());
+  builder.AddOperator(BuiltinOperator_LOGISTIC, {sum}, {logistic});
+  builder.AddOperator(BuiltinOperator_DEQUANTIZE, {logistic}, {output});
+  return builder.Finish({input0, input1}, {output});
+}
+
+// Per-channel int8 filter with |channels| scales along |axis|, values drawn
+// from [-127, 127], and the matching zero-point int32 bias whose scale is
+// input_scale * filter_scale.
+struct Int8Filter {
+  TestQuantization quantization;
+  std::vector<uint8_t> data;
+  TestQuantization bias_quantization;
+  std::vector<uint8_t> bias;
+};
+
+Int8Filter MakeInt8Filter(int elements, int channels, int axis,
+                          float input_scale, float max_weight,
+                          std::mt19937 *generator) {
+  std::uniform_int_distribution<int> weight(-127, 127);
+  std::uniform_int_distribution<int32_t> bias(-200, 200);
+  Int8Filter filter;
+  filter.quantization.quantized_dimension = axis;
+  for (int c = 0; c < channels; c++) {
+    // Vary the range per channel so the per-channel scales matter.
+    const float scale = max_weight * (c + 1) / channels / 127;
+    filter.quantization.scale.push_back(scale);
+    filter.quantization.zero_point.push_back(0);
+    filter.bias_quantization.scale.push_back(input_scale * scale);
+    filter.bias_quantization.zero_point.push_back(0);
+    const int32_t value = bias(*generator);
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&value);
+    filter.bias.insert(filter.bias.end(), bytes, bytes + sizeof(value));
+  }
+  for (int i = 0; i < elements; i++)
+    filter.data.push_back(static_cast<uint8_t>(weight(*generator)));
+  return filter;
+}
+
+// int8 -> CONV_2D -> DEPTHWISE_CONV_2D -> int8, with no QUANTIZE or
+// DEQUANTIZE: the partition's own inputs and outputs are int8.
+std::vector<char> BuildInt8ConvModel() {
+  TestModelBuilder builder;
+  std::mt19937 generator(7);
+  const int channels_in = 4;
+  const int channels = 8;
+  const std::vector<int32_t> input_shape = {1, 8, 8, channels_in};
+  const std::vector<int32_t> output_shape = {1, 8, 8, channels};
+  const float input_scale = 0.05f;
+  const float conv_scale = 0.1f;
+
+  const Int8Filter conv_filter = MakeInt8Filter(
+      channels * 3 * 3 * channels_in, channels, 0, input_scale,
+      /*max_weight=*/0.5f, &generator);
+  // Depthwise weights stay below 1/9 so a one-step difference in the conv
+  // output moves the depthwise output by less than one step.
+  const Int8Filter depthwise_filter =
+      MakeInt8Filter(3 * 3 * channels, channels, 3, conv_scale,
+                     /*max_weight=*/0.1f, &generator);
+
+  const int input =
+      builder.AddTensor(input_shape, TensorType_INT8, {{input_scale}, {-1}});
+  const int conv_weights =
+      builder.AddTensor({channels, 3, 3, channels_in}, TensorType_INT8,
+                        conv_filter.quantization, conv_filter.data);
+  const int conv_bias =
+      builder.AddTensor({channels}, TensorType_INT32,
+                        conv_filter.bias_quantization, conv_filter.bias);
+  const int conv =
+      builder.AddTensor(output_shape, TensorType_INT8, {{conv_scale}, {2}});
+  const int depthwise_weights =
+      builder.AddTensor({1, 3, 3, channels}, TensorType_INT8,
+                        depthwise_filter.quantization, depthwise_filter.data);
+  const int depthwise_bias =
+      builder.AddTensor({channels}, TensorType_INT32,
+                        depthwise_filter.bias_quantization,
+                        depthwise_filter.bias);
+  const int output =
+      builder.AddTensor(output_shape, TensorType_INT8, {{0.1f}, {0}});
+
+  builder.AddOperator(
+      BuiltinOperator_CONV_2D, {input, conv_weights, conv_bias}, {conv},
+      BuiltinOptions_Conv2DOptions,
+      CreateConv2DOptions(builder.builder(), Padding_SAME, 1, 1,
+                          ActivationFunctionType_NONE)
+          .Union());
+  builder.AddOperator(
+      BuiltinOperator_DEPTHWISE_CONV_2D,
+      {conv, depthwise_weights, depthwise_bias}, {output},
+      BuiltinOptions_DepthwiseConv2DOptions,
+      CreateDepthwiseConv2DOptions(builder.builder(), Padding_SAME, 1, 1,
+                                   /*depth_multiplier=*/1,
+                                   ActivationFunctionType_NONE)
+          .Union());
+  return builder.Finish({input}, {output});
+}
+
+class OpenVINODelegateInt8Test : public testing::Test {
+ protected:
+  void SetUp() override {
+    model_data_ = BuildQuantizedAddLogisticModel();
+    model_ = FlatBufferModel::BuildFromBuffer(model_data_.data(),
+                                              model_data_.size());
+    ASSERT_NE(model_, nullptr);
+  }
+
+  std::unique_ptr<Interpreter> BuildInterpreter(
+      TfLiteOpaqueDelegate *delegate) {
+    return openvinodelegate::BuildInterpreter(
+        *model_, ops::builtin::BuiltinRefOpResolver(), delegate);
+  }
+
+  void FillInputs(Interpreter *interpreter) {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> distribution(-4.0f, 4.0f);
+    for (int input : interpreter->inputs()) {
+      float *data = interpreter->typed_tensor<float>(input);
+      const int size = interpreter->tensor(input)->bytes / sizeof(float);
+      for (int i = 0; i < size; i++) data[i] = distribution(generator);
+    }
+  }
+
+  double AverageInvokeMs(Interpreter *interpreter) {
+    EXPECT_EQ(kTfLiteOk, interpreter->Invoke());
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kLatencyIterations; i++)
+      EXPECT_EQ(kTfLiteOk, interpreter->Invoke());
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - start)
+               .count() /
+           kLatencyIterations;
+  }
+
+  std::vector<char> model_data_;
+  std::unique_ptr<FlatBufferModel> model_;
+};
+
+TEST_F(OpenVINODelegateInt8Test, DelegatesWholeQuantizedGraph) {
+  TfLiteOpenVINODelegateOptions options;
+  TfLiteOpaqueDelegateUniquePtr delegate = CreateOpenVINODelegate(options);
+  std::unique_ptr<Interpreter> interpreter = BuildInterpreter(delegate.get());
+  ASSERT_NE(interpreter, nullptr);
+  // All five nodes are replaced by a single delegate kernel.
+  EXPECT_EQ(1, interpreter->execution_plan().size());
+}
+
+TEST_F(OpenVINODelegateInt8Test, MatchesReferenceKernels) {
+  std::unique_ptr<Interpreter> reference = BuildInterpreter(nullptr);
+  ASSERT_NE(reference, nullptr);
+
+  TfLiteOpenVINODelegateOptions options;
+  TfLiteOpaqueDelegateUniquePtr delegate = CreateOpenVINODelegate(options);
+  std::unique_ptr<Interpreter> delegated = BuildInterpreter(delegate.get());
+  ASSERT_NE(delegated, nullptr);
+
+  FillInputs(reference.get());
+  FillInputs(delegated.get());
+  ASSERT_EQ(kTfLiteOk, reference->Invoke());
+  ASSERT_EQ(kTfLiteOk, delegated->Invoke());
+
+  const TfLiteTensor *expected = reference->output_tensor(0);
+  const TfLiteTensor *actual = delegated->output_tensor(0);
+  ASSERT_EQ(expected->bytes, actual->bytes);
+  const int size = expected->bytes / sizeof(float);
+  // Rounding may differ by one step of the int8 LOGISTIC output.
+  const float tolerance = 1.0f / 256;
+  for (int i = 0; i < size; i++) {
+    EXPECT_NEAR(expected->data.f[i], actual->data.f[i], tolerance)
+        << "at index " << i;
+  }
+
+  const double reference_ms = AverageInvokeMs(reference.get());
+  const double delegated_ms = AverageInvokeMs(delegated.get());
+  std::cout << "int8 reference kernels: " << reference_ms
+            << " ms, OpenVINO delegate: " << delegated_ms << " ms\n";
+  RecordProperty("reference_ms", std::to_string(reference_ms));
+  RecordProperty("openvino_ms", std::to_string(delegated_ms));
+}
+
+TEST_F(OpenVINODelegateInt8Test, Int8ConvInInt8Out) {
+  model_data_ = BuildInt8ConvModel();
+  model_ = FlatBufferModel::BuildFromBuffer(model_data_.data(),
+                                            model_data_.size());
+  ASSERT_NE(model_, nullptr);
+  std::unique_ptr<Interpreter> reference = BuildInterpreter(nullptr);
+  ASSERT_NE(reference, nullptr);
+
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<int> distribution(-128, 127);
+  const size_t input_size = reference->input_tensor(0)->bytes;
+  for (size_t i = 0; i < input_size; i++)
+    reference->typed_input_tensor<int8_t>(0)[i] =
+        static_cast<int8_t>(distribution(generator));
+  ASSERT_EQ(kTfLiteOk, reference->Invoke());
+  const TfLiteTensor *expected = reference->output_tensor(0);
+
+  // The graph builder converts in float, so it must hand the quantized
+  // partition back to the frontend rather than compute on raw int8 values.
+  for (const char *backend : {"frontend", "graph_builder"}) {
+    SCOPED_TRACE(backend);
+    TfLiteOpenVINODelegateOptions options;
+    options.conversion_backend = backend;
+    TfLiteOpaqueDelegateUniquePtr delegate = CreateOpenVINODelegate(options);
+    std::unique_ptr<Interpreter> delegated = BuildInterpreter(delegate.get());
+    ASSERT_NE(delegated, nullptr);
+    EXPECT_EQ(1u, delegated->execution_plan().size());
+    ASSERT_EQ(kTfLiteInt8, delegated->input_tensor(0)->type);
+    ASSERT_EQ(kTfLiteInt8, delegated->output_tensor(0)->type);
+
+    for (size_t i = 0; i < input_size; i++)
+      delegated->typed_input_tensor<int8_t>(0)[i] =
+          reference->typed_input_tensor<int8_t>(0)[i];
+    ASSERT_EQ(kTfLiteOk, delegated->Invoke());
+
+    const TfLiteTensor *actual = delegated->output_tensor(0);
+    ASSERT_EQ(expected->bytes, actual->bytes);
+    // Each of the two requantizations may round one step differently.
+    for (size_t i = 0; i < expected->bytes; i++) {
+      EXPECT_NEAR(expected->data.int8[i], actual->data.int8[i], 2)
+          << "at index " << i;
+    }
+  }
+}
+
+}  // namespace
+}  // namespace openvinodelegate
+}  // namespace tflite
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
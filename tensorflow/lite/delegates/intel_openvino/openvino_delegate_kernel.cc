@@ -7,8 +7,12 @@
 
 #include <openvino/runtime/core.hpp>
 
+#include <chrono>
+#include <future>
 #include <vector>
 
+#include "tensorflow/lite/delegates/intel_openvino/openvino_partition_compiler.h"
+
 // #include "tensorflow/lite/delegates/intel_openvino/log.h"
 
 namespace tflite {
@@ -16,26 +20,116 @@ namespace openvinodelegate {
 
 TfLiteStatus OpenVINODelegateKernel::Init(
     TfLiteOpaqueContext *context, const TfLiteOpaqueDelegateParams *params) {
-  TfLiteStatus init_status = ov_delegate_core_->Init();
+  ScopedTrace trace(tracer_.get(), "KernelInit", kTraceStartup,
+                    partition_index_);
+  if (options_.enable_profiling)
+    layer_profiler_ = std::make_unique<LayerProfiler>(context, params);
+
+  // The delegate converted all partitions when it was initialized and
+  // compiles them in the background; only wait for ours here. A job that
+  // failed is not retried: it would repeat the same conversion, calibration
+  // and tuning only to fail again.
+  if (partition_compiler_ != nullptr) {
+    std::shared_ptr<PartitionCompileJob> job =
+        partition_compiler_->TakeJob(params);
+    if (job != nullptr) {
+      if (job->converted != kTfLiteOk) return job->converted;
+#ifndef OPENVINO_DELEGATE_STABLE_ABI
+      if (options_.async_compilation) {
+        auto fallback_executor = std::make_unique<FallbackExecutor>();
+        if (fallback_executor->Init(context, params) == kTfLiteOk) {
+          fallback_executor_ = std::move(fallback_executor);
+          pending_job_ = std::move(job);
+          return kTfLiteOk;
+        }
+      }
+#endif
+      const TfLiteStatus compiled = job->compiled.get();
+      if (compiled != kTfLiteOk) return compiled;
+      ov_delegate_core_ = std::move(job->core);
+      UpdateBuildMetrics();
+      return kTfLiteOk;
+    }
+  }
+
+  if (partition_compiler_ != nullptr) {
+    ov_delegate_core_ = std::make_unique<OpenVINODelegateCore>(
+        partition_compiler_->GetSharedCore(options_.plugins_path),
+        partition_index_);
+  } else {
+    ScopedTrace trace(tracer_.get(), "CreateOVCore", kTraceStartup,
+                      partition_index_);
+    ov_delegate_core_ = std::make_unique<OpenVINODelegateCore>(
+        options_.plugins_path, partition_index_);
+  }
+  ov_delegate_core_->SetTracer(tracer_);
+  TfLiteStatus init_status = ov_delegate_core_->Init(options_.device_type);
   if (init_status != kTfLiteOk) return init_status;
 
   TfLiteStatus set_status = ov_delegate_core_->CreateModel(context, params, &options_);
-  if (set_status != kTfLiteOk) return init_status;
+  if (set_status != kTfLiteOk) return set_status;
 
   set_status = ov_delegate_core_->CompileAndInfer();
-  if (set_status != kTfLiteOk) return init_status;
+  if (set_status != kTfLiteOk) return set_status;
 
+  UpdateBuildMetrics();
   return kTfLiteOk;
 }
 
+void OpenVINODelegateKernel::UpdateBuildMetrics() {
+  if (metrics_ != nullptr && ov_delegate_core_ != nullptr)
+    metrics_->SetBuildStats(*ov_delegate_core_);
+}
+
+bool OpenVINODelegateKernel::CompiledModelReady() {
+  if (pending_job_ == nullptr) return ov_delegate_core_ != nullptr;
+  if (pending_job_->compiled.wait_for(std::chrono::seconds(0)) !=
+      std::future_status::ready)
+    return false;
+  if (pending_job_->compiled.get() == kTfLiteOk) {
+    ov_delegate_core_ = std::move(pending_job_->core);
+#ifndef OPENVINO_DELEGATE_STABLE_ABI
+    fallback_executor_.reset();
+#endif
+    UpdateBuildMetrics();
+  }
+  // If compilation failed the partition keeps running on the fallback.
+  pending_job_.reset();
+  return ov_delegate_core_ != nullptr;
+}
+
 TfLiteStatus OpenVINODelegateKernel::Prepare(TfLiteOpaqueContext *context,
                                              TfLiteOpaqueNode *node) {
   // TFLITE_LOG(INFO) << "inside Prepare";
+#ifndef OPENVINO_DELEGATE_STABLE_ABI
+  if (!CompiledModelReady() && fallback_executor_ != nullptr)
+    return fallback_executor_->Prepare(context);
+#endif
   return kTfLiteOk;
 }
 
 TfLiteStatus OpenVINODelegateKernel::Eval(TfLiteOpaqueContext *context,
                                           TfLiteOpaqueNode *node) {
+  if (!CompiledModelReady()) {
+#ifndef OPENVINO_DELEGATE_STABLE_ABI
+    if (fallback_executor_ == nullptr) return kTfLiteError;
+    ScopedTrace trace(tracer_.get(), "FallbackEval", kTraceEval,
+                      partition_index_);
+    if (metrics_ != nullptr) metrics_->RecordFallbackEval();
+    return fallback_executor_->Eval(context);
+#else
+    return kTfLiteError;
+#endif
+  }
+  ScopedTrace trace(tracer_.get(), "Eval", kTraceEval, partition_index_);
+  if (ov_delegate_core_->SwapInOptimizedModel()) UpdateBuildMetrics();
+
+  using Clock = std::chrono::steady_clock;
+  auto micros = [](Clock::time_point start, Clock::time_point end) {
+    return std::chrono::duration<double, std::micro>(end - start).count();
+  };
+  const Clock::time_point input_copy_start = Clock::now();
+  uint64_t input_bytes = 0;
   std::vector<int> compute_inputs = ov_delegate_core_->getComputeInputs();
   for (int i = 0; i < compute_inputs.size(); i++) {
     int t = compute_inputs[i];
@@ -49,15 +143,25 @@ TfLiteStatus OpenVINODelegateKernel::Eval(TfLiteOpaqueContext *context,
     void *src = TfLiteOpaqueTensorData(opaque_input_tensor);
 
     std::memcpy(dest, src, len);
+    input_bytes += len;
   }
 
+  const Clock::time_point infer_start = Clock::now();
   ov_delegate_core_->getInferRequest().start_async();
+  const Clock::time_point wait_start = Clock::now();
   if (!ov_delegate_core_->getInferRequest().wait_for(
           std::chrono::milliseconds(10000))) {
     // TFLITE_LOG(ERROR) << "Infer request failed";
     return kTfLiteError;
   }
+  const Clock::time_point infer_end = Clock::now();
+  if (layer_profiler_ != nullptr) {
+    ov::InferRequest infer_request = ov_delegate_core_->getInferRequest();
+    layer_profiler_->Record(context, infer_request);
+  }
 
+  const Clock::time_point output_copy_start = Clock::now();
+  uint64_t output_bytes = 0;
   std::vector<int> outputs = ov_delegate_core_->getOutputs();
   for (int o = 0; o < outputs.size(); o++) {
     int t = outputs[o];
@@ -69,8 +173,29 @@ TfLiteStatus OpenVINODelegateKernel::Eval(TfLiteOpaqueContext *context,
     void *src = outputBlob.data();
     auto len = TfLiteOpaqueTensorByteSize(opaque_output_tensor);
     std::memcpy(dest, src, len);
+    output_bytes += len;
   }
 
+  const Clock::time_point output_copy_end = Clock::now();
+  if (ov_delegate_core_->RecordFirstInferMemory()) UpdateBuildMetrics();
+  if (metrics_ != nullptr) {
+    metrics_->RecordEval(micros(input_copy_start, infer_start),
+                         micros(infer_start, infer_end),
+                         micros(wait_start, infer_end),
+                         micros(output_copy_start, output_copy_end),
+                         input_bytes, output_bytes);
+  }
+  // The phases reuse the clock reads taken for the metrics.
+  if (tracer_ != nullptr) {
+    tracer_->AddEvent("InputCopy", kTraceEval, partition_index_,
+                      input_copy_start, infer_start);
+    tracer_->AddEvent("StartAsync", kTraceEval, partition_index_, infer_start,
+                      wait_start);
+    tracer_->AddEvent("Wait", kTraceEval, partition_index_, wait_start,
+                      infer_end);
+    tracer_->AddEvent("OutputCopy", kTraceEval, partition_index_,
+                      output_copy_start, output_copy_end);
+  }
   return kTfLiteOk;
 }
 
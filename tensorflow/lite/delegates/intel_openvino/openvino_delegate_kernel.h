@@ -9,18 +9,38 @@
 #include <openvino/openvino.hpp>
 
 #include <memory>
+#include <utility>
 
 #include "tensorflow/lite/delegates/intel_openvino/openvino_delegate.h"
 #include "tensorflow/lite/delegates/intel_openvino/openvino_delegate_core.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_delegate_metrics.h"
+#ifndef OPENVINO_DELEGATE_STABLE_ABI
+#include "tensorflow/lite/delegates/intel_openvino/openvino_fallback_executor.h"
+#endif
+#include "tensorflow/lite/delegates/intel_openvino/openvino_layer_profiler.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_tracer.h"
 #include "tensorflow/lite/delegates/utils/simple_opaque_delegate.h"
 
 namespace tflite {
 namespace openvinodelegate {
+class PartitionCompiler;
+struct PartitionCompileJob;
+
 class OpenVINODelegateKernel : public SimpleOpaqueDelegateKernelInterface {
  public:
-  OpenVINODelegateKernel(TfLiteOpenVINODelegateOptions options)
-      : ov_delegate_core_(std::make_unique<OpenVINODelegateCore>(
-            "/etc/openvino/plugins.xml")) {
+  // |partition_compiler| may hold the partition already compiled in the
+  // background; it is owned by the delegate and may be null. |metrics| is
+  // shared with the delegate, which reports it; it may be null as well, like
+  // |tracer|.
+  OpenVINODelegateKernel(TfLiteOpenVINODelegateOptions options,
+                         int partition_index,
+                         PartitionCompiler *partition_compiler,
+                         std::shared_ptr<PartitionMetrics> metrics = nullptr,
+                         std::shared_ptr<Tracer> tracer = nullptr)
+      : partition_index_(partition_index),
+        partition_compiler_(partition_compiler),
+        metrics_(std::move(metrics)),
+        tracer_(std::move(tracer)) {
     options_ = options;
   }
 
@@ -34,8 +54,25 @@ class OpenVINODelegateKernel : public SimpleOpaqueDelegateKernelInterface {
                     TfLiteOpaqueNode *node) override;
 
  private:
+  // Picks up the model compiled in the background once it is ready. Returns
+  // false while Evals still have to go through the fallback kernels.
+  bool CompiledModelReady();
+  // Publishes the startup stats of ov_delegate_core_ to metrics_.
+  void UpdateBuildMetrics();
+
   std::unique_ptr<OpenVINODelegateCore> ov_delegate_core_;
+  // Set while the partition compiles in the background.
+  std::shared_ptr<PartitionCompileJob> pending_job_;
+#ifndef OPENVINO_DELEGATE_STABLE_ABI
+  std::unique_ptr<FallbackExecutor> fallback_executor_;
+#endif
+  // Set when options_.enable_profiling is.
+  std::unique_ptr<LayerProfiler> layer_profiler_;
   TfLiteOpenVINODelegateOptions options_;
+  int partition_index_;
+  PartitionCompiler *partition_compiler_;
+  std::shared_ptr<PartitionMetrics> metrics_;
+  std::shared_ptr<Tracer> tracer_;
 };
 
 }  // namespace openvinodelegate
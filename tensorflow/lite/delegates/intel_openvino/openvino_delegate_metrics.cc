@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "tensorflow/lite/delegates/intel_openvino/openvino_delegate_metrics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <string>
+
+#include "tensorflow/lite/delegates/intel_openvino/openvino_delegate_core.h"
+
+namespace tflite {
+namespace openvinodelegate {
+
+namespace {
+
+TfLiteOpenVINOPhaseMemory ToPhaseMemory(const PhaseMemory &memory) {
+  return {memory.rss_bytes, memory.delegate_bytes};
+}
+
+}  // namespace
+
+ProcessMemory ReadProcessMemory() {
+  ProcessMemory memory;
+  std::ifstream status("/proc/self/status");
+  std::string key;
+  int64_t kilobytes;
+  while (status >> key) {
+    if (key == "VmRSS:" && status >> kilobytes) {
+      memory.rss_bytes = kilobytes * 1024;
+    } else if (key == "VmHWM:" && status >> kilobytes) {
+      memory.peak_rss_bytes = kilobytes * 1024;
+    }
+  }
+  return memory;
+}
+
+void LatencyHistogram::Record(double latency_us) {
+  int bucket = 0;
+  if (latency_us >= 1) {
+    bucket = 1 + static_cast<int>(std::log2(latency_us) * kBucketsPerOctave);
+    bucket = std::min(bucket, kNumBuckets - 1);
+  }
+  buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+  const uint64_t latency_ns = static_cast<uint64_t>(latency_us * 1000);
+  sum_ns_.fetch_add(latency_ns, std::memory_order_relaxed);
+  uint64_t max_ns = max_ns_.load(std::memory_order_relaxed);
+  while (latency_ns > max_ns &&
+         !max_ns_.compare_exchange_weak(max_ns, latency_ns,
+                                        std::memory_order_relaxed)) {
+  }
+}
+
+TfLiteOpenVINOLatencySummary LatencyHistogram::Summarize() const {
+  TfLiteOpenVINOLatencySummary summary = {0, -1, -1, -1, -1};
+  std::array<uint64_t, kNumBuckets> buckets;
+  uint64_t count = 0;
+  for (int i = 0; i < kNumBuckets; i++) {
+    buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+    count += buckets[i];
+  }
+  if (count == 0) return summary;
+  summary.count = count;
+  summary.mean_us = sum_ns_.load(std::memory_order_relaxed) / 1000.0 / count;
+  summary.max_us = max_ns_.load(std::memory_order_relaxed) / 1000.0;
+
+  // Upper bound of the bucket holding the percentile, capped by the max.
+  auto percentile = [&](double fraction) {
+    const uint64_t rank = std::max<uint64_t>(1, std::ceil(fraction * count));
+    uint64_t seen = 0;
+    for (int i = 0; i < kNumBuckets; i++) {
+      seen += buckets[i];
+      if (seen >= rank) {
+        const double upper_us =
+            std::exp2(static_cast<double>(i) / kBucketsPerOctave);
+        return std::min(upper_us, summary.max_us);
+      }
+    }
+    return summary.max_us;
+  };
+  summary.p50_us = percentile(0.5);
+  summary.p99_us = percentile(0.99);
+  return summary;
+}
+
+PartitionMetrics::PartitionMetrics(int partition_index) : build_() {
+  build_.partition_index = partition_index;
+  build_.plugin_init_ms = -1;
+  build_.convert_ms = -1;
+  build_.graph_builder = -1;
+  build_.compile_ms = -1;
+  build_.cache_hit = -1;
+  build_.cache_import_ms = -1;
+  build_.cache_export_ms = -1;
+  build_.time_to_first_inference_ms = -1;
+  build_.time_to_peak_throughput_ms = -1;
+  build_.warm_latency_ms = -1;
+  const TfLiteOpenVINOPhaseMemory not_run = {-1, -1};
+  build_.graph_iteration_memory = not_run;
+  build_.convert_memory = not_run;
+  build_.cache_import_memory = not_run;
+  build_.serialize_memory = not_run;
+  build_.compile_memory = not_run;
+  build_.first_infer_memory = not_run;
+  build_.peak_rss_bytes = -1;
+  build_.compiled_model_bytes = -1;
+  build_.duplicated_constant_bytes = -1;
+}
+
+void PartitionMetrics::SetBuildStats(const OpenVINODelegateCore &core) {
+  const BuildStats &build = core.getBuildStats();
+  std::lock_guard<std::mutex> lock(build_mutex_);
+  const PluginInitStats &plugin_init = core.getPluginInitStats();
+  build_.plugin_init_ms =
+      plugin_init.device_init_ms < 0
+          ? -1
+          : plugin_init.core_create_ms + plugin_init.device_init_ms;
+  build_.convert_ms = build.convert_ms;
+  switch (build.conversion) {
+    case BuildStats::Conversion::kGraphBuilder:
+      build_.graph_builder = 1;
+      break;
+    case BuildStats::Conversion::kFrontend:
+      build_.graph_builder = 0;
+      break;
+    case BuildStats::Conversion::kNone:
+      build_.graph_builder = -1;
+      break;
+  }
+  build_.compile_ms = build.compile_ms;
+  switch (build.cache_result) {
+    case BuildStats::CacheResult::kHit:
+      build_.cache_hit = 1;
+      break;
+    case BuildStats::CacheResult::kMiss:
+      build_.cache_hit = 0;
+      break;
+    case BuildStats::CacheResult::kDisabled:
+      build_.cache_hit = -1;
+      break;
+  }
+  build_.cache_import_ms = build.cache_import_ms;
+  build_.cache_export_ms = build.cache_export_ms;
+  build_.time_to_first_inference_ms =
+      core.getCompileTierStats().time_to_first_inference_ms;
+  build_.time_to_peak_throughput_ms =
+      core.getCompileTierStats().time_to_peak_throughput_ms;
+  build_.warm_latency_ms = core.getWarmupStats().warm_latency_ms;
+  build_.resident_weight_bytes = core.getWeightStats().resident_weight_bytes;
+  const MemoryStats &memory = core.getMemoryStats();
+  build_.graph_iteration_memory = ToPhaseMemory(memory.graph_iteration);
+  build_.convert_memory = ToPhaseMemory(memory.convert);
+  build_.cache_import_memory = ToPhaseMemory(memory.cache_import);
+  build_.serialize_memory = ToPhaseMemory(memory.serialize);
+  build_.compile_memory = ToPhaseMemory(memory.compile);
+  build_.first_infer_memory = ToPhaseMemory(memory.first_infer);
+  build_.peak_rss_bytes = memory.peak_rss_bytes;
+  build_.compiled_model_bytes = memory.compiled_model_bytes;
+  build_.duplicated_constant_bytes = memory.duplicated_constant_bytes;
+}
+
+void PartitionMetrics::RecordEval(double input_copy_us, double infer_us,
+                                  double infer_wait_us, double output_copy_us,
+                                  uint64_t input_bytes,
+                                  uint64_t output_bytes) {
+  evals_.fetch_add(1, std::memory_order_relaxed);
+  input_bytes_.fetch_add(input_bytes, std::memory_order_relaxed);
+  output_bytes_.fetch_add(output_bytes, std::memory_order_relaxed);
+  input_copy_.Record(input_copy_us);
+  infer_.Record(infer_us);
+  infer_wait_.Record(infer_wait_us);
+  output_copy_.Record(output_copy_us);
+}
+
+TfLiteOpenVINOPartitionMetrics PartitionMetrics::Snapshot() const {
+  TfLiteOpenVINOPartitionMetrics metrics;
+  {
+    std::lock_guard<std::mutex> lock(build_mutex_);
+    metrics = build_;
+  }
+  metrics.evals = evals_.load(std::memory_order_relaxed);
+  metrics.fallback_evals = fallback_evals_.load(std::memory_order_relaxed);
+  metrics.input_bytes_copied = input_bytes_.load(std::memory_order_relaxed);
+  metrics.output_bytes_copied = output_bytes_.load(std::memory_order_relaxed);
+  metrics.input_copy = input_copy_.Summarize();
+  metrics.infer = infer_.Summarize();
+  metrics.infer_wait = infer_wait_.Summarize();
+  metrics.output_copy = output_copy_.Summarize();
+  return metrics;
+}
+
+}  // namespace openvinodelegate
+}  // namespace tflite
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef DELEGATE_INTEL_OPENVINO_OPENVINO_DELEGATE_METRICS_H_
+#define DELEGATE_INTEL_OPENVINO_OPENVINO_DELEGATE_METRICS_H_
+
+#include <stdint.h>
+
+#include "tensorflow/lite/c/common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+// Runtime metrics of the OpenVINO delegate. Durations that were not measured
+// (yet) are -1.
+
+typedef struct {
+  uint64_t count;
+  double mean_us;
+  double p50_us;
+  double p99_us;
+  double max_us;
+} TfLiteOpenVINOLatencySummary;
+
+typedef struct {
+  // Resident set size of the process after the phase.
+  int64_t rss_bytes;
+  // Memory the delegate holds for the partition after the phase.
+  int64_t delegate_bytes;
+} TfLiteOpenVINOPhaseMemory;
+
+typedef struct {
+  int partition_index;
+  // Startup.
+  double plugin_init_ms;
+  double convert_ms;
+  // 1 if the partition was converted by the direct graph builder, 0 if by
+  // the TfLite frontend, -1 if it was not converted (cache hit).
+  int graph_builder;
+  double compile_ms;
+  // 1 if the partition was imported from cache_dir, 0 if it was converted
+  // although caching was enabled, -1 if caching is disabled.
+  int cache_hit;
+  double cache_import_ms;
+  double cache_export_ms;
+  double time_to_first_inference_ms;
+  double time_to_peak_throughput_ms;
+  double warm_latency_ms;
+  int64_t resident_weight_bytes;
+  // Per Eval. Evals served by the TfLite fallback kernels while the
+  // partition was still compiling are only counted.
+  uint64_t evals;
+  uint64_t fallback_evals;
+  uint64_t input_bytes_copied;
+  uint64_t output_bytes_copied;
+  TfLiteOpenVINOLatencySummary input_copy;
+  // start_async to completion; |infer_wait| is the part spent in wait_for.
+  TfLiteOpenVINOLatencySummary infer;
+  TfLiteOpenVINOLatencySummary infer_wait;
+  TfLiteOpenVINOLatencySummary output_copy;
+  // Memory after each startup phase. RSS is process-wide: partitions
+  // compiled concurrently show up in each other's numbers.
+  TfLiteOpenVINOPhaseMemory graph_iteration_memory;
+  TfLiteOpenVINOPhaseMemory convert_memory;
+  TfLiteOpenVINOPhaseMemory cache_import_memory;
+  TfLiteOpenVINOPhaseMemory serialize_memory;
+  TfLiteOpenVINOPhaseMemory compile_memory;
+  TfLiteOpenVINOPhaseMemory first_infer_memory;
+  // Process high-water mark at the last of these phases.
+  int64_t peak_rss_bytes;
+  // RSS growth over compile_model and infer request creation. An upper
+  // bound when other partitions or tiers compiled at the same time.
+  int64_t compiled_model_bytes;
+  // Constants of the OpenVINO model that copy TfLite's read-only tensors
+  // instead of pointing into them.
+  int64_t duplicated_constant_bytes;
+} TfLiteOpenVINOPartitionMetrics;
+
+typedef struct {
+  // Delegate Initialize: partitioning and conversion of all partitions.
+  double init_ms;
+  int num_partitions;
+  int cache_hits;
+  int cache_misses;
+  uint64_t evals;
+  uint64_t bytes_copied;
+  // Process high-water mark when the metrics were taken.
+  int64_t peak_rss_bytes;
+} TfLiteOpenVINODelegateMetrics;
+
+// |delegate| must have been created from an OpenVINODelegate through
+// TfLiteOpaqueDelegateFactory.
+TfLiteStatus TfLiteOpenVINODelegateGetMetrics(
+    TfLiteOpaqueDelegate *delegate, TfLiteOpenVINODelegateMetrics *metrics);
+
+// |partition_index| counts the delegate kernels in creation order.
+TfLiteStatus TfLiteOpenVINODelegateGetPartitionMetrics(
+    TfLiteOpaqueDelegate *delegate, int partition_index,
+    TfLiteOpenVINOPartitionMetrics *metrics);
+
+#ifdef __cplusplus
+}  // extern "C"
+
+#include <array>
+#include <atomic>
+#include <mutex>
+
+namespace tflite {
+namespace openvinodelegate {
+
+class OpenVINODelegateCore;
+
+struct ProcessMemory {
+  int64_t rss_bytes = -1;
+  int64_t peak_rss_bytes = -1;
+};
+
+// Current and peak resident set size from /proc; -1 where unavailable.
+ProcessMemory ReadProcessMemory();
+
+// Lock-free latency histogram with four buckets per power of two between
+// 1 us and about a minute; percentiles are accurate to within 19%.
+class LatencyHistogram {
+ public:
+  void Record(double latency_us);
+  TfLiteOpenVINOLatencySummary Summarize() const;
+
+ private:
+  static constexpr int kBucketsPerOctave = 4;
+  static constexpr int kNumBuckets = 26 * kBucketsPerOctave + 1;
+
+  std::array<std::atomic<uint64_t>, kNumBuckets> buckets_{};
+  std::atomic<uint64_t> sum_ns_{0};
+  std::atomic<uint64_t> max_ns_{0};
+};
+
+// Metrics of one partition. Evals record with relaxed atomics only, so the
+// counters can stay on in production; snapshots may be taken from any
+// thread.
+class PartitionMetrics {
+ public:
+  explicit PartitionMetrics(int partition_index);
+
+  // Copies the startup stats of |core|; called again after the optimized
+  // tier was swapped in.
+  void SetBuildStats(const OpenVINODelegateCore &core);
+
+  void RecordEval(double input_copy_us, double infer_us, double infer_wait_us,
+                  double output_copy_us, uint64_t input_bytes,
+                  uint64_t output_bytes);
+  void RecordFallbackEval() {
+    fallback_evals_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  TfLiteOpenVINOPartitionMetrics Snapshot() const;
+
+ private:
+  mutable std::mutex build_mutex_;
+  TfLiteOpenVINOPartitionMetrics build_;
+  std::atomic<uint64_t> evals_{0};
+  std::atomic<uint64_t> fallback_evals_{0};
+  std::atomic<uint64_t> input_bytes_{0};
+  std::atomic<uint64_t> output_bytes_{0};
+  LatencyHistogram input_copy_;
+  LatencyHistogram infer_;
+  LatencyHistogram infer_wait_;
+  LatencyHistogram output_copy_;
+};
+
+}  // namespace openvinodelegate
+}  // namespace tflite
+
+#endif  // __cplusplus
+
+#endif  // DELEGATE_INTEL_OPENVINO_OPENVINO_DELEGATE_METRICS_H_
@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "tensorflow/lite/delegates/intel_openvino/openvino_delegate.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_delegate_metrics.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_test_model_builder.h"
+#include "tensorflow/lite/delegates/utils/simple_opaque_delegate.h"
+#include "tensorflow/lite/interpreter.h"
+#include "tensorflow/lite/model_builder.h"
+
+/* Runtime metrics reported through the delegate's C API */
+
+namespace tflite {
+namespace openvinodelegate {
+namespace {
+
+constexpr uint64_t kNumInvokes = 10;
+
+// 1x1 convolution whose 16 MB filter dwarfs its activations.
+constexpr int kChannels = 2048;
+constexpr int64_t kFilterBytes =
+    int64_t{kChannels} * kChannels * sizeof(float);
+
+std::vector<char> BuildLargeWeightModel() {
+  std::vector<float> filter(int64_t{kChannels} * kChannels);
+  for (size_t i = 0; i < filter.size(); i++) filter[i] = (i % 7) * 1e-3f;
+  const auto *filter_bytes = reinterpret_cast<const uint8_t *>(filter.data());
+  TestModelBuilder builder;
+  const int input =
+      builder.AddTensor({1, 1, 1, kChannels}, TensorType_FLOAT32);
+  const int weights = builder.AddTensor(
+      {kChannels, 1, 1, kChannels}, TensorType_FLOAT32, {},
+      std::vector<uint8_t>(filter_bytes, filter_bytes + kFilterBytes));
+  const int output =
+      builder.AddTensor({1, 1, 1, kChannels}, TensorType_FLOAT32);
+  builder.AddOperator(
+      BuiltinOperator_CONV_2D, {input, weights}, {output},
+      BuiltinOptions_Conv2DOptions,
+      CreateConv2DOptions(builder.builder(), Padding_VALID, 1, 1).Union());
+  return builder.Finish({input}, {output});
+}
+
+TEST(LatencyHistogramTest, SummarizesPercentiles) {
+  LatencyHistogram histogram;
+  EXPECT_EQ(0u, histogram.Summarize().count);
+  for (int i = 1; i <= 100; i++) histogram.Record(i * 10.0);
+
+  const TfLiteOpenVINOLatencySummary summary = histogram.Summarize();
+  EXPECT_EQ(100u, summary.count);
+  EXPECT_NEAR(505.0, summary.mean_us, 1e-3);
+  EXPECT_DOUBLE_EQ(1000.0, summary.max_us);
+  // Percentiles are bucket upper bounds, at most 19% above the true value.
+  EXPECT_GE(summary.p50_us, 500.0);
+  EXPECT_LE(summary.p50_us, 500.0 * 1.19);
+  EXPECT_GE(summary.p99_us, 990.0);
+  EXPECT_LE(summary.p99_us, summary.max_us);
+}
+
+TEST(OpenVINODelegateMetricsTest, CountsEvalsAndCopiedBytes) {
+  const std::vector<int32_t> shape = {1, 8, 8, 16};
+  const std::vector<char> model_data = BuildAddModel(shape);
+  std::unique_ptr<FlatBufferModel> model =
+      FlatBufferModel::BuildFromBuffer(model_data.data(), model_data.size());
+  ASSERT_NE(model, nullptr);
+
+  TfLiteOpenVINODelegateOptions options;
+  TfLiteOpaqueDelegateUniquePtr delegate = CreateOpenVINODelegate(options);
+  std::unique_ptr<Interpreter> interpreter =
+      BuildInterpreter(*model, delegate.get());
+  ASSERT_NE(interpreter, nullptr);
+  ASSERT_EQ(1, interpreter->execution_plan().size());
+  for (uint64_t i = 0; i < kNumInvokes; i++)
+    ASSERT_EQ(kTfLiteOk, interpreter->Invoke());
+
+  const uint64_t tensor_bytes = 1 * 8 * 8 * 16 * sizeof(float);
+  TfLiteOpenVINOPartitionMetrics partition;
+  ASSERT_EQ(kTfLiteOk, TfLiteOpenVINODelegateGetPartitionMetrics(
+                           delegate.get(), 0, &partition));
+  EXPECT_EQ(0, partition.partition_index);
+  EXPECT_EQ(-1, partition.cache_hit);
+  EXPECT_GT(partition.compile_ms, 0);
+  EXPECT_EQ(kNumInvokes, partition.evals + partition.fallback_evals);
+  EXPECT_EQ(partition.evals * 2 * tensor_bytes, partition.input_bytes_copied);
+  EXPECT_EQ(partition.evals * tensor_bytes, partition.output_bytes_copied);
+  EXPECT_EQ(partition.evals, partition.infer.count);
+  EXPECT_LE(partition.infer.p50_us, partition.infer.p99_us);
+  EXPECT_LE(partition.infer_wait.max_us, partition.infer.max_us);
+  EXPECT_EQ(kTfLiteError, TfLiteOpenVINODelegateGetPartitionMetrics(
+                              delegate.get(), 1, &partition));
+
+  TfLiteOpenVINODelegateMetrics metrics;
+  ASSERT_EQ(kTfLiteOk,
+            TfLiteOpenVINODelegateGetMetrics(delegate.get(), &metrics));
+  EXPECT_GE(metrics.init_ms, 0);
+  EXPECT_EQ(1, metrics.num_partitions);
+  EXPECT_EQ(0, metrics.cache_hits + metrics.cache_misses);
+  EXPECT_EQ(kNumInvokes, metrics.evals);
+  EXPECT_EQ(partition.input_bytes_copied + partition.output_bytes_copied,
+            metrics.bytes_copied);
+}
+
+TEST(OpenVINODelegateMetricsTest, LargeWeightMemoryFootprint) {
+  const std::vector<char> model_data = BuildLargeWeightModel();
+  std::unique_ptr<FlatBufferModel> model =
+      FlatBufferModel::BuildFromBuffer(model_data.data(), model_data.size());
+  ASSERT_NE(model, nullptr);
+
+  TfLiteOpenVINODelegateOptions options;
+  TfLiteOpaqueDelegateUniquePtr delegate = CreateOpenVINODelegate(options);
+  std::unique_ptr<Interpreter> interpreter =
+      BuildInterpreter(*model, delegate.get());
+  ASSERT_NE(interpreter, nullptr);
+  ASSERT_EQ(1, interpreter->execution_plan().size());
+  ASSERT_EQ(kTfLiteOk, interpreter->Invoke());
+
+  TfLiteOpenVINOPartitionMetrics partition;
+  ASSERT_EQ(kTfLiteOk, TfLiteOpenVINODelegateGetPartitionMetrics(
+                           delegate.get(), 0, &partition));
+  for (const TfLiteOpenVINOPhaseMemory &phase :
+       {partition.graph_iteration_memory, partition.convert_memory,
+        partition.compile_memory, partition.first_infer_memory}) {
+    EXPECT_GT(phase.rss_bytes, 0);
+    EXPECT_GE(phase.delegate_bytes, 0);
+    EXPECT_LE(phase.rss_bytes, partition.peak_rss_bytes);
+  }
+  // No cache_dir: nothing imported or serialized.
+  EXPECT_EQ(-1, partition.cache_import_memory.rss_bytes);
+  EXPECT_EQ(-1, partition.serialize_memory.rss_bytes);
+
+  EXPECT_GE(partition.resident_weight_bytes, kFilterBytes);
+  EXPECT_GE(partition.convert_memory.delegate_bytes, kFilterBytes);
+  EXPECT_GE(partition.compile_memory.delegate_bytes,
+            partition.resident_weight_bytes);
+  EXPECT_GE(partition.compiled_model_bytes, 0);
+  EXPECT_GE(partition.duplicated_constant_bytes, 0);
+  EXPECT_LE(partition.duplicated_constant_bytes,
+            partition.resident_weight_bytes);
+
+  // Regression bound: once the plugin is loaded, the converted and the
+  // compiled model may each hold the filter once; more than that is a leak
+  // or a new copy.
+  EXPECT_LT(partition.first_infer_memory.rss_bytes -
+                partition.graph_iteration_memory.rss_bytes,
+            4 * kFilterBytes);
+
+  TfLiteOpenVINODelegateMetrics metrics;
+  ASSERT_EQ(kTfLiteOk,
+            TfLiteOpenVINODelegateGetMetrics(delegate.get(), &metrics));
+  EXPECT_GE(metrics.peak_rss_bytes, partition.peak_rss_bytes);
+}
+
+}  // namespace
+}  // namespace openvinodelegate
+}  // namespace tflite
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "tensorflow/lite/delegates/intel_openvino/openvino_delegate.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_test_model_builder.h"
+#include "tensorflow/lite/delegates/utils/simple_opaque_delegate.h"
+#include "tensorflow/lite/interpreter.h"
+#include "tensorflow/lite/model_builder.h"
+#include "tensorflow/lite/profiling/buffered_profiler.h"
+
+/* Per-layer profiling of delegated partitions through TfLite's profiler */
+
+namespace tflite {
+namespace openvinodelegate {
+namespace {
+
+// ADD (node 0) -> LOGISTIC (node 1), both delegated into one partition.
+std::vector<char> BuildAddLogisticModel() {
+  TestModelBuilder builder;
+  const std::vector<int32_t> shape = {1, 8, 8, 16};
+  const int input0 = builder.AddTensor(shape, TensorType_FLOAT32);
+  const int input1 = builder.AddTensor(shape, TensorType_FLOAT32);
+  const int sum = builder.AddTensor(shape, TensorType_FLOAT32);
+  const int output = builder.AddTensor(shape, TensorType_FLOAT32);
+  builder.AddOperator(BuiltinOperator_ADD, {input0, input1}, {sum},
+                      BuiltinOptions_AddOptions,
+                      CreateAddOptions(builder.builder()).Union());
+  builder.AddOperator(BuiltinOperator_LOGISTIC, {sum}, {output});
+  return builder.Finish({input0, input1}, {output});
+}
+
+TEST(OpenVINODelegateProfilingTest, ReportsLayerTimesPerTfLiteNode) {
+  const std::vector<char> model_data = BuildAddLogisticModel();
+  std::unique_ptr<FlatBufferModel> model =
+      FlatBufferModel::BuildFromBuffer(model_data.data(), model_data.size());
+  ASSERT_NE(model, nullptr);
+
+  TfLiteOpenVINODelegateOptions options;
+  options.enable_profiling = true;
+  TfLiteOpaqueDelegateUniquePtr delegate = CreateOpenVINODelegate(options);
+  std::unique_ptr<Interpreter> interpreter =
+      BuildInterpreter(*model, delegate.get());
+  ASSERT_NE(interpreter, nullptr);
+  ASSERT_EQ(1, interpreter->execution_plan().size());
+
+  profiling::BufferedProfiler profiler(1024);
+  interpreter->SetProfiler(&profiler);
+  profiler.StartProfiling();
+  ASSERT_EQ(kTfLiteOk, interpreter->Invoke());
+  profiler.StopProfiling();
+
+  std::set<int64_t> profiled_nodes;
+  for (const ProfileEvent *event : profiler.GetProfileEvents()) {
+    if (event->event_type !=
+        Profiler::EventType::DELEGATE_PROFILED_OPERATOR_INVOKE_EVENT)
+      continue;
+    const std::string tag = event->tag;
+    EXPECT_THAT(tag, testing::AnyOf("ADD_0", "LOGISTIC_1"));
+    EXPECT_EQ(tag == "ADD_0" ? 0 : 1, event->event_metadata);
+    profiled_nodes.insert(event->event_metadata);
+  }
+  EXPECT_FALSE(profiled_nodes.empty());
+  interpreter->SetProfiler(nullptr);
+}
+
+}  // namespace
+}  // namespace openvinodelegate
+}  // namespace tflite
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
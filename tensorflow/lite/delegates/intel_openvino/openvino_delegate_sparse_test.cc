@@ -0,0 +1,235 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "tensorflow/lite/delegates/intel_openvino/openvino_delegate.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_test_model_builder.h"
+#include "tensorflow/lite/delegates/utils/simple_opaque_delegate.h"
+#include "tensorflow/lite/interpreter.h"
+#include "tensorflow/lite/model_builder.h"
+
+/* End-to-end tests of models with sparse (pruned) weights against TfLite's
+ * builtin kernels */
+
+namespace tflite {
+namespace openvinodelegate {
+namespace {
+
+constexpr int kLatencyIterations = 50;
+// Fraction of pruned weights.
+constexpr float kSparsity = 0.9f;
+
+// What reads the dense constant of BuildSparseAddModel.
+enum class DenseConsumers {
+  // input + dense.
+  kAdd,
+  // input + dense, and input - dense into a second output by an op the
+  // delegate does not take.
+  kAddAndSub,
+  // (input - input) + dense. The delegate does not take the SUB, so the ADD
+  // lands in a later partition than DENSIFY would on its own.
+  kAddAfterSub,
+};
+
+// DENSIFY(sparse constant) read by |consumers|, where the constant has
+// kSparsity zeros.
+std::vector<char> BuildSparseAddModel(
+    size_t *dense_weight_bytes,
+    DenseConsumers consumers = DenseConsumers::kAdd) {
+  const std::vector<int32_t> shape = {1, 16, 16, 32};
+  std::vector<float> weights(1 * 16 * 16 * 32);
+  std::mt19937 generator(7);
+  std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+  for (float &weight : weights) {
+    weight = distribution(generator) < kSparsity
+                 ? 0.0f
+                 : distribution(generator) * 2 - 1;
+  }
+  *dense_weight_bytes = weights.size() * sizeof(float);
+
+  TestModelBuilder builder;
+  const int input = builder.AddTensor(shape, TensorType_FLOAT32);
+  const int sparse = builder.AddSparseTensor(shape, weights);
+  const int dense = builder.AddTensor(shape, TensorType_FLOAT32);
+  const int output = builder.AddTensor(shape, TensorType_FLOAT32);
+  builder.AddOperator(BuiltinOperator_DENSIFY, {sparse}, {dense});
+  int addend = input;
+  if (consumers == DenseConsumers::kAddAfterSub) {
+    addend = builder.AddTensor(shape, TensorType_FLOAT32);
+    builder.AddOperator(BuiltinOperator_SUB, {input, input}, {addend},
+                        BuiltinOptions_SubOptions,
+                        CreateSubOptions(builder.builder()).Union());
+  }
+  builder.AddOperator(BuiltinOperator_ADD, {addend, dense}, {output},
+                      BuiltinOptions_AddOptions,
+                      CreateAddOptions(builder.builder()).Union());
+  if (consumers != DenseConsumers::kAddAndSub)
+    return builder.Finish({input}, {output});
+  const int difference = builder.AddTensor(shape, TensorType_FLOAT32);
+  builder.AddOperator(BuiltinOperator_SUB, {input, dense}, {difference},
+                      BuiltinOptions_SubOptions,
+                      CreateSubOptions(builder.builder()).Union());
+  return builder.Finish({input}, {output, difference});
+}
+
+class OpenVINODelegateSparseTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    model_data_ = BuildSparseAddModel(&dense_weight_bytes_);
+    model_ = FlatBufferModel::BuildFromBuffer(model_data_.data(),
+                                              model_data_.size());
+    ASSERT_NE(model_, nullptr);
+  }
+
+  std::unique_ptr<Interpreter> BuildInterpreter(
+      TfLiteOpaqueDelegate *delegate) {
+    std::unique_ptr<Interpreter> interpreter =
+        openvinodelegate::BuildInterpreter(*model_, delegate);
+    if (interpreter == nullptr) return nullptr;
+    float *input = interpreter->typed_input_tensor<float>(0);
+    const int size = interpreter->input_tensor(0)->bytes / sizeof(float);
+    for (int i = 0; i < size; i++) input[i] = 0.01f * (i % 100);
+    return interpreter;
+  }
+
+  double AverageInvokeMs(Interpreter *interpreter) {
+    EXPECT_EQ(kTfLiteOk, interpreter->Invoke());
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kLatencyIterations; i++)
+      EXPECT_EQ(kTfLiteOk, interpreter->Invoke());
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - start)
+               .count() /
+           kLatencyIterations;
+  }
+
+  std::vector<char> model_data_;
+  size_t dense_weight_bytes_ = 0;
+  std::unique_ptr<FlatBufferModel> model_;
+};
+
+TEST_F(OpenVINODelegateSparseTest, MatchesBuiltinKernels) {
+  std::unique_ptr<Interpreter> reference = BuildInterpreter(nullptr);
+  ASSERT_NE(reference, nullptr);
+
+  TfLiteOpenVINODelegateOptions options;
+  TfLiteOpaqueDelegateUniquePtr delegate = CreateOpenVINODelegate(options);
+  std::unique_ptr<Interpreter> delegated = BuildInterpreter(delegate.get());
+  ASSERT_NE(delegated, nullptr);
+  // DENSIFY and ADD end up in a single delegate kernel.
+  EXPECT_EQ(1, delegated->execution_plan().size());
+
+  ASSERT_EQ(kTfLiteOk, reference->Invoke());
+  ASSERT_EQ(kTfLiteOk, delegated->Invoke());
+  const TfLiteTensor *expected = reference->output_tensor(0);
+  const TfLiteTensor *actual = delegated->output_tensor(0);
+  ASSERT_EQ(expected->bytes, actual->bytes);
+  for (int i = 0; i < expected->bytes / sizeof(float); i++) {
+    EXPECT_NEAR(expected->data.f[i], actual->data.f[i], 1e-6)
+        << "at index " << i;
+  }
+
+  const double reference_ms = AverageInvokeMs(reference.get());
+  const double delegated_ms = AverageInvokeMs(delegated.get());
+  std::cout << "sparse model: " << model_data_.size() << " bytes on disk, "
+            << dense_weight_bytes_ << " bytes of dense weights; builtin "
+            << reference_ms << " ms, OpenVINO delegate " << delegated_ms
+            << " ms\n";
+  RecordProperty("model_bytes", std::to_string(model_data_.size()));
+  RecordProperty("dense_weight_bytes", std::to_string(dense_weight_bytes_));
+  RecordProperty("builtin_ms", std::to_string(reference_ms));
+  RecordProperty("openvino_ms", std::to_string(delegated_ms));
+}
+
+TEST_F(OpenVINODelegateSparseTest, KeepsDensifyWithUndelegatedConsumer) {
+  model_data_ =
+      BuildSparseAddModel(&dense_weight_bytes_, DenseConsumers::kAddAndSub);
+  model_ = FlatBufferModel::BuildFromBuffer(model_data_.data(),
+                                            model_data_.size());
+  ASSERT_NE(model_, nullptr);
+  std::unique_ptr<Interpreter> reference = BuildInterpreter(nullptr);
+  ASSERT_NE(reference, nullptr);
+
+  TfLiteOpenVINODelegateOptions options;
+  TfLiteOpaqueDelegateUniquePtr delegate = CreateOpenVINODelegate(options);
+  std::unique_ptr<Interpreter> delegated = BuildInterpreter(delegate.get());
+  ASSERT_NE(delegated, nullptr);
+  // SUB still reads the dense tensor, so DENSIFY stays with TfLite next to
+  // it and only ADD is delegated.
+  ASSERT_EQ(3u, delegated->execution_plan().size());
+  int densify_nodes = 0;
+  for (int node_index : delegated->execution_plan()) {
+    if (delegated->node_and_registration(node_index)->second.builtin_code ==
+        kTfLiteBuiltinDensify)
+      densify_nodes++;
+  }
+  EXPECT_EQ(1, densify_nodes);
+
+  ASSERT_EQ(kTfLiteOk, reference->Invoke());
+  ASSERT_EQ(kTfLiteOk, delegated->Invoke());
+  for (int o = 0; o < 2; o++) {
+    const TfLiteTensor *expected = reference->output_tensor(o);
+    const TfLiteTensor *actual = delegated->output_tensor(o);
+    ASSERT_EQ(expected->bytes, actual->bytes);
+    for (size_t i = 0; i < expected->bytes / sizeof(float); i++) {
+      ASSERT_NEAR(expected->data.f[i], actual->data.f[i], 1e-6)
+          << "output " << o << " at index " << i;
+    }
+  }
+}
+
+TEST_F(OpenVINODelegateSparseTest, KeepsDensifyInItsConsumersPartition) {
+  model_data_ =
+      BuildSparseAddModel(&dense_weight_bytes_, DenseConsumers::kAddAfterSub);
+  model_ = FlatBufferModel::BuildFromBuffer(model_data_.data(),
+                                            model_data_.size());
+  ASSERT_NE(model_, nullptr);
+  std::unique_ptr<Interpreter> reference = BuildInterpreter(nullptr);
+  ASSERT_NE(reference, nullptr);
+
+  TfLiteOpenVINODelegateOptions options;
+  TfLiteOpaqueDelegateUniquePtr delegate = CreateOpenVINODelegate(options);
+  std::unique_ptr<Interpreter> delegated = BuildInterpreter(delegate.get());
+  ASSERT_NE(delegated, nullptr);
+  // DENSIFY alone would form a partition ahead of the SUB that the ADD
+  // waits on, and its dense tensor would not reach the ADD's partition. It
+  // stays with TfLite instead.
+  ASSERT_EQ(3u, delegated->execution_plan().size());
+  int densify_nodes = 0;
+  for (int node_index : delegated->execution_plan()) {
+    if (delegated->node_and_registration(node_index)->second.builtin_code ==
+        kTfLiteBuiltinDensify)
+      densify_nodes++;
+  }
+  EXPECT_EQ(1, densify_nodes);
+
+  ASSERT_EQ(kTfLiteOk, reference->Invoke());
+  ASSERT_EQ(kTfLiteOk, delegated->Invoke());
+  const TfLiteTensor *expected = reference->output_tensor(0);
+  const TfLiteTensor *actual = delegated->output_tensor(0);
+  ASSERT_EQ(expected->bytes, actual->bytes);
+  for (size_t i = 0; i < expected->bytes / sizeof(float); i++) {
+    ASSERT_NEAR(expected->data.f[i], actual->data.f[i], 1e-6)
+        << "at index " << i;
+  }
+}
+
+}  // namespace
+}  // namespace openvinodelegate
+}  // namespace tflite
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
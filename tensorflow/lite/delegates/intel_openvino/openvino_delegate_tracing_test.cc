@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "tensorflow/lite/delegates/intel_openvino/openvino_delegate.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_test_model_builder.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_tracer.h"
+#include "tensorflow/lite/delegates/utils/simple_opaque_delegate.h"
+#include "tensorflow/lite/interpreter.h"
+#include "tensorflow/lite/model_builder.h"
+
+/* Chrome trace export of the delegate's startup and Eval phases */
+
+namespace tflite {
+namespace openvinodelegate {
+namespace {
+
+bool HasEvent(const std::string &json, const std::string &name) {
+  return json.find("\"name\":\"" + name + "\"") != std::string::npos;
+}
+
+TEST(TracerTest, ExportsCompleteEvents) {
+  Tracer tracer(/*max_events=*/2);
+  { ScopedTrace trace(&tracer, "Convert", kTraceStartup, 3); }
+  { ScopedTrace trace(&tracer, "Initialize", kTraceStartup); }
+  { ScopedTrace trace(&tracer, "Eval", kTraceEval, 3); }
+  { ScopedTrace trace(nullptr, "Eval", kTraceEval, 3); }
+  EXPECT_EQ(2u, tracer.size());
+  EXPECT_EQ(1u, tracer.getDroppedEvents());
+
+  const std::string json = tracer.ToChromeTraceJson();
+  EXPECT_EQ(0u, json.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+  EXPECT_TRUE(HasEvent(json, "Convert"));
+  EXPECT_TRUE(HasEvent(json, "Initialize"));
+  EXPECT_FALSE(HasEvent(json, "Eval"));
+  EXPECT_NE(std::string::npos, json.find("\"ph\":\"X\""));
+  EXPECT_NE(std::string::npos, json.find("\"args\":{\"partition\":3}"));
+}
+
+TEST(OpenVINODelegateTracingTest, WritesStartupAndEvalPhases) {
+  const std::string trace_file = "/tmp/openvino_delegate_trace.json";
+  std::remove(trace_file.c_str());
+  const std::vector<char> model_data = BuildAddModel();
+  std::unique_ptr<FlatBufferModel> model =
+      FlatBufferModel::BuildFromBuffer(model_data.data(), model_data.size());
+  ASSERT_NE(model, nullptr);
+
+  {
+    TfLiteOpenVINODelegateOptions options;
+    options.enable_tracing = true;
+    options.trace_file = trace_file;
+    TfLiteOpaqueDelegateUniquePtr delegate = CreateOpenVINODelegate(options);
+    std::unique_ptr<Interpreter> interpreter =
+        BuildInterpreter(*model, delegate.get());
+    ASSERT_NE(interpreter, nullptr);
+    ASSERT_EQ(1, interpreter->execution_plan().size());
+    ASSERT_EQ(kTfLiteOk, interpreter->Invoke());
+    // The trace is written when the delegate goes away.
+    interpreter.reset();
+  }
+
+  std::ifstream file(trace_file);
+  ASSERT_TRUE(file.good());
+  std::stringstream json;
+  json << file.rdbuf();
+  for (const char *name : {"Initialize", "CreateOVCore", "LoadDevicePlugin",
+                           "Convert", "CompileModel", "KernelInit", "Eval",
+                           "InputCopy", "StartAsync", "Wait", "OutputCopy"})
+    EXPECT_TRUE(HasEvent(json.str(), name)) << name;
+}
+
+}  // namespace
+}  // namespace openvinodelegate
+}  // namespace tflite
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
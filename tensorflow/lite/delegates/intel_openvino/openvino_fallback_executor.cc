@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "tensorflow/lite/delegates/intel_openvino/openvino_fallback_executor.h"
+
+#include <cstring>
+#include <unordered_set>
+#include <vector>
+
+namespace tflite {
+namespace openvinodelegate {
+
+namespace {
+
+// TfLiteOpaqueContext is the opaque view of TfLiteContext; the fallback needs
+// the registration function pointers the opaque API does not expose.
+TfLiteContext *ToTfLiteContext(TfLiteOpaqueContext *context) {
+  return reinterpret_cast<TfLiteContext *>(context);
+}
+
+TfLiteIntArray *CopyArrayOrEmpty(const TfLiteIntArray *array) {
+  return array != nullptr ? TfLiteIntArrayCopy(array) : TfLiteIntArrayCreate(0);
+}
+
+}  // namespace
+
+FallbackExecutor::~FallbackExecutor() {
+  if (context_ != nullptr) {
+    for (const auto &original : original_allocation_types_) {
+      TfLiteTensor *tensor = &context_->tensors[original.first];
+      TfLiteTensorDataFree(tensor);
+      tensor->allocation_type = original.second;
+    }
+  }
+  for (auto &fallback_node : nodes_) {
+    TfLiteIntArrayFree(fallback_node.node.inputs);
+    TfLiteIntArrayFree(fallback_node.node.outputs);
+    TfLiteIntArrayFree(fallback_node.node.intermediates);
+    TfLiteIntArrayFree(fallback_node.node.temporaries);
+  }
+}
+
+TfLiteStatus FallbackExecutor::Init(TfLiteOpaqueContext *opaque_context,
+                                    const TfLiteOpaqueDelegateParams *params) {
+  if (opaque_context == nullptr || params == nullptr) return kTfLiteError;
+  TfLiteContext *context = ToTfLiteContext(opaque_context);
+  context_ = context;
+
+  const std::unordered_set<int> partition_outputs(
+      &params->output_tensors->data[0],
+      &params->output_tensors->data[params->output_tensors->size]);
+
+  for (int i = 0; i < params->nodes_to_replace->size; i++) {
+    TfLiteNode *node;
+    TfLiteRegistration *registration;
+    if (context->GetNodeAndRegistration(context,
+                                        params->nodes_to_replace->data[i],
+                                        &node, &registration) != kTfLiteOk)
+      return kTfLiteError;
+    if (registration->invoke == nullptr) return kTfLiteError;
+
+    // The original node keeps ownership of user_data and builtin_data; only
+    // the index arrays are copied, since TfLite may reallocate its node list
+    // while the delegate kernels are added.
+    FallbackNode fallback_node;
+    std::memset(&fallback_node.node, 0, sizeof(TfLiteNode));
+    fallback_node.node.inputs = CopyArrayOrEmpty(node->inputs);
+    fallback_node.node.outputs = CopyArrayOrEmpty(node->outputs);
+    fallback_node.node.intermediates = CopyArrayOrEmpty(node->intermediates);
+    fallback_node.node.temporaries = TfLiteIntArrayCreate(0);
+    fallback_node.node.user_data = node->user_data;
+    fallback_node.node.builtin_data = node->builtin_data;
+    fallback_node.node.custom_initial_data = node->custom_initial_data;
+    fallback_node.node.custom_initial_data_size =
+        node->custom_initial_data_size;
+    fallback_node.registration = *registration;
+    nodes_.push_back(fallback_node);
+
+    for (int k = 0; k < node->outputs->size; k++) {
+      const int t = node->outputs->data[k];
+      if (t != kTfLiteOptionalTensor && partition_outputs.count(t) == 0)
+        internal_tensors_.push_back(t);
+    }
+    if (node->intermediates != nullptr) {
+      for (int k = 0; k < node->intermediates->size; k++)
+        internal_tensors_.push_back(node->intermediates->data[k]);
+    }
+  }
+  return kTfLiteOk;
+}
+
+void FallbackExecutor::MakeDynamic(TfLiteTensor *tensor, int tensor_index) {
+  if (tensor->allocation_type != kTfLiteArenaRw) return;
+  original_allocation_types_.emplace(tensor_index, tensor->allocation_type);
+  tensor->allocation_type = kTfLiteDynamic;
+}
+
+TfLiteStatus FallbackExecutor::EnsureAllocated(TfLiteContext *context,
+                                               int tensor_index) {
+  TfLiteTensor *tensor = &context->tensors[tensor_index];
+  MakeDynamic(tensor, tensor_index);
+  if (tensor->allocation_type != kTfLiteDynamic ||
+      tensor->data.raw != nullptr || tensor->dims == nullptr)
+    return kTfLiteOk;
+  // Resizing a dynamic tensor to its current shape allocates its buffer.
+  return context->ResizeTensor(context, tensor,
+                               TfLiteIntArrayCopy(tensor->dims));
+}
+
+TfLiteStatus FallbackExecutor::Prepare(TfLiteOpaqueContext *opaque_context) {
+  TfLiteContext *context = ToTfLiteContext(opaque_context);
+  for (int t : internal_tensors_) MakeDynamic(&context->tensors[t], t);
+
+  for (auto &fallback_node : nodes_) {
+    TfLiteNode *node = &fallback_node.node;
+    if (fallback_node.registration.prepare != nullptr &&
+        fallback_node.registration.prepare(context, node) != kTfLiteOk)
+      return kTfLiteError;
+    // Temporaries requested in prepare are arena tensors nobody plans for.
+    for (int k = 0; k < node->temporaries->size; k++) {
+      if (EnsureAllocated(context, node->temporaries->data[k]) != kTfLiteOk)
+        return kTfLiteError;
+    }
+    for (int k = 0; k < node->outputs->size; k++) {
+      const int t = node->outputs->data[k];
+      if (t == kTfLiteOptionalTensor) continue;
+      if (context->tensors[t].allocation_type == kTfLiteDynamic &&
+          EnsureAllocated(context, t) != kTfLiteOk)
+        return kTfLiteError;
+    }
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus FallbackExecutor::Eval(TfLiteOpaqueContext *opaque_context) {
+  TfLiteContext *context = ToTfLiteContext(opaque_context);
+  for (auto &fallback_node : nodes_) {
+    if (fallback_node.registration.invoke(context, &fallback_node.node) !=
+        kTfLiteOk)
+      return kTfLiteError;
+  }
+  return kTfLiteOk;
+}
+
+}  // namespace openvinodelegate
+}  // namespace tflite
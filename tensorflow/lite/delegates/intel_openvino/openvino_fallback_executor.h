@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef DELEGATE_INTEL_OPENVINO_OPENVINO_FALLBACK_EXECUTOR_H_
+#define DELEGATE_INTEL_OPENVINO_OPENVINO_FALLBACK_EXECUTOR_H_
+
+#include <unordered_map>
+#include <vector>
+
+#include "tensorflow/lite/c/c_api_opaque.h"
+#include "tensorflow/lite/c/common.h"
+
+namespace tflite {
+namespace openvinodelegate {
+
+// Runs the original TfLite kernels of a delegated partition. Used to serve
+// Evals while the OpenVINO model of the partition still compiles in the
+// background.
+//
+// The replaced nodes are never prepared by TfLite and their internal tensors
+// are not planned in the arena, so the executor prepares the nodes itself and
+// turns the internal tensors into dynamic ones. Destroying the executor, as
+// the kernel does once the compiled model takes over, frees those buffers and
+// gives the tensors back their original allocation type.
+class FallbackExecutor {
+ public:
+  FallbackExecutor() = default;
+  ~FallbackExecutor();
+
+  FallbackExecutor(const FallbackExecutor &) = delete;
+  FallbackExecutor &operator=(const FallbackExecutor &) = delete;
+
+  // Captures the nodes of the partition. Must be called from the kernel's
+  // Init, the only place where the context still hands out node
+  // registrations.
+  TfLiteStatus Init(TfLiteOpaqueContext *context,
+                    const TfLiteOpaqueDelegateParams *params);
+
+  TfLiteStatus Prepare(TfLiteOpaqueContext *context);
+
+  TfLiteStatus Eval(TfLiteOpaqueContext *context);
+
+ private:
+  struct FallbackNode {
+    TfLiteNode node;
+    TfLiteRegistration registration;
+  };
+
+  TfLiteStatus EnsureAllocated(TfLiteContext *context, int tensor_index);
+  void MakeDynamic(TfLiteTensor *tensor, int tensor_index);
+
+  // Set in Init; outlives the kernel that owns the executor.
+  TfLiteContext *context_ = nullptr;
+
+  std::vector<FallbackNode> nodes_;
+  // Tensors produced and consumed inside the partition only.
+  std::vector<int> internal_tensors_;
+  // Allocation types of the arena tensors made dynamic, by tensor index.
+  std::unordered_map<int, TfLiteAllocationType> original_allocation_types_;
+};
+
+}  // namespace openvinodelegate
+}  // namespace tflite
+
+#endif  // DELEGATE_INTEL_OPENVINO_OPENVINO_FALLBACK_EXECUTOR_H_
@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "tensorflow/lite/delegates/intel_openvino/openvino_fallback_executor.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "tensorflow/lite/delegates/intel_openvino/openvino_delegate.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_delegate_metrics.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_test_model_builder.h"
+#include "tensorflow/lite/delegates/utils/simple_opaque_delegate.h"
+#include "tensorflow/lite/interpreter.h"
+#include "tensorflow/lite/model_builder.h"
+
+/* TfLite kernels serving a delegated partition until its OpenVINO model is
+ * compiled */
+
+namespace tflite {
+namespace openvinodelegate {
+namespace {
+
+constexpr int kSumTensor = 2;
+constexpr size_t kSize = 4 * 4 * 8;
+
+// (input0 + input1) * input1; the sum is internal to the partition.
+std::vector<char> BuildAddMulModel() {
+  const std::vector<int32_t> shape = {1, 4, 4, 8};
+  TestModelBuilder builder;
+  const int input0 = builder.AddTensor(shape, TensorType_FLOAT32);
+  const int input1 = builder.AddTensor(shape, TensorType_FLOAT32);
+  const int sum = builder.AddTensor(shape, TensorType_FLOAT32);
+  const int output = builder.AddTensor(shape, TensorType_FLOAT32);
+  builder.AddOperator(BuiltinOperator_ADD, {input0, input1}, {sum},
+                      BuiltinOptions_AddOptions,
+                      CreateAddOptions(builder.builder()).Union());
+  builder.AddOperator(BuiltinOperator_MUL, {sum, input1}, {output},
+                      BuiltinOptions_MulOptions,
+                      CreateMulOptions(builder.builder()).Union());
+  return builder.Finish({input0, input1}, {output});
+}
+
+// Kernel whose compiled model never arrives: every Eval runs on the
+// executor the test owns, so the test decides when it goes away.
+class FallbackOnlyKernel : public SimpleOpaqueDelegateKernelInterface {
+ public:
+  explicit FallbackOnlyKernel(std::unique_ptr<FallbackExecutor> *executor)
+      : executor_(executor) {}
+
+  TfLiteStatus Init(TfLiteOpaqueContext *context,
+                    const TfLiteOpaqueDelegateParams *params) override {
+    *executor_ = std::make_unique<FallbackExecutor>();
+    return (*executor_)->Init(context, params);
+  }
+
+  TfLiteStatus Prepare(TfLiteOpaqueContext *context,
+                       TfLiteOpaqueNode *node) override {
+    if (*executor_ == nullptr) return kTfLiteError;
+    return (*executor_)->Prepare(context);
+  }
+
+  TfLiteStatus Eval(TfLiteOpaqueContext *context,
+                    TfLiteOpaqueNode *node) override {
+    if (*executor_ == nullptr) return kTfLiteError;
+    return (*executor_)->Eval(context);
+  }
+
+ private:
+  std::unique_ptr<FallbackExecutor> *executor_;
+};
+
+class FallbackOnlyDelegate : public SimpleOpaqueDelegateInterface {
+ public:
+  explicit FallbackOnlyDelegate(std::unique_ptr<FallbackExecutor> *executor)
+      : executor_(executor) {}
+
+  bool IsNodeSupportedByDelegate(const TfLiteRegistrationExternal *registration,
+                                 const TfLiteOpaqueNode *node,
+                                 TfLiteOpaqueContext *context) const override {
+    const int32_t code = TfLiteRegistrationExternalGetBuiltInCode(registration);
+    return code == kTfLiteBuiltinAdd || code == kTfLiteBuiltinMul;
+  }
+
+  TfLiteStatus Initialize(TfLiteOpaqueContext *context) override {
+    return kTfLiteOk;
+  }
+
+  const char *Name() const override { return "FallbackOnlyDelegate"; }
+
+  std::unique_ptr<SimpleOpaqueDelegateKernelInterface>
+  CreateDelegateKernelInterface() override {
+    return std::make_unique<FallbackOnlyKernel>(executor_);
+  }
+
+ private:
+  std::unique_ptr<FallbackExecutor> *executor_;
+};
+
+// Fills the inputs for invoke |round| and returns the number of wrong
+// outputs of the following Invoke, or -1 if it failed.
+int InvokeAndCount(Interpreter *interpreter, int round) {
+  float *input0 = interpreter->typed_input_tensor<float>(0);
+  float *input1 = interpreter->typed_input_tensor<float>(1);
+  for (size_t i = 0; i < kSize; i++) {
+    input0[i] = round;
+    input1[i] = static_cast<float>(i % 5);
+  }
+  if (interpreter->Invoke() != kTfLiteOk) return -1;
+  const float *output = interpreter->typed_output_tensor<float>(0);
+  int errors = 0;
+  for (size_t i = 0; i < kSize; i++) {
+    const float expected = (round + i % 5) * static_cast<float>(i % 5);
+    if (output[i] != expected) errors++;
+  }
+  return errors;
+}
+
+TEST(FallbackExecutorTest, RunsPartitionAndRestoresTensors) {
+  const std::vector<char> model_data = BuildAddMulModel();
+  std::unique_ptr<FlatBufferModel> model =
+      FlatBufferModel::BuildFromBuffer(model_data.data(), model_data.size());
+  ASSERT_NE(model, nullptr);
+
+  std::unique_ptr<FallbackExecutor> executor;
+  TfLiteOpaqueDelegateUniquePtr delegate =
+      TfLiteOpaqueDelegateFactory::Create(
+          std::make_unique<FallbackOnlyDelegate>(&executor));
+  std::unique_ptr<Interpreter> interpreter =
+      BuildInterpreter(*model, delegate.get());
+  ASSERT_NE(interpreter, nullptr);
+  ASSERT_EQ(1u, interpreter->execution_plan().size());
+  ASSERT_NE(executor, nullptr);
+
+  // TfLite does not plan the partition's internal tensor, the executor
+  // allocates it itself.
+  const TfLiteTensor *sum = interpreter->tensor(kSumTensor);
+  EXPECT_EQ(kTfLiteDynamic, sum->allocation_type);
+  EXPECT_NE(nullptr, sum->data.raw);
+  for (int round = 0; round < 3; round++)
+    EXPECT_EQ(0, InvokeAndCount(interpreter.get(), round)) << "round " << round;
+
+  // What the kernel does once the compiled model takes over.
+  executor.reset();
+  sum = interpreter->tensor(kSumTensor);
+  EXPECT_EQ(kTfLiteArenaRw, sum->allocation_type);
+  EXPECT_EQ(nullptr, sum->data.raw);
+}
+
+TEST(FallbackExecutorTest, ServesEvalsWhileCompilePending) {
+  const std::vector<char> model_data = BuildAddMulModel();
+  std::unique_ptr<FlatBufferModel> model =
+      FlatBufferModel::BuildFromBuffer(model_data.data(), model_data.size());
+  ASSERT_NE(model, nullptr);
+
+  TfLiteOpenVINODelegateOptions options;
+  options.async_compilation = true;
+  TfLiteOpaqueDelegateUniquePtr delegate = CreateOpenVINODelegate(options);
+  std::unique_ptr<Interpreter> interpreter =
+      BuildInterpreter(*model, delegate.get());
+  ASSERT_NE(interpreter, nullptr);
+  ASSERT_EQ(1u, interpreter->execution_plan().size());
+
+  // Invoke until the compiled model serves the Evals; results must be the
+  // same on either side of the switch.
+  TfLiteOpenVINOPartitionMetrics metrics;
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(60);
+  int round = 0;
+  do {
+    ASSERT_EQ(0, InvokeAndCount(interpreter.get(), round)) << "round " << round;
+    round++;
+    ASSERT_EQ(kTfLiteOk, TfLiteOpenVINODelegateGetPartitionMetrics(
+                             delegate.get(), 0, &metrics));
+  } while (metrics.evals == 0 && std::chrono::steady_clock::now() < deadline);
+  ASSERT_GT(metrics.evals, 0u) << "compilation did not finish";
+  EXPECT_EQ(kTfLiteArenaRw, interpreter->tensor(kSumTensor)->allocation_type);
+  EXPECT_EQ(0, InvokeAndCount(interpreter.get(), round));
+  if (metrics.fallback_evals == 0)
+    GTEST_SKIP() << "compilation finished before the first Invoke";
+}
+
+}  // namespace
+}  // namespace openvinodelegate
+}  // namespace tflite
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
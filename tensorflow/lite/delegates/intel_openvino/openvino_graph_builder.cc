@@ -65,8 +65,10 @@ TfLiteStatus OpenVINOGraphBuilder::UpdateResultNodes(
   if (context == nullptr) return kTfLiteError;
   if (outputs.size() < 1) return kTfLiteError;
 
-  for (auto o : outputs)
+  for (auto o : outputs) {
+    if (!node_manager_->hasOutput(o)) return kTfLiteError;
     result_nodes_.push_back(node_manager_->getInterimNodeOutput(o));
+  }
 
   return kTfLiteOk;
 }
@@ -80,8 +82,12 @@ TfLiteStatus OpenVINOGraphBuilder::AddInputParams(const TfLiteOpaqueTensor *t,
 
   if (dims.size() <= 0) return kTfLiteError;
 
+  ov::element::Type ov_element_type =
+      GetOVElementType(TfLiteOpaqueTensorType(t));
+  if (ov_element_type == ov::element::undefined) return kTfLiteError;
+
   auto input = std::make_shared<ov::opset3::Parameter>(
-      ov::element::f32, ov::Shape(dims.begin(), dims.end()));
+      ov_element_type, ov::Shape(dims.begin(), dims.end()));
   input_params_.push_back(input);
 
   node_manager_->setOutputAtOperandIndex(index, input);
@@ -104,6 +110,13 @@ TfLiteStatus OpenVINOGraphBuilder::CreateNodeFromTfLiteOp(
   int num_inputs;
   if (TfLiteOpaqueNodeInputs(node, &inputs_data, &num_inputs) != kTfLiteOk)
     return kTfLiteError;
+  // Converters expect every input to be a parameter, a constant or the
+  // output of an earlier op.
+  for (int i = 0; i < num_inputs; i++) {
+    if (inputs_data[i] != kTfLiteOptionalTensor &&
+        !node_manager_->hasOutput(inputs_data[i]))
+      return kTfLiteError;
+  }
   operation_node->UpdateNodeInfo(inputs_data, num_inputs,
                                  TfLiteOpaqueNodeGetBuiltinData(node));
   if (operation_node->CreateNode() != kTfLiteOk) return kTfLiteError;
@@ -118,7 +131,8 @@ TfLiteStatus OpenVINOGraphBuilder::CreateNodeFromTfLiteOp(
   // TODO: Assume there is only one output from the op. Handle multiple outputs
   // from one op in next version.
   if (num_outputs != 1) return kTfLiteError;
-  node_manager_->setOutputAtOperandIndex(outputs[0], result_node);
+  node_manager_->setOutputAtOperandIndex(outputs[0], result_node,
+                                        operation_node->GetOpResultLayout());
 
   return kTfLiteOk;
 }
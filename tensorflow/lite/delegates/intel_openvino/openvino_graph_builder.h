@@ -56,6 +56,16 @@ class OpenVINOGraphBuilder {
 
   size_t getNodeManagerSize() const { return node_manager_->getNodeCount(); }
 
+  // Whether tensor |index| already is a parameter, a constant or the output
+  // of a converted op.
+  bool hasOutput(int index) const { return node_manager_->hasOutput(index); }
+
+  // Transposes added to reconcile tensor layouts between ops; see
+  // NodeManager::getInterimNodeOutput.
+  size_t getLayoutTransposeCount() const {
+    return node_manager_->getLayoutTransposeCount();
+  }
+
   TfLiteStatus CreateNodeFromTfLiteOp(TfLiteRegistrationExternal *registration,
                                       TfLiteOpaqueNode *node,
                                       TfLiteOpaqueContext *context);
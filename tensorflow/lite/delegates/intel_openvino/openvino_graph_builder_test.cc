@@ -10,6 +10,7 @@
 #include <openvino/pass/manager.hpp>
 #include <openvino/pass/serialize.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <unordered_set>
@@ -17,6 +18,8 @@
 #include "tensorflow/lite/builtin_ops.h"
 #include "tensorflow/lite/c/c_api.h"
 #include "tensorflow/lite/core/kernels/builtin_op_kernels.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_synthetic_models.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_test_model_builder.h"
 #include "tensorflow/lite/interpreter.h"
 #include "tensorflow/lite/interpreter_builder.h"
 #include "tensorflow/lite/kernels/kernel_util.h"
@@ -473,6 +476,30 @@ TEST_F(OpenVINOGraphBuilderTest, UpdateResultNodes_InvalidIndex) {
   TfLiteOpaqueDelegateDelete(opaque_delegate);
 }
 
+TEST_F(OpenVINOGraphBuilderTest, NodeManagerMissesDoNotInsert) {
+  NodeManager node_manager(/*num_tensors=*/8);
+  EXPECT_EQ(nullptr, node_manager.getInterimNodeOutput(3));
+  EXPECT_EQ(nullptr, node_manager.getInterimNodeOutput(100));
+  EXPECT_EQ(nullptr, node_manager.getInterimNodeOutput(-1));
+  EXPECT_EQ(0u, node_manager.getNodeCount());
+
+  auto input = std::make_shared<ov::opset8::Parameter>(ov::element::f32,
+                                                       ov::Shape{1, 2, 2, 3});
+  node_manager.setOutputAtOperandIndex(3, input);
+  // Indices past the context's tensor count still grow the storage.
+  node_manager.setOutputAtOperandIndex(20, input);
+  EXPECT_EQ(2u, node_manager.getNodeCount());
+  EXPECT_TRUE(node_manager.hasOutput(20));
+  EXPECT_FALSE(node_manager.hasOutput(19));
+  EXPECT_EQ(input, node_manager.getInterimNodeOutput(3));
+
+  // One shared Transpose per tensor and layout.
+  auto nchw = node_manager.getInterimNodeOutput(3, TensorLayout::kNCHW);
+  EXPECT_EQ((ov::Shape{1, 3, 2, 2}), nchw->get_shape());
+  EXPECT_EQ(nchw, node_manager.getInterimNodeOutput(3, TensorLayout::kNCHW));
+  EXPECT_EQ(1u, node_manager.getLayoutTransposeCount());
+}
+
 TEST_F(OpenVINOGraphBuilderTest, CreateOpClass_Valid) {
   TfLiteRegistrationExternal registration;
   registration.version = 1;
@@ -1015,6 +1042,291 @@ TEST_F(OpenVINOGraphBuilderTest, CreateNodeFromTfLiteOp_InvalidContext) {
   TfLiteOpaqueDelegateDelete(opaque_delegate);
 }
 
+// Graph built by the direct builder from a single-input, single-output
+// TfLite model.
+struct ConvertedGraph {
+  int input_index;
+  int output_index;
+  std::shared_ptr<ov::Model> model;
+  size_t layout_transposes = 0;
+};
+
+// Converts the model in |buffer| with OpenVINOGraphBuilder from inside the
+// delegate's Prepare.
+ConvertedGraph ConvertWithGraphBuilder(const std::vector<char> &buffer,
+                                       int input_index, int output_index) {
+  ConvertedGraph graph;
+  graph.input_index = input_index;
+  graph.output_index = output_index;
+  auto tflite_model =
+      ::tflite::FlatBufferModel::BuildFromBuffer(buffer.data(), buffer.size());
+  EXPECT_NE(tflite_model, nullptr);
+  if (tflite_model == nullptr) return graph;
+
+  TfLiteOpaqueDelegateBuilder opaque_delegate_builder{};
+  opaque_delegate_builder.data = &graph;
+  opaque_delegate_builder.Prepare = [](TfLiteOpaqueContext *opaque_context,
+                                       TfLiteOpaqueDelegate *opaque_delegate,
+                                       void *data) -> TfLiteStatus {
+    auto *graph = static_cast<ConvertedGraph *>(data);
+    auto graph_builder =
+        std::make_unique<OpenVINOGraphBuilder>(std::make_unique<NodeManager>());
+    EXPECT_EQ(kTfLiteOk,
+              graph_builder->AddInputParams(
+                  TfLiteOpaqueContextGetOpaqueTensor(opaque_context,
+                                                     graph->input_index),
+                  graph->input_index));
+
+    TfLiteIntArray *execution_plan;
+    TF_LITE_ENSURE_STATUS(
+        TfLiteOpaqueContextGetExecutionPlan(opaque_context, &execution_plan));
+    for (int i = 0; i < execution_plan->size; ++i) {
+      TfLiteOpaqueNode *node = nullptr;
+      TfLiteRegistrationExternal *registration = nullptr;
+      TfLiteOpaqueContextGetNodeAndRegistration(
+          opaque_context, execution_plan->data[i], &node, &registration);
+      const int *inputs_data;
+      int num_inputs;
+      EXPECT_EQ(kTfLiteOk,
+                TfLiteOpaqueNodeInputs(node, &inputs_data, &num_inputs));
+      for (int k = 0; k < num_inputs; k++) {
+        if (inputs_data[k] < 0) continue;
+        auto opaque_tensor =
+            TfLiteOpaqueContextGetOpaqueTensor(opaque_context, inputs_data[k]);
+        if (TfLiteOpaqueTensorGetAllocationType(opaque_tensor) ==
+            kTfLiteMmapRo)
+          EXPECT_EQ(kTfLiteOk, graph_builder->CreateConstNode(
+                                   opaque_context, inputs_data[k]));
+      }
+      EXPECT_EQ(kTfLiteOk, graph_builder->CreateNodeFromTfLiteOp(
+                               registration, node, opaque_context));
+    }
+
+    EXPECT_EQ(kTfLiteOk, graph_builder->UpdateResultNodes(
+                             opaque_context, {graph->output_index}));
+    graph->model = std::make_shared<ov::Model>(
+        graph_builder->getResultNodes(), graph_builder->getInputParams());
+    graph->layout_transposes = graph_builder->getLayoutTransposeCount();
+    return kTfLiteOk;
+  };
+
+  TfLiteOpaqueDelegate *opaque_delegate =
+      TfLiteOpaqueDelegateCreate(&opaque_delegate_builder);
+  {
+    ::tflite::ops::builtin::BuiltinOpResolver resolver;
+    ::tflite::InterpreterBuilder builder(*tflite_model, resolver);
+    builder.AddDelegate(opaque_delegate);
+    std::unique_ptr<::tflite::Interpreter> interpreter;
+    EXPECT_EQ(kTfLiteOk, builder(&interpreter));
+  }
+  TfLiteOpaqueDelegateDelete(opaque_delegate);
+  return graph;
+}
+
+// Builds a DEQUANTIZE(|weights|) + ADD(input, dequantized) model and converts
+// it with OpenVINOGraphBuilder.
+ConvertedGraph BuildDequantizeAddGraph(const std::vector<int32_t> &shape,
+                                       TensorType weights_type,
+                                       const TestQuantization &quantization,
+                                       const std::vector<uint8_t> &weights) {
+  TestModelBuilder model_builder;
+  const int input = model_builder.AddTensor(shape, TensorType_FLOAT32);
+  const int quantized =
+      model_builder.AddTensor(shape, weights_type, quantization, weights);
+  const int dequantized = model_builder.AddTensor(shape, TensorType_FLOAT32);
+  const int output = model_builder.AddTensor(shape, TensorType_FLOAT32);
+  model_builder.AddOperator(BuiltinOperator_DEQUANTIZE, {quantized},
+                            {dequantized});
+  model_builder.AddOperator(
+      BuiltinOperator_ADD, {input, dequantized}, {output},
+      BuiltinOptions_AddOptions,
+      CreateAddOptions(model_builder.builder()).Union());
+  return ConvertWithGraphBuilder(model_builder.Finish({input}, {output}), input,
+                                 output);
+}
+
+// Element type of the constant holding |num_elements| weights, or undefined.
+ov::element::Type GetWeightsType(const std::shared_ptr<ov::Model> &model,
+                                 size_t num_elements) {
+  for (const auto &op : model->get_ordered_ops()) {
+    auto constant = ov::as_type_ptr<ov::opset8::Constant>(op);
+    if (constant != nullptr &&
+        ov::shape_size(constant->get_shape()) == num_elements)
+      return constant->get_element_type();
+  }
+  return ov::element::undefined;
+}
+
+// Runs |model| on CPU with all inputs set to 1.
+std::vector<float> InferWithOnes(const std::shared_ptr<ov::Model> &model) {
+  ov::Core ov_core(kPluginsXmlPath);
+  ov::CompiledModel compiled_model = ov_core.compile_model(model, "CPU");
+  ov::InferRequest infer_request = compiled_model.create_infer_request();
+  ov::Tensor input = infer_request.get_input_tensor(0);
+  std::fill_n(input.data<float>(), input.get_size(), 1.0f);
+  infer_request.infer();
+  ov::Tensor output = infer_request.get_output_tensor(0);
+  return std::vector<float>(output.data<float>(),
+                            output.data<float>() + output.get_size());
+}
+
+TEST_F(OpenVINOGraphBuilderTest, DequantizeInt8WeightsStayCompressed) {
+  const std::vector<float> scale = {0.5f, 0.25f, 0.125f};
+  const std::vector<int64_t> zero_point = {0, 1, -2};
+  const std::vector<int8_t> weights = {-8, 4,  6,    10,   -3, 0,
+                                       2,  1, -2, 127, -128, 30};
+  ConvertedGraph graph = BuildDequantizeAddGraph(
+      {1, 2, 2, 3}, TensorType_INT8,
+      {scale, zero_point, /*quantized_dimension=*/3},
+      std::vector<uint8_t>(weights.begin(), weights.end()));
+  ASSERT_NE(graph.model, nullptr);
+
+  // The weights are kept as an int8 constant behind a decompression Convert
+  // instead of being expanded to f32.
+  EXPECT_EQ(ov::element::i8, GetWeightsType(graph.model, weights.size()));
+
+  std::vector<float> output = InferWithOnes(graph.model);
+  ASSERT_EQ(weights.size(), output.size());
+  for (int i = 0; i < weights.size(); i++) {
+    const int channel = i % scale.size();
+    const float expected =
+        1.0f + (weights[i] - zero_point[channel]) * scale[channel];
+    EXPECT_NEAR(expected, output[i], 1e-5) << "at index " << i;
+  }
+}
+
+TEST_F(OpenVINOGraphBuilderTest, DequantizeFp16WeightsStayF16) {
+  const std::vector<float> values = {0.5f,  -1.25f, 3.0f,  100.0f,
+                                     -0.1f, 2.5f,   -7.0f, 0.0f};
+  std::vector<uint8_t> weights;
+  for (float value : values) {
+    const uint16_t bits = ov::float16(value).to_bits();
+    weights.push_back(bits & 0xff);
+    weights.push_back(bits >> 8);
+  }
+  ConvertedGraph graph = BuildDequantizeAddGraph(
+      {1, 2, 2, 2}, TensorType_FLOAT16, {}, weights);
+  ASSERT_NE(graph.model, nullptr);
+
+  EXPECT_EQ(ov::element::f16, GetWeightsType(graph.model, values.size()));
+
+  std::vector<float> output = InferWithOnes(graph.model);
+  ASSERT_EQ(values.size(), output.size());
+  for (int i = 0; i < values.size(); i++) {
+    EXPECT_NEAR(1.0f + static_cast<float>(ov::float16(values[i])), output[i],
+                1e-3)
+        << "at index " << i;
+  }
+}
+
+// Runs the model in |buffer| on the builtin kernels with all inputs set to 1.
+std::vector<float> InvokeBuiltinWithOnes(const std::vector<char> &buffer) {
+  std::vector<float> output;
+  auto tflite_model =
+      ::tflite::FlatBufferModel::BuildFromBuffer(buffer.data(), buffer.size());
+  if (tflite_model == nullptr) return output;
+  ::tflite::ops::builtin::BuiltinOpResolverWithoutDefaultDelegates resolver;
+  std::unique_ptr<::tflite::Interpreter> interpreter;
+  if (::tflite::InterpreterBuilder(*tflite_model, resolver)(&interpreter) !=
+          kTfLiteOk ||
+      interpreter->AllocateTensors() != kTfLiteOk)
+    return output;
+  TfLiteTensor *input = interpreter->input_tensor(0);
+  std::fill_n(input->data.f, input->bytes / sizeof(float), 1.0f);
+  if (interpreter->Invoke() != kTfLiteOk) return output;
+  const TfLiteTensor *result = interpreter->output_tensor(0);
+  return std::vector<float>(result->data.f,
+                            result->data.f + result->bytes / sizeof(float));
+}
+
+// Transposes applied to activations, i.e. not folded into constant weights.
+int CountActivationTransposes(const std::shared_ptr<ov::Model> &model) {
+  int count = 0;
+  for (const auto &op : model->get_ordered_ops()) {
+    if (ov::as_type_ptr<ov::opset8::Transpose>(op) != nullptr &&
+        ov::as_type_ptr<ov::opset8::Constant>(
+            op->get_input_node_shared_ptr(0)) == nullptr)
+      count++;
+  }
+  return count;
+}
+
+TEST_F(OpenVINOGraphBuilderTest, ConvStackTransposesOnlyAtBoundaries) {
+  // Convolutions, a residual ADD and a pool all stay in NCHW, so the only
+  // layout changes are at the partition's input and output. Wrapping every
+  // layout-sensitive op in its own transpose pair took 10 here.
+  SyntheticGraphBuilder graph_builder({1, 16, 16, 8});
+  const int conv1 = graph_builder.Conv(graph_builder.input(), 16, 3, 1,
+                                       ActivationFunctionType_RELU);
+  const int conv2 =
+      graph_builder.Conv(conv1, 16, 3, 1, ActivationFunctionType_NONE);
+  const int residual = graph_builder.Add(conv1, conv2);
+  const int conv3 =
+      graph_builder.Conv(residual, 16, 1, 1, ActivationFunctionType_RELU6);
+  const int pool = graph_builder.MaxPool(conv3, 2);
+  const int output =
+      graph_builder.Conv(pool, 8, 3, 1, ActivationFunctionType_NONE);
+  const int input = graph_builder.input();
+  const std::vector<char> buffer = graph_builder.Finish({output});
+
+  ConvertedGraph graph = ConvertWithGraphBuilder(buffer, input, output);
+  ASSERT_NE(graph.model, nullptr);
+  EXPECT_EQ(2u, graph.layout_transposes);
+  EXPECT_EQ(2, CountActivationTransposes(graph.model));
+  EXPECT_EQ((ov::Shape{1, 8, 8, 8}), graph.model->get_result()->get_shape());
+
+  const std::vector<float> expected = InvokeBuiltinWithOnes(buffer);
+  const std::vector<float> actual = InferWithOnes(graph.model);
+  ASSERT_EQ(expected.size(), actual.size());
+  for (int i = 0; i < actual.size(); i++)
+    EXPECT_NEAR(expected[i], actual[i], 1e-4) << "at index " << i;
+}
+
+// Weights feeding a convolution directly, i.e. not through a Transpose or
+// Reshape that the plugin would have to fold.
+std::vector<ov::Shape> GetDirectFilterShapes(
+    const std::shared_ptr<ov::Model> &model) {
+  std::vector<ov::Shape> shapes;
+  for (const auto &op : model->get_ordered_ops()) {
+    if (!ov::is_type<ov::opset8::Convolution>(op) &&
+        !ov::is_type<ov::opset8::GroupConvolution>(op) &&
+        !ov::is_type<ov::opset8::ConvolutionBackpropData>(op))
+      continue;
+    auto filter =
+        ov::as_type_ptr<ov::opset8::Constant>(op->get_input_node_shared_ptr(1));
+    if (filter != nullptr) shapes.push_back(filter->get_shape());
+  }
+  return shapes;
+}
+
+TEST_F(OpenVINOGraphBuilderTest, ConstantFiltersReorderedAtConversion) {
+  SyntheticGraphBuilder graph_builder({1, 8, 8, 8});
+  const int conv = graph_builder.Conv(graph_builder.input(), 16, 3, 1,
+                                      ActivationFunctionType_RELU6);
+  const int depthwise =
+      graph_builder.DepthwiseConv(conv, 3, 1, ActivationFunctionType_RELU6);
+  const int output = graph_builder.TransposeConv(depthwise, 4);
+  const int input = graph_builder.input();
+  const std::vector<char> buffer = graph_builder.Finish({output});
+
+  ConvertedGraph graph = ConvertWithGraphBuilder(buffer, input, output);
+  ASSERT_NE(graph.model, nullptr);
+  // OHWI -> OIHW, IHWO -> G, O/G, I, H, W and IHWO -> OIHW (input channels
+  // first for ConvolutionBackpropData), each as one Constant.
+  EXPECT_THAT(GetDirectFilterShapes(graph.model),
+              testing::ElementsAre(ov::Shape{16, 8, 3, 3},
+                                   ov::Shape{16, 1, 1, 3, 3},
+                                   ov::Shape{16, 4, 2, 2}));
+  for (const auto &op : graph.model->get_ordered_ops())
+    EXPECT_FALSE(ov::is_type<ov::opset8::Reshape>(op)) << op->get_name();
+
+  const std::vector<float> expected = InvokeBuiltinWithOnes(buffer);
+  const std::vector<float> actual = InferWithOnes(graph.model);
+  ASSERT_EQ(expected.size(), actual.size());
+  for (int i = 0; i < actual.size(); i++)
+    EXPECT_NEAR(expected[i], actual[i], 1e-4) << "at index " << i;
+}
+
 }  // namespace openvinodelegate
 }  // namespace tflite
 
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "tensorflow/lite/delegates/intel_openvino/openvino_layer_profiler.h"
+
+#include <openvino/runtime/exec_model_info.hpp>
+
+#include <algorithm>
+#include <sstream>
+
+#include "tensorflow/lite/core/api/profiler.h"
+#include "tensorflow/lite/schema/schema_generated.h"
+
+namespace tflite {
+namespace openvinodelegate {
+
+LayerProfiler::LayerProfiler(TfLiteOpaqueContext *context,
+                             const TfLiteOpaqueDelegateParams *params) {
+  for (int i = 0; i < params->nodes_to_replace->size; i++) {
+    const int node_index = params->nodes_to_replace->data[i];
+    TfLiteOpaqueNode *node;
+    TfLiteRegistrationExternal *registration;
+    if (TfLiteOpaqueContextGetNodeAndRegistration(
+            context, node_index, &node, &registration) != kTfLiteOk)
+      continue;
+    const std::string op_type = EnumNameBuiltinOperator(
+        static_cast<BuiltinOperator>(
+            TfLiteRegistrationExternalGetBuiltInCode(registration)));
+    node_tags_[node_index] = op_type + "_" + std::to_string(node_index);
+    AddName(node_tags_[node_index], node_index);
+
+    const int *outputs = nullptr;
+    int num_outputs = 0;
+    if (TfLiteOpaqueNodeOutputs(node, &outputs, &num_outputs) != kTfLiteOk)
+      continue;
+    for (int o = 0; o < num_outputs; o++) {
+      const char *name = TfLiteOpaqueTensorName(
+          TfLiteOpaqueContextGetOpaqueTensor(context, outputs[o]));
+      if (name != nullptr) AddName(name, node_index);
+    }
+  }
+}
+
+void LayerProfiler::AddName(const std::string &name, int node_index) {
+  if (!name.empty()) node_by_name_.emplace(name, node_index);
+}
+
+const std::vector<int> &LayerProfiler::GetLayerNodes(
+    const ov::CompiledModel &compiled_model, const std::string &layer_name) {
+  auto it = layer_nodes_.find(layer_name);
+  if (it != layer_nodes_.end()) return it->second;
+
+  // Unknown layer, e.g. after the optimized tier was swapped in: map all
+  // layers of the current runtime model.
+  for (const auto &op : compiled_model.get_runtime_model()->get_ops()) {
+    std::vector<int> &nodes = layer_nodes_[op->get_friendly_name()];
+    if (!nodes.empty()) continue;
+    const auto &rt_info = op->get_rt_info();
+    auto names = rt_info.find(ov::exec_model_info::ORIGINAL_NAMES);
+    if (names == rt_info.end()) continue;
+    std::stringstream original_names(names->second.as<std::string>());
+    std::string name;
+    while (std::getline(original_names, name, ',')) {
+      auto node = node_by_name_.find(name);
+      if (node != node_by_name_.end() &&
+          std::find(nodes.begin(), nodes.end(), node->second) == nodes.end())
+        nodes.push_back(node->second);
+    }
+  }
+  return layer_nodes_[layer_name];
+}
+
+void LayerProfiler::Record(TfLiteOpaqueContext *context,
+                           ov::InferRequest &infer_request) {
+  const ov::CompiledModel compiled_model = infer_request.get_compiled_model();
+  std::map<int, int64_t> node_time_us;
+  for (const ov::ProfilingInfo &info : infer_request.get_profiling_info()) {
+    if (info.status != ov::ProfilingInfo::Status::EXECUTED) continue;
+    const int64_t time_us = info.real_time.count();
+    const std::vector<int> &nodes =
+        GetLayerNodes(compiled_model, info.node_name);
+    if (nodes.empty()) {
+      unattributed_time_us_ += time_us;
+      continue;
+    }
+    for (int node : nodes) node_time_us[node] += time_us / nodes.size();
+  }
+
+#ifdef OPENVINO_DELEGATE_STABLE_ABI
+  // The opaque API does not expose the profiler, and TfLiteContext's layout
+  // is not part of the stable delegate ABI: only the node times are kept.
+  Profiler *profiler = nullptr;
+#else
+  // The opaque API does not expose the profiler.
+  auto *profiler = reinterpret_cast<Profiler *>(
+      reinterpret_cast<TfLiteContext *>(context)->profiler);
+#endif
+  for (const auto &node_time : node_time_us) {
+    node_time_us_[node_time.first] += node_time.second;
+    if (profiler == nullptr) continue;
+    profiler->AddEvent(
+        node_tags_[node_time.first].c_str(),
+        Profiler::EventType::DELEGATE_PROFILED_OPERATOR_INVOKE_EVENT,
+        node_time.second, /*event_metadata1=*/node_time.first,
+        /*event_metadata2=*/0);
+  }
+}
+
+}  // namespace openvinodelegate
+}  // namespace tflite
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef DELEGATE_INTEL_OPENVINO_OPENVINO_LAYER_PROFILER_H_
+#define DELEGATE_INTEL_OPENVINO_OPENVINO_LAYER_PROFILER_H_
+
+#include <openvino/openvino.hpp>
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "tensorflow/lite/c/c_api_opaque.h"
+#include "tensorflow/lite/c/common.h"
+
+namespace tflite {
+namespace openvinodelegate {
+
+// Attributes the per-layer timings of OpenVINO's profiling to the TfLite
+// nodes of a partition and reports them to the interpreter's profiler, so
+// op profiling shows time per TfLite op inside the delegate node.
+//
+// Layers of the compiled model are matched through the original layer names
+// the CPU plugin keeps when it fuses layers; those are the operation names
+// set by GraphIteratorDelegate ("<OP>_<node index>") or the TfLite output
+// tensor names. Time of a fused layer is split evenly between its nodes.
+class LayerProfiler {
+ public:
+  LayerProfiler(TfLiteOpaqueContext *context,
+                const TfLiteOpaqueDelegateParams *params);
+
+  // Collects the profiling info of the last inference of |infer_request|,
+  // which must come from a model compiled with ov::enable_profiling, and
+  // adds one event per TfLite node to the interpreter's profiler, if any.
+  // The stable delegate cannot reach the profiler and only keeps the times.
+  void Record(TfLiteOpaqueContext *context, ov::InferRequest &infer_request);
+
+  // Microseconds attributed to each TfLite node, summed over all Records.
+  const std::map<int, int64_t> &getNodeTimes() const { return node_time_us_; }
+
+  // Microseconds of layers no TfLite node could be found for.
+  int64_t getUnattributedTime() const { return unattributed_time_us_; }
+
+ private:
+  // TfLite nodes a layer of the compiled model was built from.
+  const std::vector<int> &GetLayerNodes(const ov::CompiledModel &compiled_model,
+                                        const std::string &layer_name);
+  void AddName(const std::string &name, int node_index);
+
+  std::map<std::string, int> node_by_name_;
+  std::map<std::string, std::vector<int>> layer_nodes_;
+  // Event tags; the profiler keeps pointers to them.
+  std::map<int, std::string> node_tags_;
+  std::map<int, int64_t> node_time_us_;
+  int64_t unattributed_time_us_ = 0;
+};
+
+}  // namespace openvinodelegate
+}  // namespace tflite
+
+#endif  // DELEGATE_INTEL_OPENVINO_OPENVINO_LAYER_PROFILER_H_
@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// Runs the synthetic model zoo (MobileNetV2-like, SSD-head-like, U-Net-like;
+// see openvino_synthetic_models.h) with and without the OpenVINO delegate
+// and reports latency percentiles, throughput and the largest absolute
+// difference of the delegate's outputs from TfLite's builtin kernels. The
+// models are generated in-process, so no network or model files are needed:
+//
+//   bazel run -c opt :openvino_model_zoo_benchmark -- --models=unet \
+//     --inference_precision=f32
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "tensorflow/lite/delegates/intel_openvino/openvino_delegate.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_delegate_metrics.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_synthetic_models.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_test_model_builder.h"
+#include "tensorflow/lite/delegates/utils/simple_opaque_delegate.h"
+#include "tensorflow/lite/interpreter.h"
+#include "tensorflow/lite/kernels/register.h"
+#include "tensorflow/lite/model_builder.h"
+#include "tensorflow/lite/tools/command_line_flags.h"
+#include "tensorflow/lite/tools/logging.h"
+
+namespace tflite {
+namespace openvinodelegate {
+namespace {
+
+struct RunResult {
+  // Sorted.
+  std::vector<double> latencies_us;
+  std::vector<std::vector<float>> outputs;
+  int partitions = 0;
+  // Nodes of the execution plan left to TfLite.
+  int tflite_nodes = 0;
+};
+
+double Percentile(const std::vector<double> &sorted, double fraction) {
+  const size_t rank = static_cast<size_t>(std::ceil(fraction * sorted.size()));
+  return sorted[std::max<size_t>(rank, 1) - 1];
+}
+
+// Runs |model| on the builtin kernels, or on the delegate if |options| is
+// set, with the same deterministic inputs every time.
+bool RunModel(const FlatBufferModel &model,
+              const TfLiteOpenVINODelegateOptions *options, int warmup,
+              int iterations, int num_threads, RunResult *result) {
+  TfLiteOpaqueDelegateUniquePtr delegate(
+      nullptr, TfLiteOpaqueDelegateFactory::DeleteSimpleDelegate);
+  // Declared after the delegate so it is destroyed first.
+  std::unique_ptr<Interpreter> interpreter;
+  if (options != nullptr) delegate = CreateOpenVINODelegate(*options);
+  interpreter = BuildInterpreter(
+      model, ops::builtin::BuiltinOpResolverWithoutDefaultDelegates(),
+      delegate.get(), num_threads);
+  if (interpreter == nullptr) return false;
+
+  for (int input : interpreter->inputs()) {
+    TfLiteTensor *tensor = interpreter->tensor(input);
+    float *data = reinterpret_cast<float *>(tensor->data.raw);
+    for (size_t i = 0; i < tensor->bytes / sizeof(float); i++)
+      data[i] = std::sin(i * 0.01f);
+  }
+  for (int i = 0; i < warmup; i++) {
+    if (interpreter->Invoke() != kTfLiteOk) return false;
+  }
+  result->latencies_us.clear();
+  for (int i = 0; i < iterations; i++) {
+    const auto start = std::chrono::steady_clock::now();
+    if (interpreter->Invoke() != kTfLiteOk) return false;
+    result->latencies_us.push_back(std::chrono::duration<double, std::micro>(
+                                       std::chrono::steady_clock::now() - start)
+                                       .count());
+  }
+  std::sort(result->latencies_us.begin(), result->latencies_us.end());
+
+  result->outputs.clear();
+  for (int output : interpreter->outputs()) {
+    const TfLiteTensor *tensor = interpreter->tensor(output);
+    const float *data = reinterpret_cast<const float *>(tensor->data.raw);
+    result->outputs.emplace_back(data, data + tensor->bytes / sizeof(float));
+  }
+  result->partitions = 0;
+  if (delegate != nullptr) {
+    TfLiteOpenVINODelegateMetrics metrics;
+    if (TfLiteOpenVINODelegateGetMetrics(delegate.get(), &metrics) ==
+        kTfLiteOk)
+      result->partitions = metrics.num_partitions;
+  }
+  result->tflite_nodes =
+      interpreter->execution_plan().size() - result->partitions;
+  return true;
+}
+
+double MaxAbsError(const RunResult &result, const RunResult &reference) {
+  double error = 0;
+  for (size_t o = 0; o < reference.outputs.size(); o++) {
+    for (size_t i = 0; i < reference.outputs[o].size(); i++) {
+      error = std::max<double>(
+          error, std::abs(result.outputs[o][i] - reference.outputs[o][i]));
+    }
+  }
+  return error;
+}
+
+void PrintRow(const std::string &model, const std::string &backend,
+              const RunResult &result, const std::string &error) {
+  const std::vector<double> &latencies = result.latencies_us;
+  const double mean_us =
+      std::accumulate(latencies.begin(), latencies.end(), 0.0) /
+      latencies.size();
+  std::cout << std::left << std::setw(14) << model << std::setw(10) << backend
+            << std::right << std::setw(10) << Percentile(latencies, 0.5)
+            << std::setw(10) << Percentile(latencies, 0.9)
+            << std::setw(10) << Percentile(latencies, 0.99)
+            << std::setw(12) << 1e6 / mean_us << std::setw(12)
+            << result.partitions << std::setw(8) << result.tflite_nodes
+            << std::setw(14) << error << "\n";
+}
+
+int Run(int argc, char **argv) {
+  std::string models;
+  int iterations = 50;
+  int warmup = 5;
+  int num_threads = -1;
+  TfLiteOpenVINODelegateOptions options;
+  std::vector<Flag> flags = {
+      Flag::CreateFlag("models", &models,
+                       "Comma-separated models to run (mobilenet_v2, "
+                       "ssd_head, unet); empty for all."),
+      Flag::CreateFlag("iterations", &iterations,
+                       "Timed invokes per model and backend."),
+      Flag::CreateFlag("warmup", &warmup,
+                       "Untimed invokes before the timed ones."),
+      Flag::CreateFlag("num_threads", &num_threads,
+                       "Threads of the builtin kernels; -1 lets TfLite "
+                       "choose."),
+      Flag::CreateFlag("device_type", &options.device_type,
+                       "OpenVINO device to run on."),
+      Flag::CreateFlag("inference_precision", &options.inference_precision,
+                       "f32, bf16 or f16; empty for the device default."),
+      Flag::CreateFlag("conversion_backend", &options.conversion_backend,
+                       "frontend or graph_builder."),
+  };
+  if (!Flags::Parse(&argc, const_cast<const char **>(argv), flags) ||
+      iterations <= 0 || warmup < 0) {
+    TFLITE_LOG(ERROR) << Flags::Usage(argv[0], flags);
+    return 1;
+  }
+  std::set<std::string> selected;
+  std::stringstream model_list(models);
+  for (std::string name; std::getline(model_list, name, ',');) {
+    if (!name.empty()) selected.insert(name);
+  }
+
+  std::cout << std::left << std::setw(14) << "model" << std::setw(10)
+            << "backend" << std::right << std::setw(10) << "p50_us"
+            << std::setw(10) << "p90_us" << std::setw(10) << "p99_us"
+            << std::setw(12) << "infer/s" << std::setw(12) << "partitions"
+            << std::setw(8) << "tflite" << std::setw(14) << "max_abs_err"
+            << "\n"
+            << std::fixed << std::setprecision(1);
+  for (const SyntheticModel &synthetic : GetSyntheticModels()) {
+    if (!selected.empty() && selected.count(synthetic.name) == 0) continue;
+    const std::vector<char> model_data = synthetic.build();
+    std::unique_ptr<FlatBufferModel> model =
+        FlatBufferModel::BuildFromBuffer(model_data.data(), model_data.size());
+    RunResult reference;
+    RunResult delegated;
+    if (model == nullptr ||
+        !RunModel(*model, nullptr, warmup, iterations, num_threads,
+                  &reference) ||
+        !RunModel(*model, &options, warmup, iterations, num_threads,
+                  &delegated)) {
+      TFLITE_LOG(ERROR) << "Could not run " << synthetic.name;
+      return 1;
+    }
+    std::ostringstream error;
+    error << std::scientific << std::setprecision(2)
+          << MaxAbsError(delegated, reference);
+    PrintRow(synthetic.name, "tflite", reference, "-");
+    PrintRow(synthetic.name, "openvino", delegated, error.str());
+  }
+  return 0;
+}
+
+}  // namespace
+}  // namespace openvinodelegate
+}  // namespace tflite
+
+int main(int argc, char **argv) {
+  return tflite::openvinodelegate::Run(argc, argv);
+}
@@ -0,0 +1,543 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// Times every operation the OpenVINO delegate converts on its own: for each
+// op and each shape of a grid, a single-op model is built in-process and run
+// with the delegate, with XNNPACK and on TfLite's builtin kernels. The table
+// printed shows where the delegate wins or loses against the faster of the
+// two, which is what partitioning should go by. Ops run through the direct
+// graph builder unless --conversion_backend says otherwise, so each row
+// times the op's own converter:
+//
+//   bazel run -c opt :openvino_op_benchmark -- --ops=CONV_2D,PAD \
+//     --csv=/tmp/ops.csv
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "tensorflow/lite/delegates/intel_openvino/openvino_delegate.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_delegate_metrics.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_test_model_builder.h"
+#include "tensorflow/lite/delegates/utils/simple_opaque_delegate.h"
+#include "tensorflow/lite/delegates/xnnpack/xnnpack_delegate.h"
+#include "tensorflow/lite/interpreter.h"
+#include "tensorflow/lite/interpreter_builder.h"
+#include "tensorflow/lite/kernels/register.h"
+#include "tensorflow/lite/model_builder.h"
+#include "tensorflow/lite/tools/command_line_flags.h"
+#include "tensorflow/lite/tools/logging.h"
+
+namespace tflite {
+namespace openvinodelegate {
+namespace {
+
+// NHWC activations from many small channels to few large ones.
+const std::vector<std::vector<int32_t>> kShapes = {
+    {1, 112, 112, 32}, {1, 56, 56, 64}, {1, 28, 28, 128}, {1, 14, 14, 256}};
+
+// The delegate has to be at least this much faster or slower to count as a
+// win or a loss.
+constexpr double kEvenMargin = 0.05;
+
+std::vector<uint8_t> FloatBytes(const std::vector<float> &values) {
+  const auto *bytes = reinterpret_cast<const uint8_t *>(values.data());
+  return std::vector<uint8_t>(bytes, bytes + values.size() * sizeof(float));
+}
+
+std::vector<uint8_t> Int32Bytes(const std::vector<int32_t> &values) {
+  const auto *bytes = reinterpret_cast<const uint8_t *>(values.data());
+  return std::vector<uint8_t>(bytes, bytes + values.size() * sizeof(int32_t));
+}
+
+// Small deterministic weights, so outputs stay finite.
+std::vector<float> Weights(size_t count) {
+  std::vector<float> weights(count);
+  for (size_t i = 0; i < count; i++)
+    weights[i] = (static_cast<int>(i % 11) - 5) * 1e-2f;
+  return weights;
+}
+
+using ModelFn = std::vector<char> (*)(const std::vector<int32_t> &shape);
+
+std::vector<char> BuildUnary(const std::vector<int32_t> &shape,
+                             BuiltinOperator op) {
+  TestModelBuilder builder;
+  const int input = builder.AddTensor(shape, TensorType_FLOAT32);
+  const int output = builder.AddTensor(shape, TensorType_FLOAT32);
+  builder.AddOperator(op, {input}, {output});
+  return builder.Finish({input}, {output});
+}
+
+std::vector<char> BuildAdd(const std::vector<int32_t> &shape) {
+  TestModelBuilder builder;
+  const int input0 = builder.AddTensor(shape, TensorType_FLOAT32);
+  const int input1 = builder.AddTensor(shape, TensorType_FLOAT32);
+  const int output = builder.AddTensor(shape, TensorType_FLOAT32);
+  builder.AddOperator(BuiltinOperator_ADD, {input0, input1}, {output},
+                      BuiltinOptions_AddOptions,
+                      CreateAddOptions(builder.builder()).Union());
+  return builder.Finish({input0, input1}, {output});
+}
+
+std::vector<char> BuildMul(const std::vector<int32_t> &shape) {
+  TestModelBuilder builder;
+  const int input0 = builder.AddTensor(shape, TensorType_FLOAT32);
+  const int input1 = builder.AddTensor(shape, TensorType_FLOAT32);
+  const int output = builder.AddTensor(shape, TensorType_FLOAT32);
+  builder.AddOperator(BuiltinOperator_MUL, {input0, input1}, {output},
+                      BuiltinOptions_MulOptions,
+                      CreateMulOptions(builder.builder()).Union());
+  return builder.Finish({input0, input1}, {output});
+}
+
+std::vector<char> BuildConcatenation(const std::vector<int32_t> &shape) {
+  std::vector<int32_t> output_shape = shape;
+  output_shape[3] *= 2;
+  TestModelBuilder builder;
+  const int input0 = builder.AddTensor(shape, TensorType_FLOAT32);
+  const int input1 = builder.AddTensor(shape, TensorType_FLOAT32);
+  const int output = builder.AddTensor(output_shape, TensorType_FLOAT32);
+  builder.AddOperator(
+      BuiltinOperator_CONCATENATION, {input0, input1}, {output},
+      BuiltinOptions_ConcatenationOptions,
+      CreateConcatenationOptions(builder.builder(), /*axis=*/3).Union());
+  return builder.Finish({input0, input1}, {output});
+}
+
+// 3x3, stride 1, SAME, with bias.
+std::vector<char> BuildConv2d(const std::vector<int32_t> &shape) {
+  const int channels = shape[3];
+  TestModelBuilder builder;
+  const int input = builder.AddTensor(shape, TensorType_FLOAT32);
+  const int filter = builder.AddTensor(
+      {channels, 3, 3, channels}, TensorType_FLOAT32, {},
+      FloatBytes(Weights(channels * 3 * 3 * channels)));
+  const int bias = builder.AddTensor({channels}, TensorType_FLOAT32, {},
+                                     FloatBytes(Weights(channels)));
+  const int output = builder.AddTensor(shape, TensorType_FLOAT32);
+  builder.AddOperator(
+      BuiltinOperator_CONV_2D, {input, filter, bias}, {output},
+      BuiltinOptions_Conv2DOptions,
+      CreateConv2DOptions(builder.builder(), Padding_SAME, 1, 1).Union());
+  return builder.Finish({input}, {output});
+}
+
+std::vector<char> BuildDepthwiseConv2d(const std::vector<int32_t> &shape) {
+  const int channels = shape[3];
+  TestModelBuilder builder;
+  const int input = builder.AddTensor(shape, TensorType_FLOAT32);
+  const int filter =
+      builder.AddTensor({1, 3, 3, channels}, TensorType_FLOAT32, {},
+                        FloatBytes(Weights(3 * 3 * channels)));
+  const int bias = builder.AddTensor({channels}, TensorType_FLOAT32, {},
+                                     FloatBytes(Weights(channels)));
+  const int output = builder.AddTensor(shape, TensorType_FLOAT32);
+  builder.AddOperator(BuiltinOperator_DEPTHWISE_CONV_2D, {input, filter, bias},
+                      {output}, BuiltinOptions_DepthwiseConv2DOptions,
+                      CreateDepthwiseConv2DOptions(builder.builder(),
+                                                   Padding_SAME, 1, 1,
+                                                   /*depth_multiplier=*/1)
+                          .Union());
+  return builder.Finish({input}, {output});
+}
+
+// 2x2, stride 2 upsampling.
+std::vector<char> BuildTransposeConv(const std::vector<int32_t> &shape) {
+  const int channels = shape[3];
+  const std::vector<int32_t> output_shape = {1, shape[1] * 2, shape[2] * 2,
+                                             channels};
+  TestModelBuilder builder;
+  const int output_shape_tensor = builder.AddTensor(
+      {4}, TensorType_INT32, {}, Int32Bytes(output_shape));
+  const int filter = builder.AddTensor(
+      {channels, 2, 2, channels}, TensorType_FLOAT32, {},
+      FloatBytes(Weights(channels * 2 * 2 * channels)));
+  const int input = builder.AddTensor(shape, TensorType_FLOAT32);
+  const int output = builder.AddTensor(output_shape, TensorType_FLOAT32);
+  builder.AddOperator(
+      BuiltinOperator_TRANSPOSE_CONV, {output_shape_tensor, filter, input},
+      {output}, BuiltinOptions_TransposeConvOptions,
+      CreateTransposeConvOptions(builder.builder(), Padding_SAME, 2, 2)
+          .Union());
+  return builder.Finish({input}, {output});
+}
+
+// 3x3, stride 2, SAME.
+std::vector<char> BuildPool2d(const std::vector<int32_t> &shape,
+                              BuiltinOperator op) {
+  const std::vector<int32_t> output_shape = {1, (shape[1] + 1) / 2,
+                                             (shape[2] + 1) / 2, shape[3]};
+  TestModelBuilder builder;
+  const int input = builder.AddTensor(shape, TensorType_FLOAT32);
+  const int output = builder.AddTensor(output_shape, TensorType_FLOAT32);
+  builder.AddOperator(op, {input}, {output}, BuiltinOptions_Pool2DOptions,
+                      CreatePool2DOptions(builder.builder(), Padding_SAME, 2,
+                                          2, 3, 3)
+                          .Union());
+  return builder.Finish({input}, {output});
+}
+
+std::vector<char> BuildAveragePool2d(const std::vector<int32_t> &shape) {
+  return BuildPool2d(shape, BuiltinOperator_AVERAGE_POOL_2D);
+}
+
+std::vector<char> BuildMaxPool2d(const std::vector<int32_t> &shape) {
+  return BuildPool2d(shape, BuiltinOperator_MAX_POOL_2D);
+}
+
+// Global average over H and W.
+std::vector<char> BuildMean(const std::vector<int32_t> &shape) {
+  TestModelBuilder builder;
+  const int input = builder.AddTensor(shape, TensorType_FLOAT32);
+  const int axes =
+      builder.AddTensor({2}, TensorType_INT32, {}, Int32Bytes({1, 2}));
+  const int output = builder.AddTensor({1, 1, 1, shape[3]}, TensorType_FLOAT32);
+  builder.AddOperator(
+      BuiltinOperator_MEAN, {input, axes}, {output},
+      BuiltinOptions_ReducerOptions,
+      CreateReducerOptions(builder.builder(), /*keep_dims=*/true).Union());
+  return builder.Finish({input}, {output});
+}
+
+// One pixel on each side of H and W.
+std::vector<char> BuildPad(const std::vector<int32_t> &shape) {
+  TestModelBuilder builder;
+  const int input = builder.AddTensor(shape, TensorType_FLOAT32);
+  const int paddings = builder.AddTensor(
+      {4, 2}, TensorType_INT32, {}, Int32Bytes({0, 0, 1, 1, 1, 1, 0, 0}));
+  const int output = builder.AddTensor(
+      {1, shape[1] + 2, shape[2] + 2, shape[3]}, TensorType_FLOAT32);
+  builder.AddOperator(BuiltinOperator_PAD, {input, paddings}, {output},
+                      BuiltinOptions_PadOptions,
+                      CreatePadOptions(builder.builder()).Union());
+  return builder.Finish({input}, {output});
+}
+
+std::vector<char> BuildReshape(const std::vector<int32_t> &shape) {
+  const std::vector<int32_t> output_shape = {1, shape[1] * shape[2], shape[3]};
+  TestModelBuilder builder;
+  const int input = builder.AddTensor(shape, TensorType_FLOAT32);
+  const int new_shape =
+      builder.AddTensor({3}, TensorType_INT32, {}, Int32Bytes(output_shape));
+  const int output = builder.AddTensor(output_shape, TensorType_FLOAT32);
+  builder.AddOperator(BuiltinOperator_RESHAPE, {input, new_shape}, {output});
+  return builder.Finish({input}, {output});
+}
+
+// 2x upsampling.
+std::vector<char> BuildResizeBilinear(const std::vector<int32_t> &shape) {
+  TestModelBuilder builder;
+  const int input = builder.AddTensor(shape, TensorType_FLOAT32);
+  const int size = builder.AddTensor(
+      {2}, TensorType_INT32, {}, Int32Bytes({shape[1] * 2, shape[2] * 2}));
+  const int output = builder.AddTensor(
+      {1, shape[1] * 2, shape[2] * 2, shape[3]}, TensorType_FLOAT32);
+  builder.AddOperator(
+      BuiltinOperator_RESIZE_BILINEAR, {input, size}, {output},
+      BuiltinOptions_ResizeBilinearOptions,
+      CreateResizeBilinearOptions(builder.builder(), /*align_corners=*/false,
+                                  /*half_pixel_centers=*/true)
+          .Union());
+  return builder.Finish({input}, {output});
+}
+
+std::vector<char> BuildSoftmax(const std::vector<int32_t> &shape) {
+  TestModelBuilder builder;
+  const int input = builder.AddTensor(shape, TensorType_FLOAT32);
+  const int output = builder.AddTensor(shape, TensorType_FLOAT32);
+  builder.AddOperator(BuiltinOperator_SOFTMAX, {input}, {output},
+                      BuiltinOptions_SoftmaxOptions,
+                      CreateSoftmaxOptions(builder.builder(), 1.0f).Union());
+  return builder.Finish({input}, {output});
+}
+
+// int8 activations to float.
+std::vector<char> BuildDequantize(const std::vector<int32_t> &shape) {
+  TestModelBuilder builder;
+  const int input = builder.AddTensor(shape, TensorType_INT8, {{0.05f}, {0}});
+  const int output = builder.AddTensor(shape, TensorType_FLOAT32);
+  builder.AddOperator(BuiltinOperator_DEQUANTIZE, {input}, {output});
+  return builder.Finish({input}, {output});
+}
+
+std::vector<char> BuildRelu(const std::vector<int32_t> &shape) {
+  return BuildUnary(shape, BuiltinOperator_RELU);
+}
+std::vector<char> BuildRelu6(const std::vector<int32_t> &shape) {
+  return BuildUnary(shape, BuiltinOperator_RELU6);
+}
+std::vector<char> BuildLogistic(const std::vector<int32_t> &shape) {
+  return BuildUnary(shape, BuiltinOperator_LOGISTIC);
+}
+std::vector<char> BuildTanh(const std::vector<int32_t> &shape) {
+  return BuildUnary(shape, BuiltinOperator_TANH);
+}
+std::vector<char> BuildHardSwish(const std::vector<int32_t> &shape) {
+  return BuildUnary(shape, BuiltinOperator_HARD_SWISH);
+}
+
+struct OpCase {
+  BuiltinOperator op;
+  ModelFn build;
+};
+
+// One case per converter under operations/src.
+const std::vector<OpCase> kOpCases = {
+    {BuiltinOperator_ADD, BuildAdd},
+    {BuiltinOperator_AVERAGE_POOL_2D, BuildAveragePool2d},
+    {BuiltinOperator_CONCATENATION, BuildConcatenation},
+    {BuiltinOperator_CONV_2D, BuildConv2d},
+    {BuiltinOperator_DEPTHWISE_CONV_2D, BuildDepthwiseConv2d},
+    {BuiltinOperator_DEQUANTIZE, BuildDequantize},
+    {BuiltinOperator_HARD_SWISH, BuildHardSwish},
+    {BuiltinOperator_LOGISTIC, BuildLogistic},
+    {BuiltinOperator_MAX_POOL_2D, BuildMaxPool2d},
+    {BuiltinOperator_MEAN, BuildMean},
+    {BuiltinOperator_MUL, BuildMul},
+    {BuiltinOperator_PAD, BuildPad},
+    {BuiltinOperator_RELU, BuildRelu},
+    {BuiltinOperator_RELU6, BuildRelu6},
+    {BuiltinOperator_RESHAPE, BuildReshape},
+    {BuiltinOperator_RESIZE_BILINEAR, BuildResizeBilinear},
+    {BuiltinOperator_SOFTMAX, BuildSoftmax},
+    {BuiltinOperator_TANH, BuildTanh},
+    {BuiltinOperator_TRANSPOSE_CONV, BuildTransposeConv},
+};
+
+enum class Backend { kOpenVINO, kXNNPack, kBuiltin };
+
+// Whether the delegate took the op, and why not if it did not.
+enum class Delegation {
+  kDelegated,
+  // The delegate did not claim the op, so no partition was created.
+  kNotSupported,
+  // The op was claimed but its partition failed to convert or compile.
+  kConversionFailed,
+  // Delegated, but the graph builder fell back to the frontend.
+  kFrontendFallback,
+};
+
+struct BenchmarkSettings {
+  int iterations = 50;
+  int warmup = 5;
+  int num_threads = -1;
+  TfLiteOpenVINODelegateOptions options;
+};
+
+// Median latency of Invoke in microseconds, or -1 if the model could not be
+// run. For the delegate, the op must have been taken as a whole; how it was
+// taken is stored in |delegation| if set.
+double TimeBackend(const FlatBufferModel &model, Backend backend,
+                   const BenchmarkSettings &settings,
+                   Delegation *delegation = nullptr) {
+  TfLiteOpaqueDelegateUniquePtr openvino(
+      nullptr, TfLiteOpaqueDelegateFactory::DeleteSimpleDelegate);
+  std::unique_ptr<TfLiteDelegate, void (*)(TfLiteDelegate *)> xnnpack(
+      nullptr, TfLiteXNNPackDelegateDelete);
+  // Declared after the delegates so it is destroyed first.
+  std::unique_ptr<Interpreter> interpreter;
+
+  ops::builtin::BuiltinOpResolverWithoutDefaultDelegates resolver;
+  InterpreterBuilder builder(model, resolver);
+  if (backend == Backend::kOpenVINO) {
+    openvino = CreateOpenVINODelegate(settings.options);
+    builder.AddDelegate(openvino.get());
+  } else if (backend == Backend::kXNNPack) {
+    TfLiteXNNPackDelegateOptions xnnpack_options =
+        TfLiteXNNPackDelegateOptionsDefault();
+    xnnpack_options.num_threads = std::max(1, settings.num_threads);
+    xnnpack.reset(TfLiteXNNPackDelegateCreate(&xnnpack_options));
+    builder.AddDelegate(xnnpack.get());
+  }
+  builder.SetNumThreads(settings.num_threads);
+  const bool built = builder(&interpreter) == kTfLiteOk &&
+                     interpreter->AllocateTensors() == kTfLiteOk;
+  if (backend == Backend::kOpenVINO && delegation != nullptr) {
+    // A partition is only created for ops the delegate claimed.
+    TfLiteOpenVINOPartitionMetrics partition;
+    if (TfLiteOpenVINODelegateGetPartitionMetrics(openvino.get(), 0,
+                                                  &partition) != kTfLiteOk) {
+      *delegation = Delegation::kNotSupported;
+    } else if (!built || interpreter->execution_plan().size() != 1) {
+      *delegation = Delegation::kConversionFailed;
+    } else if (settings.options.conversion_backend == "graph_builder" &&
+               partition.graph_builder == 0) {
+      *delegation = Delegation::kFrontendFallback;
+    } else {
+      *delegation = Delegation::kDelegated;
+    }
+  }
+  if (!built) return -1;
+  if (backend == Backend::kOpenVINO &&
+      interpreter->execution_plan().size() != 1)
+    return -1;
+
+  for (int input : interpreter->inputs()) {
+    TfLiteTensor *tensor = interpreter->tensor(input);
+    if (tensor->type == kTfLiteFloat32) {
+      std::fill_n(reinterpret_cast<float *>(tensor->data.raw),
+                  tensor->bytes / sizeof(float), 0.5f);
+    } else {
+      std::memset(tensor->data.raw, 3, tensor->bytes);
+    }
+  }
+  for (int i = 0; i < settings.warmup; i++) {
+    if (interpreter->Invoke() != kTfLiteOk) return -1;
+  }
+  std::vector<double> latencies;
+  for (int i = 0; i < settings.iterations; i++) {
+    const auto start = std::chrono::steady_clock::now();
+    if (interpreter->Invoke() != kTfLiteOk) return -1;
+    latencies.push_back(std::chrono::duration<double, std::micro>(
+                            std::chrono::steady_clock::now() - start)
+                            .count());
+  }
+  std::nth_element(latencies.begin(),
+                   latencies.begin() + latencies.size() / 2, latencies.end());
+  return latencies[latencies.size() / 2];
+}
+
+std::string ShapeString(const std::vector<int32_t> &shape) {
+  std::string result;
+  for (size_t i = 0; i < shape.size(); i++) {
+    if (i > 0) result += "x";
+    result += std::to_string(shape[i]);
+  }
+  return result;
+}
+
+std::string Verdict(double openvino_us, double best_tflite_us,
+                    Delegation delegation) {
+  if (delegation == Delegation::kNotSupported) return "not supported";
+  if (delegation == Delegation::kConversionFailed) return "conversion failed";
+  if (openvino_us < 0) return "failed";
+  if (best_tflite_us < 0) return "wins";
+  const double speedup = best_tflite_us / openvino_us;
+  if (speedup >= 1 + kEvenMargin) return "wins";
+  if (speedup <= 1 - kEvenMargin) return "loses";
+  return "even";
+}
+
+int Run(int argc, char **argv) {
+  std::string ops;
+  std::string csv;
+  BenchmarkSettings settings;
+  // Per-op timings are meant for the converters under operations/src.
+  settings.options.conversion_backend = "graph_builder";
+  std::vector<Flag> flags = {
+      Flag::CreateFlag("ops", &ops,
+                       "Comma-separated TfLite op names to time, e.g. "
+                       "CONV_2D,PAD; empty for all."),
+      Flag::CreateFlag("iterations", &settings.iterations,
+                       "Timed invokes per op, shape and backend."),
+      Flag::CreateFlag("warmup", &settings.warmup,
+                       "Untimed invokes before the timed ones."),
+      Flag::CreateFlag("num_threads", &settings.num_threads,
+                       "Threads of the TfLite kernels and XNNPACK; -1 lets "
+                       "TfLite choose."),
+      Flag::CreateFlag("device_type", &settings.options.device_type,
+                       "OpenVINO device to run on."),
+      Flag::CreateFlag("conversion_backend",
+                       &settings.options.conversion_backend,
+                       "graph_builder or frontend."),
+      Flag::CreateFlag("csv", &csv, "Also write the table to this CSV file."),
+  };
+  if (!Flags::Parse(&argc, const_cast<const char **>(argv), flags) ||
+      settings.iterations <= 0 || settings.warmup < 0) {
+    TFLITE_LOG(ERROR) << Flags::Usage(argv[0], flags);
+    return 1;
+  }
+  std::set<std::string> selected;
+  std::stringstream op_list(ops);
+  for (std::string op; std::getline(op_list, op, ',');) {
+    if (!op.empty()) selected.insert(op);
+  }
+
+  std::ofstream csv_file;
+  if (!csv.empty()) {
+    csv_file.open(csv);
+    if (!csv_file) {
+      TFLITE_LOG(ERROR) << "Cannot write " << csv;
+      return 1;
+    }
+    csv_file << "op,shape,openvino_us,xnnpack_us,builtin_us,speedup,verdict\n";
+  }
+
+  std::cout << std::left << std::setw(20) << "op" << std::setw(16) << "shape"
+            << std::right << std::setw(13) << "openvino_us" << std::setw(13)
+            << "xnnpack_us" << std::setw(13) << "builtin_us" << std::setw(9)
+            << "speedup" << "  verdict\n"
+            << std::fixed << std::setprecision(1);
+  int wins = 0;
+  int losses = 0;
+  int unsupported = 0;
+  int conversion_failures = 0;
+  for (const OpCase &op_case : kOpCases) {
+    const std::string name = EnumNameBuiltinOperator(op_case.op);
+    if (!selected.empty() && selected.count(name) == 0) continue;
+    for (const std::vector<int32_t> &shape : kShapes) {
+      const std::vector<char> model_data = op_case.build(shape);
+      std::unique_ptr<FlatBufferModel> model =
+          FlatBufferModel::BuildFromBuffer(model_data.data(),
+                                           model_data.size());
+      if (model == nullptr) return 1;
+      Delegation delegation = Delegation::kNotSupported;
+      const double openvino_us =
+          TimeBackend(*model, Backend::kOpenVINO, settings, &delegation);
+      const double xnnpack_us =
+          TimeBackend(*model, Backend::kXNNPack, settings);
+      const double builtin_us =
+          TimeBackend(*model, Backend::kBuiltin, settings);
+      double best_tflite_us = builtin_us;
+      if (xnnpack_us >= 0 &&
+          (best_tflite_us < 0 || xnnpack_us < best_tflite_us))
+        best_tflite_us = xnnpack_us;
+      const double speedup = openvino_us > 0 && best_tflite_us >= 0
+                                 ? best_tflite_us / openvino_us
+                                 : -1;
+      std::string verdict = Verdict(openvino_us, best_tflite_us, delegation);
+      if (verdict == "wins") wins++;
+      if (verdict == "loses") losses++;
+      if (delegation == Delegation::kNotSupported) unsupported++;
+      if (delegation == Delegation::kConversionFailed) conversion_failures++;
+      if (delegation == Delegation::kFrontendFallback) verdict += " (frontend)";
+
+      std::cout << std::left << std::setw(20) << name << std::setw(16)
+                << ShapeString(shape) << std::right << std::setw(13)
+                << openvino_us << std::setw(13) << xnnpack_us << std::setw(13)
+                << builtin_us << std::setw(8) << speedup << "x  " << verdict
+                << "\n";
+      if (csv_file.is_open()) {
+        csv_file << name << "," << ShapeString(shape) << "," << openvino_us
+                 << "," << xnnpack_us << "," << builtin_us << "," << speedup
+                 << "," << verdict << "\n";
+      }
+    }
+  }
+  std::cout << "delegate wins " << wins << ", loses " << losses
+            << ", not supported " << unsupported << ", conversion failed "
+            << conversion_failures
+            << " (speedup is the faster of XNNPACK and builtin over the "
+               "delegate; -1 where a backend could not run)\n";
+  return 0;
+}
+
+}  // namespace
+}  // namespace openvinodelegate
+}  // namespace tflite
+
+int main(int argc, char **argv) {
+  return tflite::openvinodelegate::Run(argc, argv);
+}
@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "tensorflow/lite/delegates/intel_openvino/openvino_partition_analyzer.h"
+
+#include <openvino/runtime/exec_model_info.hpp>
+
+#include <algorithm>
+#include <sstream>
+
+#include "tensorflow/lite/builtin_ops.h"
+#include "tensorflow/lite/schema/schema_generated.h"
+
+namespace tflite {
+namespace openvinodelegate {
+
+namespace {
+
+const TfLiteOpaqueTensor *GetNodeTensor(TfLiteOpaqueContext *context,
+                                        const int *tensors, int num_tensors,
+                                        int index) {
+  if (index >= num_tensors || tensors[index] == kTfLiteOptionalTensor)
+    return nullptr;
+  return TfLiteOpaqueContextGetOpaqueTensor(context, tensors[index]);
+}
+
+int64_t NumElements(const TfLiteOpaqueTensor *tensor) {
+  if (tensor == nullptr) return 0;
+  int64_t elements = 1;
+  for (int i = 0; i < TfLiteOpaqueTensorNumDims(tensor); i++)
+    elements *= TfLiteOpaqueTensorDim(tensor, i);
+  return elements;
+}
+
+// Dimension |index| of |tensor|, counting from the back if negative.
+int64_t Dim(const TfLiteOpaqueTensor *tensor, int index) {
+  if (tensor == nullptr) return 1;
+  const int num_dims = TfLiteOpaqueTensorNumDims(tensor);
+  if (index < 0) index += num_dims;
+  if (index < 0 || index >= num_dims) return 1;
+  return TfLiteOpaqueTensorDim(tensor, index);
+}
+
+// Rough operation count of one node; accurate for the ops that dominate,
+// convolutions and matrix multiplications.
+int64_t EstimateFlops(TfLiteOpaqueContext *context, TfLiteOpaqueNode *node,
+                      int builtin_code) {
+  const int *inputs = nullptr;
+  int num_inputs = 0;
+  const int *outputs = nullptr;
+  int num_outputs = 0;
+  if (TfLiteOpaqueNodeInputs(node, &inputs, &num_inputs) != kTfLiteOk ||
+      TfLiteOpaqueNodeOutputs(node, &outputs, &num_outputs) != kTfLiteOk)
+    return 0;
+  auto input = [&](int index) {
+    return GetNodeTensor(context, inputs, num_inputs, index);
+  };
+  const int64_t output_elements =
+      NumElements(GetNodeTensor(context, outputs, num_outputs, 0));
+
+  switch (builtin_code) {
+    case kTfLiteBuiltinConv2d:
+      // Filter: [out_channels, height, width, in_channels].
+      return 2 * output_elements * Dim(input(1), 1) * Dim(input(1), 2) *
+             Dim(input(1), 3);
+    case kTfLiteBuiltinDepthwiseConv2d:
+      // Filter: [1, height, width, out_channels].
+      return 2 * output_elements * Dim(input(1), 1) * Dim(input(1), 2);
+    case kTfLiteBuiltinTransposeConv:
+      // Inputs: output shape, filter [out_channels, height, width,
+      // in_channels], input; every input element is scattered.
+      return 2 * NumElements(input(2)) * Dim(input(1), 0) * Dim(input(1), 1) *
+             Dim(input(1), 2);
+    case kTfLiteBuiltinFullyConnected:
+      // Weights: [units, input_size].
+      return 2 * output_elements * Dim(input(1), 1);
+    case kTfLiteBuiltinBatchMatmul:
+      return 2 * output_elements * Dim(input(0), -1);
+    case kTfLiteBuiltinAveragePool2d:
+    case kTfLiteBuiltinMaxPool2d: {
+      const auto *pool_params = reinterpret_cast<const TfLitePoolParams *>(
+          TfLiteOpaqueNodeGetBuiltinData(node));
+      if (pool_params == nullptr) return output_elements;
+      return output_elements * pool_params->filter_height *
+             pool_params->filter_width;
+    }
+    case kTfLiteBuiltinMean:
+    case kTfLiteBuiltinSum:
+    case kTfLiteBuiltinReduceMax:
+    case kTfLiteBuiltinReduceMin:
+    case kTfLiteBuiltinReduceProd:
+      return NumElements(input(0));
+    default:
+      return output_elements;
+  }
+}
+
+int64_t SumBytes(TfLiteOpaqueContext *context,
+                 const std::vector<int> &tensors) {
+  int64_t bytes = 0;
+  for (int t : tensors)
+    bytes += TfLiteOpaqueTensorByteSize(
+        TfLiteOpaqueContextGetOpaqueTensor(context, t));
+  return bytes;
+}
+
+int CountTfLiteOps(const PartitionReport &report,
+                   const std::vector<BuiltinOperator> &ops) {
+  int count = 0;
+  for (BuiltinOperator op : ops) {
+    auto it = report.tflite_ops.find(EnumNameBuiltinOperator(op));
+    if (it != report.tflite_ops.end()) count += it->second;
+  }
+  return count;
+}
+
+}  // namespace
+
+std::string PartitionReport::ToJson() const {
+  std::ostringstream json;
+  json << "{\"partition_index\":" << partition_index << ",\"tflite_ops\":{";
+  bool first = true;
+  for (const auto &op : tflite_ops) {
+    json << (first ? "" : ",") << "\"" << op.first << "\":" << op.second;
+    first = false;
+  }
+  json << "},\"estimated_flops\":" << estimated_flops
+       << ",\"input_bytes_per_eval\":" << input_bytes_per_eval
+       << ",\"output_bytes_per_eval\":" << output_bytes_per_eval
+       << ",\"model_ops\":" << model_ops
+       << ",\"inserted_transposes\":" << inserted_transposes
+       << ",\"inserted_converts\":" << inserted_converts
+       << ",\"runtime_model_ops\":" << runtime_model_ops
+       << ",\"runtime_reorders\":" << runtime_reorders << "}";
+  return json.str();
+}
+
+TfLiteStatus AnalyzeTfLitePartition(TfLiteOpaqueContext *context,
+                                    const TfLiteOpaqueDelegateParams *params,
+                                    const std::vector<int> &compute_inputs,
+                                    const std::vector<int> &outputs,
+                                    PartitionReport *report) {
+  if (context == nullptr || params == nullptr || report == nullptr)
+    return kTfLiteError;
+  report->tflite_ops.clear();
+  report->estimated_flops = 0;
+  for (int i = 0; i < params->nodes_to_replace->size; i++) {
+    TfLiteOpaqueNode *node;
+    TfLiteRegistrationExternal *registration;
+    if (TfLiteOpaqueContextGetNodeAndRegistration(
+            context, params->nodes_to_replace->data[i], &node,
+            &registration) != kTfLiteOk)
+      return kTfLiteError;
+    const int builtin_code =
+        TfLiteRegistrationExternalGetBuiltInCode(registration);
+    report->tflite_ops[EnumNameBuiltinOperator(
+        static_cast<BuiltinOperator>(builtin_code))]++;
+    report->estimated_flops += EstimateFlops(context, node, builtin_code);
+  }
+  report->input_bytes_per_eval = SumBytes(context, compute_inputs);
+  report->output_bytes_per_eval = SumBytes(context, outputs);
+  return kTfLiteOk;
+}
+
+void AnalyzeConvertedModel(const std::shared_ptr<ov::Model> &model,
+                           PartitionReport *report) {
+  if (model == nullptr || report == nullptr) return;
+  int transposes = 0;
+  int converts = 0;
+  report->model_ops = 0;
+  for (const auto &op : model->get_ordered_ops()) {
+    if (ov::op::util::is_parameter(op) || ov::op::util::is_output(op) ||
+        ov::op::util::is_constant(op))
+      continue;
+    report->model_ops++;
+    const std::string type = op->get_type_name();
+    if (type == "Transpose") transposes++;
+    if (type == "Convert") converts++;
+  }
+  report->inserted_transposes = std::max(
+      0, transposes - CountTfLiteOps(*report, {BuiltinOperator_TRANSPOSE}));
+  report->inserted_converts = std::max(
+      0, converts - CountTfLiteOps(*report,
+                                   {BuiltinOperator_CAST,
+                                    BuiltinOperator_QUANTIZE,
+                                    BuiltinOperator_DEQUANTIZE}));
+}
+
+void AnalyzeCompiledModel(const ov::CompiledModel &compiled_model,
+                          PartitionReport *report) {
+  if (report == nullptr) return;
+  report->runtime_model_ops = 0;
+  report->runtime_reorders = 0;
+  for (const auto &op : compiled_model.get_runtime_model()->get_ops()) {
+    const auto &rt_info = op->get_rt_info();
+    auto layer_type = rt_info.find(ov::exec_model_info::LAYER_TYPE);
+    if (layer_type == rt_info.end()) continue;
+    const std::string type = layer_type->second.as<std::string>();
+    if (type == "Input" || type == "Output" || type == "Const") continue;
+    report->runtime_model_ops++;
+    if (type == "Reorder") report->runtime_reorders++;
+  }
+}
+
+}  // namespace openvinodelegate
+}  // namespace tflite
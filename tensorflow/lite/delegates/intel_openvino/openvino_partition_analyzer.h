@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef DELEGATE_INTEL_OPENVINO_OPENVINO_PARTITION_ANALYZER_H_
+#define DELEGATE_INTEL_OPENVINO_OPENVINO_PARTITION_ANALYZER_H_
+
+#include <openvino/openvino.hpp>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "tensorflow/lite/c/c_api_opaque.h"
+#include "tensorflow/lite/c/common.h"
+
+namespace tflite {
+namespace openvinodelegate {
+
+// What a delegated partition costs and what conversion made of it. Counts
+// that were not computed are -1.
+struct PartitionReport {
+  int partition_index = 0;
+  // TfLite builtin ops of the partition by name, e.g. "CONV_2D".
+  std::map<std::string, int> tflite_ops;
+  // Multiply-adds count as two operations; elementwise ops as one per
+  // output element.
+  int64_t estimated_flops = 0;
+  // Copied between TfLite and OpenVINO tensors on every Eval.
+  int64_t input_bytes_per_eval = 0;
+  int64_t output_bytes_per_eval = 0;
+  // Operations of the converted ov::Model, and the Transpose and Convert
+  // operations conversion added on top of the TfLite TRANSPOSE, CAST,
+  // QUANTIZE and DEQUANTIZE ops.
+  int model_ops = -1;
+  int inserted_transposes = -1;
+  int inserted_converts = -1;
+  // Layers of the compiled model and the layout Reorders among them.
+  int runtime_model_ops = -1;
+  int runtime_reorders = -1;
+
+  std::string ToJson() const;
+};
+
+// Fills the TfLite part of |report|: ops, FLOPs and boundary bytes of the
+// partition described by |params|.
+TfLiteStatus AnalyzeTfLitePartition(TfLiteOpaqueContext *context,
+                                    const TfLiteOpaqueDelegateParams *params,
+                                    const std::vector<int> &compute_inputs,
+                                    const std::vector<int> &outputs,
+                                    PartitionReport *report);
+
+// Counts the operations of the converted |model| that have no TfLite
+// counterpart; call after AnalyzeTfLitePartition.
+void AnalyzeConvertedModel(const std::shared_ptr<ov::Model> &model,
+                           PartitionReport *report);
+
+// Counts the layers of the runtime model of |compiled_model|.
+void AnalyzeCompiledModel(const ov::CompiledModel &compiled_model,
+                          PartitionReport *report);
+
+}  // namespace openvinodelegate
+}  // namespace tflite
+
+#endif  // DELEGATE_INTEL_OPENVINO_OPENVINO_PARTITION_ANALYZER_H_
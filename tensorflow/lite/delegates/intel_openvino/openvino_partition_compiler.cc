@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "tensorflow/lite/delegates/intel_openvino/openvino_partition_compiler.h"
+
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace tflite {
+namespace openvinodelegate {
+
+PartitionParams::PartitionParams(const TfLiteOpaqueDelegateParams &params) {
+  params_.delegate = params.delegate;
+  params_.delegate_data = params.delegate_data;
+  params_.nodes_to_replace = TfLiteIntArrayCopy(params.nodes_to_replace);
+  params_.input_tensors = TfLiteIntArrayCopy(params.input_tensors);
+  params_.output_tensors = TfLiteIntArrayCopy(params.output_tensors);
+}
+
+PartitionParams::~PartitionParams() {
+  TfLiteIntArrayFree(params_.nodes_to_replace);
+  TfLiteIntArrayFree(params_.input_tensors);
+  TfLiteIntArrayFree(params_.output_tensors);
+}
+
+bool PartitionParams::Matches(const TfLiteOpaqueDelegateParams *params) const {
+  return TfLiteIntArrayEqual(params_.nodes_to_replace,
+                             params->nodes_to_replace) &&
+         TfLiteIntArrayEqual(params_.input_tensors, params->input_tensors) &&
+         TfLiteIntArrayEqual(params_.output_tensors, params->output_tensors);
+}
+
+PartitionCompiler::PartitionCompiler(int num_threads,
+                                     std::shared_ptr<Tracer> tracer)
+    : num_threads_(num_threads > 0
+                       ? num_threads
+                       : std::max(1u, std::thread::hardware_concurrency())),
+      tracer_(std::move(tracer)) {}
+
+PartitionCompiler::~PartitionCompiler() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  for (auto &worker : workers_) worker.join();
+}
+
+void PartitionCompiler::Schedule(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push_back(std::move(task));
+    // Threads are spawned lazily, never more than there are queued tasks.
+    if (workers_.size() < static_cast<size_t>(num_threads_) &&
+        workers_.size() < tasks_.size())
+      workers_.emplace_back(&PartitionCompiler::WorkerLoop, this);
+  }
+  cv_.notify_one();
+}
+
+void PartitionCompiler::WorkerLoop() {
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+      if (tasks_.empty()) return;
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+  }
+}
+
+TfLiteStatus PartitionCompiler::CompilePartitions(
+    TfLiteOpaqueContext *context, const std::vector<int> &supported_nodes,
+    const TfLiteOpenVINODelegateOptions &options) {
+  if (context == nullptr) return kTfLiteError;
+  // Jobs nobody picked up belong to an earlier delegation attempt. They keep
+  // themselves alive until their task finished.
+  jobs_.clear();
+  if (supported_nodes.empty()) return kTfLiteOk;
+
+  TfLiteIntArray *nodes = TfLiteIntArrayCreate(supported_nodes.size());
+  std::copy(supported_nodes.begin(), supported_nodes.end(), nodes->data);
+  TfLiteOpaqueDelegateParams *partition_params_array = nullptr;
+  int num_partitions = 0;
+  TfLiteStatus status = TfLiteOpaqueContextPreviewDelegatePartitioning(
+      context, nodes, &partition_params_array, &num_partitions);
+  TfLiteIntArrayFree(nodes);
+  if (status != kTfLiteOk) return status;
+
+  for (int i = 0; i < num_partitions; i++) {
+    const TfLiteOpaqueDelegateParams &params = partition_params_array[i];
+    if (params.nodes_to_replace->size == 0) continue;
+    auto job = std::make_shared<PartitionCompileJob>();
+    job->partition_index = i;
+    job->params = std::make_unique<PartitionParams>(params);
+    job->core = std::make_unique<OpenVINODelegateCore>(
+        GetSharedCore(options.plugins_path), /*partition_index=*/i);
+    job->core->SetTracer(tracer_);
+    try {
+      job->converted = job->core->Init(options.device_type);
+      if (job->converted == kTfLiteOk)
+        job->converted =
+            job->core->CreateModel(context, job->params->get(), &options);
+    } catch (const std::exception &e) {
+      job->converted = kTfLiteError;
+    }
+
+    auto compiled = std::make_shared<std::promise<TfLiteStatus>>();
+    job->compiled = compiled->get_future().share();
+    if (job->converted != kTfLiteOk) {
+      compiled->set_value(job->converted);
+    } else {
+      Schedule([job, compiled]() {
+        TfLiteStatus status = kTfLiteError;
+        try {
+          status = job->core->CompileAndInfer();
+        } catch (const std::exception &e) {
+          status = kTfLiteError;
+        }
+        compiled->set_value(status);
+      });
+    }
+    jobs_[params.nodes_to_replace->data[0]] = std::move(job);
+  }
+  return kTfLiteOk;
+}
+
+std::shared_ptr<ov::Core> PartitionCompiler::GetSharedCore(
+    const std::string &plugins_path) {
+  std::lock_guard<std::mutex> lock(core_mutex_);
+  if (ov_core_ == nullptr) {
+    ScopedTrace trace(tracer_.get(), "CreateOVCore", kTraceStartup);
+    ov_core_ = CreateOVCore(plugins_path);
+  }
+  return ov_core_;
+}
+
+std::shared_ptr<PartitionCompileJob> PartitionCompiler::TakeJob(
+    const TfLiteOpaqueDelegateParams *params) {
+  if (params == nullptr || params->nodes_to_replace->size == 0) return nullptr;
+  auto it = jobs_.find(params->nodes_to_replace->data[0]);
+  if (it == jobs_.end()) return nullptr;
+  std::shared_ptr<PartitionCompileJob> job = std::move(it->second);
+  jobs_.erase(it);
+  return job->params->Matches(params) ? job : nullptr;
+}
+
+}  // namespace openvinodelegate
+}  // namespace tflite
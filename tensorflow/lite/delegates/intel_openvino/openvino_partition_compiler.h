@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef DELEGATE_INTEL_OPENVINO_OPENVINO_PARTITION_COMPILER_H_
+#define DELEGATE_INTEL_OPENVINO_OPENVINO_PARTITION_COMPILER_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "tensorflow/lite/c/c_api_opaque.h"
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_delegate.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_delegate_core.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_tracer.h"
+
+namespace tflite {
+namespace openvinodelegate {
+
+// Owned copy of the TfLiteOpaqueDelegateParams of one partition. The arrays
+// returned by TfLiteOpaqueContextPreviewDelegatePartitioning are only valid
+// until the delegate's Prepare returns, while compilation outlives it.
+class PartitionParams {
+ public:
+  explicit PartitionParams(const TfLiteOpaqueDelegateParams &params);
+  ~PartitionParams();
+
+  PartitionParams(const PartitionParams &) = delete;
+  PartitionParams &operator=(const PartitionParams &) = delete;
+
+  const TfLiteOpaqueDelegateParams *get() const { return &params_; }
+  bool Matches(const TfLiteOpaqueDelegateParams *params) const;
+
+ private:
+  TfLiteOpaqueDelegateParams params_;
+};
+
+// Conversion and compilation of a single partition. Conversion ran on the
+// delegate's thread; compilation runs on the pool.
+struct PartitionCompileJob {
+  int partition_index = 0;
+  std::unique_ptr<PartitionParams> params;
+  std::unique_ptr<OpenVINODelegateCore> core;
+  // Status of plugin initialization and conversion.
+  TfLiteStatus converted = kTfLiteError;
+  // Ready once compile_model has produced an infer request.
+  std::shared_future<TfLiteStatus> compiled;
+};
+
+// Compiles all delegated partitions concurrently on a small worker pool, so
+// that model startup costs the slowest compile_model instead of the sum of
+// all of them. Kernels pick up their job in Init.
+class PartitionCompiler {
+ public:
+  // Partitions record their phases to |tracer|, which may be null.
+  explicit PartitionCompiler(int num_threads,
+                             std::shared_ptr<Tracer> tracer = nullptr);
+  ~PartitionCompiler();
+
+  // Previews the partitioning of |supported_nodes| and converts every
+  // partition on the calling thread: the TfLite context is not thread-safe,
+  // so nothing that reads it may run on the pool. Then schedules
+  // compile_model of each converted partition and returns without waiting.
+  TfLiteStatus CompilePartitions(TfLiteOpaqueContext *context,
+                                 const std::vector<int> &supported_nodes,
+                                 const TfLiteOpenVINODelegateOptions &options);
+
+  // Hands over the job created for the partition described by |params|, or
+  // nullptr if none was scheduled for it.
+  std::shared_ptr<PartitionCompileJob> TakeJob(
+      const TfLiteOpaqueDelegateParams *params);
+
+  // ov::Core shared by all partitions of the delegate, created on first use.
+  // Registering the plugins and loading the device plugin happens only once
+  // instead of once per partition.
+  std::shared_ptr<ov::Core> GetSharedCore(const std::string &plugins_path);
+
+ private:
+  void Schedule(std::function<void()> task);
+  void WorkerLoop();
+
+  int num_threads_;
+  std::shared_ptr<Tracer> tracer_;
+  std::vector<std::thread> workers_;
+  std::deque<std::function<void()>> tasks_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stop_ = false;
+  // Pending jobs keyed by the first node id of their partition.
+  std::map<int, std::shared_ptr<PartitionCompileJob>> jobs_;
+  std::mutex core_mutex_;
+  std::shared_ptr<ov::Core> ov_core_;
+};
+
+}  // namespace openvinodelegate
+}  // namespace tflite
+
+#endif  // DELEGATE_INTEL_OPENVINO_OPENVINO_PARTITION_COMPILER_H_
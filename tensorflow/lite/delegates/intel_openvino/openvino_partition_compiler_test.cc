@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "tensorflow/lite/delegates/intel_openvino/openvino_partition_compiler.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "tensorflow/lite/delegates/intel_openvino/openvino_test_model_builder.h"
+#include "tensorflow/lite/delegates/utils/simple_opaque_delegate.h"
+#include "tensorflow/lite/interpreter.h"
+#include "tensorflow/lite/model_builder.h"
+
+/* Conversion and concurrent compilation of several partitions */
+
+namespace tflite {
+namespace openvinodelegate {
+namespace {
+
+constexpr int kNumPartitions = 3;
+
+// ADD -> FLOOR -> ADD -> FLOOR -> ADD. Only ADD is delegated, so every ADD
+// is a partition of its own.
+std::vector<char> BuildSplitAddModel() {
+  const std::vector<int32_t> shape = {1, 8, 8, 4};
+  TestModelBuilder builder;
+  const int input0 = builder.AddTensor(shape, TensorType_FLOAT32);
+  const int input1 = builder.AddTensor(shape, TensorType_FLOAT32);
+  int previous = input0;
+  for (int i = 0; i < kNumPartitions; i++) {
+    const int sum = builder.AddTensor(shape, TensorType_FLOAT32);
+    builder.AddOperator(BuiltinOperator_ADD, {previous, input1}, {sum},
+                        BuiltinOptions_AddOptions,
+                        CreateAddOptions(builder.builder()).Union());
+    previous = sum;
+    if (i == kNumPartitions - 1) break;
+    const int floor = builder.AddTensor(shape, TensorType_FLOAT32);
+    builder.AddOperator(BuiltinOperator_FLOOR, {previous}, {floor});
+    previous = floor;
+  }
+  return builder.Finish({input0, input1}, {previous});
+}
+
+// What a kernel saw of its job in Init.
+struct TakenJob {
+  std::shared_ptr<PartitionCompileJob> job;
+  // A second TakeJob for the same partition found nothing.
+  bool taken_once = false;
+};
+
+class JobKernel : public SimpleOpaqueDelegateKernelInterface {
+ public:
+  JobKernel(PartitionCompiler *compiler, std::vector<TakenJob> *taken_jobs)
+      : compiler_(compiler), taken_jobs_(taken_jobs) {}
+
+  TfLiteStatus Init(TfLiteOpaqueContext *context,
+                    const TfLiteOpaqueDelegateParams *params) override {
+    TakenJob taken;
+    taken.job = compiler_->TakeJob(params);
+    if (taken.job == nullptr) return kTfLiteError;
+    taken.taken_once = compiler_->TakeJob(params) == nullptr;
+    taken_jobs_->push_back(taken);
+    return kTfLiteOk;
+  }
+
+  TfLiteStatus Prepare(TfLiteOpaqueContext *context,
+                       TfLiteOpaqueNode *node) override {
+    return kTfLiteOk;
+  }
+
+  TfLiteStatus Eval(TfLiteOpaqueContext *context,
+                    TfLiteOpaqueNode *node) override {
+    return kTfLiteError;
+  }
+
+ private:
+  PartitionCompiler *compiler_;
+  std::vector<TakenJob> *taken_jobs_;
+};
+
+// Hands every ADD to |compiler| in Initialize, the way OpenVINODelegate
+// does, and lets the kernels take the jobs.
+class CompilerDelegate : public SimpleOpaqueDelegateInterface {
+ public:
+  CompilerDelegate(PartitionCompiler *compiler,
+                   std::vector<TakenJob> *taken_jobs)
+      : compiler_(compiler), taken_jobs_(taken_jobs) {}
+
+  bool IsNodeSupportedByDelegate(const TfLiteRegistrationExternal *registration,
+                                 const TfLiteOpaqueNode *node,
+                                 TfLiteOpaqueContext *context) const override {
+    return TfLiteRegistrationExternalGetBuiltInCode(registration) ==
+           kTfLiteBuiltinAdd;
+  }
+
+  TfLiteStatus Initialize(TfLiteOpaqueContext *context) override {
+    TfLiteIntArray *execution_plan;
+    if (TfLiteOpaqueContextGetExecutionPlan(context, &execution_plan) !=
+        kTfLiteOk)
+      return kTfLiteError;
+    std::vector<int> supported_nodes;
+    for (int i = 0; i < execution_plan->size; i++) {
+      TfLiteOpaqueNode *node;
+      TfLiteRegistrationExternal *registration;
+      if (TfLiteOpaqueContextGetNodeAndRegistration(
+              context, execution_plan->data[i], &node, &registration) ==
+              kTfLiteOk &&
+          IsNodeSupportedByDelegate(registration, node, context))
+        supported_nodes.push_back(execution_plan->data[i]);
+    }
+    return compiler_->CompilePartitions(context, supported_nodes, options_);
+  }
+
+  const char *Name() const override { return "PartitionCompilerTestDelegate"; }
+
+  std::unique_ptr<SimpleOpaqueDelegateKernelInterface>
+  CreateDelegateKernelInterface() override {
+    return std::make_unique<JobKernel>(compiler_, taken_jobs_);
+  }
+
+ private:
+  TfLiteOpenVINODelegateOptions options_;
+  PartitionCompiler *compiler_;
+  std::vector<TakenJob> *taken_jobs_;
+};
+
+void CompileAllPartitions(int num_threads) {
+  const std::vector<char> model_data = BuildSplitAddModel();
+  std::unique_ptr<FlatBufferModel> model =
+      FlatBufferModel::BuildFromBuffer(model_data.data(), model_data.size());
+  ASSERT_NE(model, nullptr);
+
+  PartitionCompiler compiler(num_threads);
+  std::vector<TakenJob> taken_jobs;
+  TfLiteOpaqueDelegateUniquePtr delegate =
+      TfLiteOpaqueDelegateFactory::Create(
+          std::make_unique<CompilerDelegate>(&compiler, &taken_jobs));
+  std::unique_ptr<Interpreter> interpreter =
+      BuildInterpreter(*model, delegate.get());
+  ASSERT_NE(interpreter, nullptr);
+  // Three delegate kernels and the two FLOORs between them.
+  EXPECT_EQ(5u, interpreter->execution_plan().size());
+
+  ASSERT_EQ(static_cast<size_t>(kNumPartitions), taken_jobs.size());
+  std::set<int> partition_indices;
+  for (const TakenJob &taken : taken_jobs) {
+    SCOPED_TRACE(taken.job->partition_index);
+    partition_indices.insert(taken.job->partition_index);
+    // Conversions read the TfLite context, so they run on the delegate's
+    // thread; only compile_model goes to the pool.
+    EXPECT_EQ(kTfLiteOk, taken.job->converted);
+    EXPECT_TRUE(taken.taken_once);
+    ASSERT_EQ(kTfLiteOk, taken.job->compiled.get());
+    ASSERT_NE(taken.job->core, nullptr);
+    EXPECT_EQ(2u, taken.job->core->getCompiledModel().inputs().size());
+  }
+  EXPECT_EQ(static_cast<size_t>(kNumPartitions), partition_indices.size());
+}
+
+TEST(PartitionCompilerTest, CompilesPartitionsConcurrently) {
+  CompileAllPartitions(kNumPartitions);
+}
+
+TEST(PartitionCompilerTest, SingleWorkerCompilesEveryPartition) {
+  CompileAllPartitions(1);
+}
+
+}  // namespace
+}  // namespace openvinodelegate
+}  // namespace tflite
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,213 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "tensorflow/lite/delegates/intel_openvino/openvino_precision_tuner.h"
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <fstream>
+#include <map>
+
+#include "tensorflow/lite/delegates/intel_openvino/openvino_calibrator.h"
+#include "tensorflow/lite/delegates/intel_openvino/operations/utility.h"
+#include "tensorflow/lite/tools/logging.h"
+
+namespace tflite {
+namespace openvinodelegate {
+
+namespace {
+
+constexpr char kInferencePrecisionKey[] = "inference_precision";
+constexpr char kF32LayerKey[] = "f32";
+
+// Layers whose precision can be chosen: every op producing an f32 tensor.
+bool IsCandidate(const std::shared_ptr<ov::Node> &op) {
+  if (ov::is_type<ov::op::v0::Parameter>(op) ||
+      ov::is_type<ov::op::v0::Constant>(op) ||
+      ov::is_type<ov::op::v0::Result>(op) || op->get_output_size() == 0)
+    return false;
+  return op->get_output_element_type(0) == ov::element::f32 &&
+         op->get_output_partial_shape(0).is_static();
+}
+
+double MaxAbsError(const ov::Tensor &expected, const ov::Tensor &actual) {
+  if (expected.get_element_type() != ov::element::f32 ||
+      actual.get_element_type() != ov::element::f32 ||
+      expected.get_size() != actual.get_size())
+    return 0;
+  const float *expected_data = expected.data<float>();
+  const float *actual_data = actual.data<float>();
+  double error = 0;
+  for (size_t i = 0; i < expected.get_size(); i++) {
+    error = std::max<double>(error,
+                             std::fabs(expected_data[i] - actual_data[i]));
+  }
+  return error;
+}
+
+double MaxAbs(const ov::Tensor &tensor) {
+  if (tensor.get_element_type() != ov::element::f32) return 0;
+  const float *data = tensor.data<float>();
+  double value = 0;
+  for (size_t i = 0; i < tensor.get_size(); i++)
+    value = std::max<double>(value, std::fabs(data[i]));
+  return value;
+}
+
+}  // namespace
+
+TfLiteStatus SavePrecisionMap(const PrecisionMap &map,
+                              const std::string &path) {
+  std::ofstream file(path);
+  if (!file) return kTfLiteError;
+  file << kInferencePrecisionKey << " " << map.inference_precision << "\n";
+  for (const std::string &layer : map.f32_layers)
+    file << kF32LayerKey << " " << layer << "\n";
+  return file ? kTfLiteOk : kTfLiteError;
+}
+
+TfLiteStatus LoadPrecisionMap(const std::string &path, PrecisionMap *map) {
+  std::ifstream file(path);
+  if (!file || map == nullptr) return kTfLiteError;
+  PrecisionMap loaded;
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.empty()) continue;
+    // Layer names may contain spaces; everything after the key is the value.
+    const size_t separator = line.find(' ');
+    if (separator == std::string::npos) return kTfLiteError;
+    const std::string key = line.substr(0, separator);
+    const std::string value = line.substr(separator + 1);
+    if (key == kInferencePrecisionKey) {
+      loaded.inference_precision = value;
+    } else if (key == kF32LayerKey) {
+      loaded.f32_layers.insert(value);
+    } else {
+      return kTfLiteError;
+    }
+  }
+  *map = loaded;
+  return kTfLiteOk;
+}
+
+void ApplyPrecisionMap(const std::shared_ptr<ov::Model> &model,
+                       const PrecisionMap &map) {
+  if (map.f32_layers.empty()) return;
+  for (const auto &op : model->get_ordered_ops()) {
+    if (map.f32_layers.count(op->get_friendly_name()) != 0) KeepInF32(op);
+  }
+}
+
+TfLiteStatus PrecisionTuner::Tune(
+    const std::shared_ptr<ov::Model> &model,
+    const std::vector<int> &input_tensors,
+    const TfLiteOpenVINORepresentativeDataset &dataset, int max_samples,
+    const std::string &inference_precision, double max_error,
+    PrecisionMap *map, PrecisionTuningReport *report) {
+  if (model == nullptr || !dataset || map == nullptr || report == nullptr)
+    return kTfLiteError;
+  *report = PrecisionTuningReport();
+  ov::element::Type precision;
+  try {
+    precision = ov::element::Type(inference_precision);
+  } catch (const std::exception &e) {
+    TFLITE_LOG(ERROR) << "Unknown inference precision " << inference_precision;
+    return kTfLiteError;
+  }
+
+  std::vector<std::vector<ov::Tensor>> samples =
+      LoadRepresentativeSamples(model, input_tensors, dataset, max_samples);
+  if (samples.empty()) return kTfLiteError;
+
+  // Expose the output of every candidate layer as an extra result.
+  std::vector<std::shared_ptr<ov::Node>> layers;
+  std::map<const ov::Node *, size_t> layer_index;
+  for (const auto &op : model->get_ordered_ops()) {
+    if (!IsCandidate(op)) continue;
+    layer_index[op.get()] = layers.size();
+    layers.push_back(op);
+  }
+  const size_t num_outputs = model->get_results().size();
+  ov::ResultVector probes;
+  for (const auto &layer : layers)
+    probes.push_back(std::make_shared<ov::op::v0::Result>(layer->output(0)));
+  model->add_results(probes);
+
+  PrecisionMap tuned;
+  tuned.inference_precision = inference_precision;
+  TfLiteStatus status = kTfLiteOk;
+  try {
+    ov::CompiledModel reference_model = ov_core_->compile_model(
+        model, device_type_, ov::hint::inference_precision(ov::element::f32));
+    std::vector<std::vector<ov::Tensor>> reference =
+        RunSamples(reference_model, samples);
+
+    while (true) {
+      ApplyPrecisionMap(model, tuned);
+      ov::CompiledModel compiled_model = ov_core_->compile_model(
+          model, device_type_, ov::hint::inference_precision(precision));
+      std::vector<std::vector<ov::Tensor>> results =
+          RunSamples(compiled_model, samples);
+      report->iterations++;
+
+      double output_error = 0;
+      std::vector<double> layer_error(layers.size(), 0);
+      for (size_t s = 0; s < samples.size(); s++) {
+        for (size_t o = 0; o < num_outputs; o++) {
+          output_error = std::max(
+              output_error, MaxAbsError(reference[s][o], results[s][o]));
+        }
+        for (size_t l = 0; l < layers.size(); l++) {
+          const ov::Tensor &expected = reference[s][num_outputs + l];
+          const double relative_error =
+              MaxAbsError(expected, results[s][num_outputs + l]) /
+              std::max(MaxAbs(expected), 1e-6);
+          layer_error[l] = std::max(layer_error[l], relative_error);
+        }
+      }
+      report->max_abs_error = output_error;
+      if (output_error <= max_error) {
+        report->threshold_met = true;
+        break;
+      }
+
+      // Raise the layer that adds the most error to what it receives.
+      double worst_added_error = -1;
+      const ov::Node *worst_layer = nullptr;
+      for (size_t l = 0; l < layers.size(); l++) {
+        if (tuned.f32_layers.count(layers[l]->get_friendly_name()) != 0)
+          continue;
+        double input_error = 0;
+        for (const auto &input : layers[l]->input_values()) {
+          auto it = layer_index.find(input.get_node());
+          if (it != layer_index.end())
+            input_error = std::max(input_error, layer_error[it->second]);
+        }
+        const double added_error = layer_error[l] - input_error;
+        if (added_error > worst_added_error) {
+          worst_added_error = added_error;
+          worst_layer = layers[l].get();
+        }
+      }
+      if (worst_layer == nullptr) break;
+      tuned.f32_layers.insert(worst_layer->get_friendly_name());
+    }
+  } catch (const std::exception &e) {
+    TFLITE_LOG(ERROR) << "Precision tuning failed: " << e.what();
+    status = kTfLiteError;
+  }
+  for (const auto &probe : probes) model->remove_result(probe);
+  if (status != kTfLiteOk) return status;
+
+  report->samples = samples.size();
+  report->candidate_layers = layers.size();
+  report->f32_layers = tuned.f32_layers.size();
+  *map = tuned;
+  return kTfLiteOk;
+}
+
+}  // namespace openvinodelegate
+}  // namespace tflite
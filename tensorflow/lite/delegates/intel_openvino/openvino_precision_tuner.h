@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef DELEGATE_INTEL_OPENVINO_OPENVINO_PRECISION_TUNER_H_
+#define DELEGATE_INTEL_OPENVINO_OPENVINO_PRECISION_TUNER_H_
+
+#include <openvino/openvino.hpp>
+
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_delegate.h"
+
+namespace tflite {
+namespace openvinodelegate {
+
+// Per-layer precision of one partition: the model runs in
+// |inference_precision| except for the layers in |f32_layers|, identified by
+// their friendly names.
+struct PrecisionMap {
+  std::string inference_precision;
+  std::set<std::string> f32_layers;
+};
+
+// Writes |map| as text to |path|.
+TfLiteStatus SavePrecisionMap(const PrecisionMap &map, const std::string &path);
+
+// Reads a map written by SavePrecisionMap. Returns kTfLiteError if |path| is
+// missing or malformed.
+TfLiteStatus LoadPrecisionMap(const std::string &path, PrecisionMap *map);
+
+// Keeps the layers of |map| in f32 when |model| is compiled.
+void ApplyPrecisionMap(const std::shared_ptr<ov::Model> &model,
+                       const PrecisionMap &map);
+
+// Outcome of tuning one partition.
+struct PrecisionTuningReport {
+  int samples = 0;
+  // Compile and run rounds, including the one with no f32 layers.
+  int iterations = 0;
+  int candidate_layers = 0;
+  int f32_layers = 0;
+  // Output error of the tuned partition against f32.
+  double max_abs_error = -1;
+  bool threshold_met = false;
+};
+
+// Accuracy-aware mixed precision. The partition is run over the validation
+// samples in f32 and in the reduced precision with every layer output exposed
+// as an extra result. While the outputs are off by more than the threshold,
+// the layer that adds the most relative error on top of its inputs is raised
+// back to f32 and the partition is run again.
+class PrecisionTuner {
+ public:
+  PrecisionTuner(std::shared_ptr<ov::Core> ov_core, std::string device_type)
+      : ov_core_(std::move(ov_core)), device_type_(std::move(device_type)) {}
+
+  // Tunes |model| for |inference_precision| and fills |map|. |input_tensors|
+  // are the TfLite tensors the model parameters are fed from, in order.
+  TfLiteStatus Tune(const std::shared_ptr<ov::Model> &model,
+                    const std::vector<int> &input_tensors,
+                    const TfLiteOpenVINORepresentativeDataset &dataset,
+                    int max_samples, const std::string &inference_precision,
+                    double max_error, PrecisionMap *map,
+                    PrecisionTuningReport *report);
+
+ private:
+  std::shared_ptr<ov::Core> ov_core_;
+  std::string device_type_;
+};
+
+}  // namespace openvinodelegate
+}  // namespace tflite
+
+#endif  // DELEGATE_INTEL_OPENVINO_OPENVINO_PRECISION_TUNER_H_
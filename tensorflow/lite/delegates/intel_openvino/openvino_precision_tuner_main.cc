@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// Offline mixed-precision tuning. Runs a validation set through every
+// partition the OpenVINO delegate takes from a model, keeps the layers that
+// lose too much accuracy in the reduced precision in f32, and stores the
+// per-layer precision map in the delegate's cache directory, where the
+// delegate picks it up at compile time.
+//
+// The validation set is a raw file of float32 samples, each the model inputs
+// one after the other in input order.
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "tensorflow/lite/delegates/intel_openvino/openvino_delegate.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_delegate_core.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_precision_tuner.h"
+#include "tensorflow/lite/delegates/utils/simple_opaque_delegate.h"
+#include "tensorflow/lite/interpreter.h"
+#include "tensorflow/lite/interpreter_builder.h"
+#include "tensorflow/lite/kernels/register.h"
+#include "tensorflow/lite/model_builder.h"
+#include "tensorflow/lite/tools/command_line_flags.h"
+#include "tensorflow/lite/tools/logging.h"
+
+namespace tflite {
+namespace openvinodelegate {
+namespace {
+
+// Serves the value of any tensor of a validation sample by running the
+// sample through the builtin kernels, so interior partitions are tuned on
+// the activations they actually receive.
+class ValidationSet {
+ public:
+  bool Init(const FlatBufferModel &model, const std::string &path) {
+    ops::builtin::BuiltinOpResolver resolver;
+    InterpreterOptions options;
+    options.SetPreserveAllTensors(true);
+    if (InterpreterBuilder(model, resolver, &options)(&reference_) !=
+            kTfLiteOk ||
+        reference_->AllocateTensors() != kTfLiteOk)
+      return false;
+    for (int input : reference_->inputs()) {
+      if (reference_->tensor(input)->type != kTfLiteFloat32) return false;
+      sample_bytes_ += reference_->tensor(input)->bytes;
+    }
+    std::ifstream file(path, std::ios::binary);
+    data_.assign(std::istreambuf_iterator<char>(file),
+                 std::istreambuf_iterator<char>());
+    return sample_bytes_ > 0 && !data_.empty() &&
+           data_.size() % sample_bytes_ == 0;
+  }
+
+  int size() const { return data_.size() / sample_bytes_; }
+
+  bool Get(int sample_index, int tensor_index, void *data, size_t bytes) {
+    if (sample_index >= size()) return false;
+    if (sample_index != current_sample_) {
+      const char *sample = data_.data() + sample_index * sample_bytes_;
+      for (int input : reference_->inputs()) {
+        TfLiteTensor *tensor = reference_->tensor(input);
+        std::memcpy(tensor->data.raw, sample, tensor->bytes);
+        sample += tensor->bytes;
+      }
+      if (reference_->Invoke() != kTfLiteOk) return false;
+      current_sample_ = sample_index;
+    }
+    const TfLiteTensor *tensor = reference_->tensor(tensor_index);
+    if (tensor == nullptr || tensor->bytes != bytes) return false;
+    std::memcpy(data, tensor->data.raw, bytes);
+    return true;
+  }
+
+ private:
+  std::unique_ptr<Interpreter> reference_;
+  std::vector<char> data_;
+  size_t sample_bytes_ = 0;
+  int current_sample_ = -1;
+};
+
+int Run(int argc, char **argv) {
+  std::string graph;
+  std::string validation_data;
+  TfLiteOpenVINODelegateOptions options;
+  options.inference_precision = "bf16";
+  std::vector<Flag> flags = {
+      Flag::CreateFlag("graph", &graph, "TfLite model to tune."),
+      Flag::CreateFlag("validation_data", &validation_data,
+                       "Raw float32 file of validation samples."),
+      Flag::CreateFlag("cache_dir", &options.cache_dir,
+                       "Delegate cache directory the maps are saved to."),
+      Flag::CreateFlag("model_token", &options.model_token,
+                       "Model token the delegate is later run with."),
+      Flag::CreateFlag("device_type", &options.device_type,
+                       "OpenVINO device to tune for."),
+      Flag::CreateFlag("inference_precision", &options.inference_precision,
+                       "Reduced precision to tune: bf16 or f16."),
+      Flag::CreateFlag("max_error", &options.max_precision_error,
+                       "Largest absolute output error against f32."),
+      Flag::CreateFlag("num_samples", &options.validation_samples,
+                       "Upper bound on the validation samples used."),
+  };
+  if (!Flags::Parse(&argc, const_cast<const char **>(argv), flags) ||
+      graph.empty() || validation_data.empty() || options.cache_dir.empty() ||
+      options.model_token.empty()) {
+    TFLITE_LOG(ERROR) << Flags::Usage(argv[0], flags);
+    return 1;
+  }
+
+  std::unique_ptr<FlatBufferModel> model =
+      FlatBufferModel::BuildFromFile(graph.c_str());
+  if (model == nullptr) return 1;
+  ValidationSet validation_set;
+  if (!validation_set.Init(*model, validation_data)) {
+    TFLITE_LOG(ERROR) << "Could not read validation samples for " << graph;
+    return 1;
+  }
+  options.validation_dataset = [&validation_set](int sample_index,
+                                                 int tensor_index, void *data,
+                                                 size_t bytes) {
+    return validation_set.Get(sample_index, tensor_index, data, bytes);
+  };
+
+  // Tuned entries are loaded instead of tuned again; start from scratch.
+  std::filesystem::create_directories(options.cache_dir);
+  for (int partition = 0;; partition++) {
+    if (!std::filesystem::exists(GetCacheEntryPath(options, partition, ".xml")))
+      break;
+    for (const char *extension : {".xml", ".bin", ".precision"})
+      std::filesystem::remove(GetCacheEntryPath(options, partition, extension));
+  }
+
+  TfLiteOpaqueDelegateUniquePtr delegate =
+      TfLiteOpaqueDelegateFactory::Create(
+          std::make_unique<OpenVINODelegate>(&options));
+  ops::builtin::BuiltinOpResolver resolver;
+  InterpreterBuilder builder(*model, resolver);
+  builder.AddDelegate(delegate.get());
+  std::unique_ptr<Interpreter> interpreter;
+  if (builder(&interpreter) != kTfLiteOk) return 1;
+
+  int partitions = 0;
+  for (;; partitions++) {
+    const std::string entry =
+        GetCacheEntryPath(options, partitions, ".precision");
+    PrecisionMap map;
+    if (LoadPrecisionMap(entry, &map) != kTfLiteOk) break;
+    std::cout << entry << ": " << map.f32_layers.size()
+              << " layers in f32, the rest in " << map.inference_precision
+              << "\n";
+  }
+  if (partitions == 0) {
+    TFLITE_LOG(ERROR) << "No partition was tuned";
+    return 1;
+  }
+  return 0;
+}
+
+}  // namespace
+}  // namespace openvinodelegate
+}  // namespace tflite
+
+int main(int argc, char **argv) {
+  return tflite::openvinodelegate::Run(argc, argv);
+}
@@ -0,0 +1,226 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "tensorflow/lite/delegates/intel_openvino/openvino_runtime_tuner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "tensorflow/lite/tools/logging.h"
+
+namespace tflite {
+namespace openvinodelegate {
+
+namespace {
+
+constexpr char kFingerprintKey[] = "fingerprint";
+constexpr char kPerformanceModeKey[] = "performance_mode";
+constexpr char kNumStreamsKey[] = "num_streams";
+constexpr char kNumThreadsKey[] = "inference_num_threads";
+constexpr char kCpuPinningKey[] = "enable_cpu_pinning";
+
+std::string GetCpuModelName() {
+  std::ifstream cpuinfo("/proc/cpuinfo");
+  std::string line;
+  while (std::getline(cpuinfo, line)) {
+    if (line.rfind("model name", 0) != 0) continue;
+    const size_t colon = line.find(':');
+    if (colon != std::string::npos) return line.substr(colon + 2);
+  }
+  return "unknown";
+}
+
+// Candidates of the sweep. LATENCY runs a single stream; THROUGHPUT lets the
+// hint pick the streams or uses a fixed count.
+std::vector<RuntimeConfig> GetCandidateConfigs(int num_cores) {
+  std::set<int> threads = {0, std::max(1, num_cores / 2), num_cores};
+  std::vector<int> streams = {0};
+  for (int count : {2, 4}) {
+    if (count <= num_cores) streams.push_back(count);
+  }
+  std::vector<RuntimeConfig> candidates;
+  for (bool pinning : {true, false}) {
+    for (int num_threads : threads) {
+      RuntimeConfig config;
+      config.performance_mode = "LATENCY";
+      config.num_streams = 1;
+      config.inference_num_threads = num_threads;
+      config.enable_cpu_pinning = pinning;
+      candidates.push_back(config);
+      for (int num_streams : streams) {
+        config.performance_mode = "THROUGHPUT";
+        config.num_streams = num_streams;
+        candidates.push_back(config);
+      }
+    }
+  }
+  return candidates;
+}
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+// Times |compiled_model| on zero-filled inputs.
+void Measure(ov::CompiledModel &compiled_model, int iterations,
+             RuntimeTuningReport *measurement) {
+  const uint32_t num_requests = std::max<uint32_t>(
+      1, compiled_model.get_property(ov::optimal_number_of_infer_requests));
+  std::vector<ov::InferRequest> requests;
+  for (uint32_t r = 0; r < num_requests; r++) {
+    requests.push_back(compiled_model.create_infer_request());
+    for (const auto &input : compiled_model.inputs()) {
+      ov::Tensor tensor = requests.back().get_tensor(input);
+      std::memset(tensor.data(), 0, tensor.get_byte_size());
+    }
+  }
+
+  // The delegate runs one request at a time; that is the latency to beat.
+  requests[0].infer();
+  std::vector<double> latencies;
+  for (int i = 0; i < iterations; i++) {
+    auto start = std::chrono::steady_clock::now();
+    requests[0].infer();
+    latencies.push_back(MillisecondsSince(start));
+  }
+  std::nth_element(latencies.begin(),
+                   latencies.begin() + latencies.size() / 2, latencies.end());
+  measurement->latency_ms = latencies[latencies.size() / 2];
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++) {
+    for (auto &request : requests) request.start_async();
+    for (auto &request : requests) request.wait();
+  }
+  measurement->throughput_fps =
+      1000.0 * iterations * num_requests / MillisecondsSince(start);
+}
+
+}  // namespace
+
+ov::AnyMap RuntimeConfig::ToAnyMap() const {
+  ov::AnyMap config = {
+      ov::hint::performance_mode(performance_mode == "THROUGHPUT"
+                                     ? ov::hint::PerformanceMode::THROUGHPUT
+                                     : ov::hint::PerformanceMode::LATENCY),
+      ov::hint::enable_cpu_pinning(enable_cpu_pinning)};
+  if (num_streams > 0) config.insert(ov::num_streams(num_streams));
+  if (inference_num_threads > 0)
+    config.insert(ov::inference_num_threads(inference_num_threads));
+  return config;
+}
+
+std::string GetHostFingerprint(ov::Core &ov_core,
+                               const std::string &device_type) {
+  std::string device_name = device_type;
+  try {
+    device_name = ov_core.get_property(device_type, ov::device::full_name);
+  } catch (const std::exception &e) {
+    // Fall back to the device type alone.
+  }
+  return GetCpuModelName() + ";" +
+         std::to_string(std::thread::hardware_concurrency()) + " threads;" +
+         device_name + ";OpenVINO " + ov::get_openvino_version().buildNumber;
+}
+
+TfLiteStatus SaveRuntimeConfig(const RuntimeConfig &config,
+                               const std::string &fingerprint,
+                               const std::string &path) {
+  std::ofstream file(path);
+  if (!file) return kTfLiteError;
+  file << kFingerprintKey << " " << fingerprint << "\n"
+       << kPerformanceModeKey << " " << config.performance_mode << "\n"
+       << kNumStreamsKey << " " << config.num_streams << "\n"
+       << kNumThreadsKey << " " << config.inference_num_threads << "\n"
+       << kCpuPinningKey << " " << config.enable_cpu_pinning << "\n";
+  return file ? kTfLiteOk : kTfLiteError;
+}
+
+TfLiteStatus LoadRuntimeConfig(const std::string &path,
+                               const std::string &fingerprint,
+                               RuntimeConfig *config) {
+  std::ifstream file(path);
+  if (!file || config == nullptr) return kTfLiteError;
+  RuntimeConfig loaded;
+  bool host_matches = false;
+  std::string line;
+  try {
+    while (std::getline(file, line)) {
+      if (line.empty()) continue;
+      const size_t separator = line.find(' ');
+      if (separator == std::string::npos) return kTfLiteError;
+      const std::string key = line.substr(0, separator);
+      const std::string value = line.substr(separator + 1);
+      if (key == kFingerprintKey) {
+        host_matches = value == fingerprint;
+      } else if (key == kPerformanceModeKey) {
+        loaded.performance_mode = value;
+      } else if (key == kNumStreamsKey) {
+        loaded.num_streams = std::stoi(value);
+      } else if (key == kNumThreadsKey) {
+        loaded.inference_num_threads = std::stoi(value);
+      } else if (key == kCpuPinningKey) {
+        loaded.enable_cpu_pinning = std::stoi(value) != 0;
+      } else {
+        return kTfLiteError;
+      }
+    }
+  } catch (const std::exception &e) {
+    return kTfLiteError;
+  }
+  if (!host_matches) return kTfLiteError;
+  *config = loaded;
+  return kTfLiteOk;
+}
+
+TfLiteStatus RuntimeTuner::Tune(const std::shared_ptr<ov::Model> &model,
+                                const ov::AnyMap &base_config,
+                                bool optimize_throughput, int iterations,
+                                RuntimeConfig *best,
+                                RuntimeTuningReport *report) {
+  if (model == nullptr || best == nullptr || report == nullptr ||
+      iterations <= 0)
+    return kTfLiteError;
+  *report = RuntimeTuningReport();
+  const int num_cores =
+      std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  bool found = false;
+  for (const RuntimeConfig &candidate : GetCandidateConfigs(num_cores)) {
+    ov::AnyMap config = candidate.ToAnyMap();
+    config.insert(base_config.begin(), base_config.end());
+    RuntimeTuningReport measurement;
+    try {
+      ov::CompiledModel compiled_model =
+          ov_core_->compile_model(model, device_type_, config);
+      Measure(compiled_model, iterations, &measurement);
+    } catch (const std::exception &e) {
+      // Not every candidate is valid on every device.
+      TFLITE_LOG(INFO) << "Skipping runtime config: " << e.what();
+      continue;
+    }
+    report->candidates++;
+    const bool better =
+        !found || (optimize_throughput
+                       ? measurement.throughput_fps > report->throughput_fps
+                       : measurement.latency_ms < report->latency_ms);
+    if (!better) continue;
+    found = true;
+    *best = candidate;
+    report->latency_ms = measurement.latency_ms;
+    report->throughput_fps = measurement.throughput_fps;
+  }
+  return found ? kTfLiteOk : kTfLiteError;
+}
+
+}  // namespace openvinodelegate
+}  // namespace tflite
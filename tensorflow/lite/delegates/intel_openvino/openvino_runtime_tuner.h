@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef DELEGATE_INTEL_OPENVINO_OPENVINO_RUNTIME_TUNER_H_
+#define DELEGATE_INTEL_OPENVINO_OPENVINO_RUNTIME_TUNER_H_
+
+#include <openvino/openvino.hpp>
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "tensorflow/lite/c/common.h"
+
+namespace tflite {
+namespace openvinodelegate {
+
+// Execution settings of a compiled partition. 0 leaves a setting to the
+// plugin.
+struct RuntimeConfig {
+  // "LATENCY" or "THROUGHPUT".
+  std::string performance_mode = "LATENCY";
+  int num_streams = 0;
+  int inference_num_threads = 0;
+  bool enable_cpu_pinning = true;
+
+  ov::AnyMap ToAnyMap() const;
+};
+
+// Identifies the host a config was tuned on: CPU model, hardware threads,
+// target device and OpenVINO build.
+std::string GetHostFingerprint(ov::Core &ov_core,
+                               const std::string &device_type);
+
+// Writes |config| together with |fingerprint| as text to |path|.
+TfLiteStatus SaveRuntimeConfig(const RuntimeConfig &config,
+                               const std::string &fingerprint,
+                               const std::string &path);
+
+// Reads a config written by SaveRuntimeConfig. Returns kTfLiteError if
+// |path| is missing or malformed, or was tuned on a host other than
+// |fingerprint|.
+TfLiteStatus LoadRuntimeConfig(const std::string &path,
+                               const std::string &fingerprint,
+                               RuntimeConfig *config);
+
+// Outcome of tuning one partition.
+struct RuntimeTuningReport {
+  int candidates = 0;
+  // Median latency of one synchronous inference with the chosen config.
+  double latency_ms = -1;
+  // Inferences per second with all the config's infer requests in flight.
+  double throughput_fps = -1;
+};
+
+// Sweeps performance mode, streams, threads and pinning for a partition,
+// compiling it with each candidate and timing real infer requests.
+class RuntimeTuner {
+ public:
+  RuntimeTuner(std::shared_ptr<ov::Core> ov_core, std::string device_type)
+      : ov_core_(std::move(ov_core)), device_type_(std::move(device_type)) {}
+
+  // Picks the config with the lowest latency, or the highest throughput if
+  // |optimize_throughput|. |base_config| (e.g. the inference precision) is
+  // applied to every candidate.
+  TfLiteStatus Tune(const std::shared_ptr<ov::Model> &model,
+                    const ov::AnyMap &base_config, bool optimize_throughput,
+                    int iterations, RuntimeConfig *best,
+                    RuntimeTuningReport *report);
+
+ private:
+  std::shared_ptr<ov::Core> ov_core_;
+  std::string device_type_;
+};
+
+}  // namespace openvinodelegate
+}  // namespace tflite
+
+#endif  // DELEGATE_INTEL_OPENVINO_OPENVINO_RUNTIME_TUNER_H_
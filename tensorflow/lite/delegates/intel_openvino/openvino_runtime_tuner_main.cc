@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// Tunes the runtime settings of every partition the OpenVINO delegate takes
+// from a model: performance mode, streams, threads and CPU pinning are swept
+// with real infer requests and the best settings are written next to each
+// partition's cache entry. The delegate loads them whenever it runs the
+// model from the same cache_dir and model_token on a host with the same
+// fingerprint.
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "tensorflow/lite/delegates/intel_openvino/openvino_delegate.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_delegate_core.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_runtime_tuner.h"
+#include "tensorflow/lite/delegates/utils/simple_opaque_delegate.h"
+#include "tensorflow/lite/interpreter.h"
+#include "tensorflow/lite/interpreter_builder.h"
+#include "tensorflow/lite/kernels/register.h"
+#include "tensorflow/lite/model_builder.h"
+#include "tensorflow/lite/tools/command_line_flags.h"
+#include "tensorflow/lite/tools/logging.h"
+
+namespace tflite {
+namespace openvinodelegate {
+namespace {
+
+int Run(int argc, char **argv) {
+  std::string graph;
+  TfLiteOpenVINODelegateOptions options;
+  options.tune_runtime_config = true;
+  std::vector<Flag> flags = {
+      Flag::CreateFlag("graph", &graph, "TfLite model to tune."),
+      Flag::CreateFlag("cache_dir", &options.cache_dir,
+                       "Delegate cache directory the settings are saved to."),
+      Flag::CreateFlag("model_token", &options.model_token,
+                       "Model token the delegate is later run with."),
+      Flag::CreateFlag("device_type", &options.device_type,
+                       "OpenVINO device to tune for."),
+      Flag::CreateFlag("objective", &options.tuning_objective,
+                       "latency or throughput."),
+      Flag::CreateFlag("iterations", &options.tuning_iterations,
+                       "Inferences timed per candidate."),
+      Flag::CreateFlag("inference_precision", &options.inference_precision,
+                       "Inference precision to tune with; empty for the "
+                       "device default."),
+  };
+  if (!Flags::Parse(&argc, const_cast<const char **>(argv), flags) ||
+      graph.empty() || options.cache_dir.empty() ||
+      options.model_token.empty() ||
+      (options.tuning_objective != "latency" &&
+       options.tuning_objective != "throughput")) {
+    TFLITE_LOG(ERROR) << Flags::Usage(argv[0], flags);
+    return 1;
+  }
+
+  std::unique_ptr<FlatBufferModel> model =
+      FlatBufferModel::BuildFromFile(graph.c_str());
+  if (model == nullptr) return 1;
+  TfLiteOpaqueDelegateUniquePtr delegate =
+      TfLiteOpaqueDelegateFactory::Create(
+          std::make_unique<OpenVINODelegate>(&options));
+  ops::builtin::BuiltinOpResolver resolver;
+  InterpreterBuilder builder(*model, resolver);
+  builder.AddDelegate(delegate.get());
+  std::unique_ptr<Interpreter> interpreter;
+  if (builder(&interpreter) != kTfLiteOk) return 1;
+
+  std::shared_ptr<ov::Core> ov_core = CreateOVCore(options.plugins_path);
+  const std::string fingerprint =
+      GetHostFingerprint(*ov_core, options.device_type);
+  std::cout << "host: " << fingerprint << "\n";
+  int partitions = 0;
+  for (;; partitions++) {
+    const std::string entry = GetCacheEntryPath(options, partitions, ".tuned");
+    RuntimeConfig config;
+    if (LoadRuntimeConfig(entry, fingerprint, &config) != kTfLiteOk) break;
+    std::cout << entry << ": " << config.performance_mode << ", "
+              << config.num_streams << " streams, "
+              << config.inference_num_threads << " threads, pinning "
+              << (config.enable_cpu_pinning ? "on" : "off") << "\n";
+  }
+  if (partitions == 0) {
+    TFLITE_LOG(ERROR) << "No partition was tuned";
+    return 1;
+  }
+  return 0;
+}
+
+}  // namespace
+}  // namespace openvinodelegate
+}  // namespace tflite
+
+int main(int argc, char **argv) {
+  return tflite::openvinodelegate::Run(argc, argv);
+}
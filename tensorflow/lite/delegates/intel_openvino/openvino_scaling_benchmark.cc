@@ -0,0 +1,288 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// Measures how the OpenVINO delegate scales with the number of interpreters
+// in one process. For N = 1, 2, 4, ... up to --max_interpreters, N threads
+// each build an interpreter with its own delegate from one shared model
+// (from the synthetic zoo, see openvino_synthetic_models.h) at the same
+// time and then invoke it for --iterations runs. Per N it reports aggregate
+// throughput, scaling efficiency against N = 1, tail latency, startup time
+// and resident memory per interpreter:
+//
+//   bazel run -c opt :openvino_scaling_benchmark -- --model=mobilenet_v2 \
+//     --max_interpreters=16
+//
+// Rows are flagged where shared resources look contended, compared with
+// N = 1:
+//   startup    - the slowest interpreter took over twice as long to start,
+//                i.e. plugin loading or compile_model serialize;
+//   executor   - adding interpreters lowered aggregate throughput, i.e. the
+//                compiled models oversubscribe the CPU plugin's executors;
+//   copy       - input and output copies got over twice as slow, i.e.
+//                memory bandwidth is saturated.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "tensorflow/lite/delegates/intel_openvino/openvino_delegate.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_delegate_metrics.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_synthetic_models.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_test_model_builder.h"
+#include "tensorflow/lite/delegates/utils/simple_opaque_delegate.h"
+#include "tensorflow/lite/interpreter.h"
+#include "tensorflow/lite/kernels/register.h"
+#include "tensorflow/lite/model_builder.h"
+#include "tensorflow/lite/tools/command_line_flags.h"
+#include "tensorflow/lite/tools/logging.h"
+
+namespace tflite {
+namespace openvinodelegate {
+namespace {
+
+// Lets all workers start a phase together.
+class StartGate {
+ public:
+  explicit StartGate(int count) : remaining_(count) {}
+
+  void ArriveAndWait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (--remaining_ == 0) {
+      ready_.notify_all();
+      return;
+    }
+    ready_.wait(lock, [this] { return remaining_ == 0; });
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable ready_;
+  int remaining_;
+};
+
+struct WorkerResult {
+  bool ok = false;
+  double init_ms = 0;
+  std::vector<double> latencies_us;
+  // Means over all partitions' Evals.
+  double infer_us = 0;
+  double copy_us = 0;
+};
+
+struct RoundResult {
+  int interpreters = 0;
+  double throughput = 0;
+  double p50_us = 0;
+  double p99_us = 0;
+  double init_max_ms = 0;
+  double rss_mb_per_interpreter = 0;
+  double infer_us = 0;
+  double copy_us = 0;
+};
+
+void RunWorker(const FlatBufferModel &model,
+               const TfLiteOpenVINODelegateOptions &options, int iterations,
+               StartGate *build_gate, StartGate *invoke_gate,
+               WorkerResult *result) {
+  TfLiteOpaqueDelegateUniquePtr delegate(
+      nullptr, TfLiteOpaqueDelegateFactory::DeleteSimpleDelegate);
+  // Declared after the delegate so it is destroyed first.
+  std::unique_ptr<Interpreter> interpreter;
+
+  build_gate->ArriveAndWait();
+  const auto init_start = std::chrono::steady_clock::now();
+  delegate = CreateOpenVINODelegate(options);
+  interpreter = BuildInterpreter(
+      model, ops::builtin::BuiltinOpResolverWithoutDefaultDelegates(),
+      delegate.get());
+  bool ok = interpreter != nullptr;
+  // A partly delegated model would measure the builtin kernels instead.
+  if (ok && interpreter->execution_plan().size() != 1) {
+    TFLITE_LOG(ERROR) << "Model is not fully delegated: "
+                      << interpreter->execution_plan().size()
+                      << " nodes in the execution plan";
+    ok = false;
+  }
+  if (ok) {
+    for (int input : interpreter->inputs()) {
+      TfLiteTensor *tensor = interpreter->tensor(input);
+      std::fill_n(reinterpret_cast<float *>(tensor->data.raw),
+                  tensor->bytes / sizeof(float), 0.5f);
+    }
+    // The first invoke belongs to startup: it may still wait for
+    // compile_model.
+    ok = interpreter->Invoke() == kTfLiteOk;
+  }
+  result->init_ms = std::chrono::duration<double, std::milli>(
+                        std::chrono::steady_clock::now() - init_start)
+                        .count();
+
+  // Invokes only start once every interpreter is ready, so startup does not
+  // skew the throughput.
+  invoke_gate->ArriveAndWait();
+  if (!ok) return;
+  for (int i = 0; i < iterations; i++) {
+    const auto start = std::chrono::steady_clock::now();
+    if (interpreter->Invoke() != kTfLiteOk) return;
+    result->latencies_us.push_back(std::chrono::duration<double, std::micro>(
+                                       std::chrono::steady_clock::now() - start)
+                                       .count());
+  }
+
+  TfLiteOpenVINOPartitionMetrics partition;
+  for (int p = 0; TfLiteOpenVINODelegateGetPartitionMetrics(
+                      delegate.get(), p, &partition) == kTfLiteOk;
+       p++) {
+    if (partition.evals == 0) continue;
+    result->infer_us += partition.infer.mean_us;
+    result->copy_us +=
+        partition.input_copy.mean_us + partition.output_copy.mean_us;
+  }
+  result->ok = true;
+}
+
+bool RunRound(const FlatBufferModel &model,
+              const TfLiteOpenVINODelegateOptions &options, int interpreters,
+              int iterations, RoundResult *round) {
+  const ProcessMemory memory_before = ReadProcessMemory();
+  StartGate build_gate(interpreters);
+  StartGate invoke_gate(interpreters + 1);
+  std::vector<WorkerResult> results(interpreters);
+  std::vector<std::thread> workers;
+  for (int i = 0; i < interpreters; i++) {
+    workers.emplace_back(RunWorker, std::cref(model), std::cref(options),
+                         iterations, &build_gate, &invoke_gate, &results[i]);
+  }
+  invoke_gate.ArriveAndWait();
+  // Every interpreter is built and has run once: its memory is resident.
+  const ProcessMemory memory_ready = ReadProcessMemory();
+  const auto start = std::chrono::steady_clock::now();
+  for (std::thread &worker : workers) worker.join();
+  const double elapsed_s = std::chrono::duration<double>(
+                               std::chrono::steady_clock::now() - start)
+                               .count();
+
+  std::vector<double> latencies;
+  *round = RoundResult();
+  round->interpreters = interpreters;
+  for (const WorkerResult &result : results) {
+    if (!result.ok) return false;
+    latencies.insert(latencies.end(), result.latencies_us.begin(),
+                     result.latencies_us.end());
+    round->init_max_ms = std::max(round->init_max_ms, result.init_ms);
+    round->infer_us += result.infer_us / interpreters;
+    round->copy_us += result.copy_us / interpreters;
+  }
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&latencies](double fraction) {
+    const size_t rank = std::ceil(fraction * latencies.size());
+    return latencies[std::max<size_t>(rank, 1) - 1];
+  };
+  round->throughput = latencies.size() / elapsed_s;
+  round->p50_us = percentile(0.5);
+  round->p99_us = percentile(0.99);
+  if (memory_before.rss_bytes >= 0 && memory_ready.rss_bytes >= 0) {
+    round->rss_mb_per_interpreter =
+        (memory_ready.rss_bytes - memory_before.rss_bytes) / 1048576.0 /
+        interpreters;
+  }
+  return true;
+}
+
+std::string Contention(const RoundResult &round, const RoundResult &solo) {
+  std::string flags;
+  auto add = [&flags](const char *flag) {
+    flags += flags.empty() ? flag : std::string(",") + flag;
+  };
+  if (round.init_max_ms > 2 * solo.init_max_ms) add("startup");
+  if (round.throughput < solo.throughput) add("executor");
+  if (solo.copy_us > 0 && round.copy_us > 2 * solo.copy_us) add("copy");
+  return flags.empty() ? "-" : flags;
+}
+
+int Run(int argc, char **argv) {
+  std::string model_name = "mobilenet_v2";
+  int max_interpreters =
+      std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  int iterations = 50;
+  TfLiteOpenVINODelegateOptions options;
+  std::vector<Flag> flags = {
+      Flag::CreateFlag("model", &model_name,
+                       "Synthetic model every interpreter runs: "
+                       "mobilenet_v2, ssd_head or unet."),
+      Flag::CreateFlag("max_interpreters", &max_interpreters,
+                       "Largest number of concurrent interpreters; the "
+                       "count doubles from 1."),
+      Flag::CreateFlag("iterations", &iterations,
+                       "Timed invokes per interpreter."),
+      Flag::CreateFlag("device_type", &options.device_type,
+                       "OpenVINO device to run on."),
+      Flag::CreateFlag("async_compilation", &options.async_compilation,
+                       "Start invoking before compile_model finished."),
+      Flag::CreateFlag("conversion_backend", &options.conversion_backend,
+                       "frontend or graph_builder."),
+  };
+  if (!Flags::Parse(&argc, const_cast<const char **>(argv), flags) ||
+      max_interpreters <= 0 || iterations <= 0) {
+    TFLITE_LOG(ERROR) << Flags::Usage(argv[0], flags);
+    return 1;
+  }
+  std::vector<char> model_data;
+  for (const SyntheticModel &synthetic : GetSyntheticModels()) {
+    if (synthetic.name == model_name) model_data = synthetic.build();
+  }
+  if (model_data.empty()) {
+    TFLITE_LOG(ERROR) << "Unknown model " << model_name;
+    return 1;
+  }
+  // Shared by all interpreters, as it is in production.
+  std::unique_ptr<FlatBufferModel> model =
+      FlatBufferModel::BuildFromBuffer(model_data.data(), model_data.size());
+  if (model == nullptr) return 1;
+
+  std::cout << std::right << std::setw(4) << "N" << std::setw(11) << "infer/s"
+            << std::setw(11) << "efficiency" << std::setw(10) << "p50_us"
+            << std::setw(10) << "p99_us" << std::setw(12) << "init_max_ms"
+            << std::setw(13) << "rss_mb/interp" << std::setw(10) << "infer_us"
+            << std::setw(9) << "copy_us" << "  contention\n"
+            << std::fixed << std::setprecision(1);
+  RoundResult solo;
+  for (int interpreters = 1; interpreters <= max_interpreters;
+       interpreters *= 2) {
+    RoundResult round;
+    if (!RunRound(*model, options, interpreters, iterations, &round)) {
+      TFLITE_LOG(ERROR) << "Round with " << interpreters
+                        << " interpreters failed";
+      return 1;
+    }
+    if (interpreters == 1) solo = round;
+    std::cout << std::setw(4) << interpreters << std::setw(11)
+              << round.throughput << std::setw(11) << std::setprecision(2)
+              << round.throughput / (interpreters * solo.throughput)
+              << std::setprecision(1) << std::setw(10) << round.p50_us
+              << std::setw(10) << round.p99_us << std::setw(12)
+              << round.init_max_ms << std::setw(13)
+              << round.rss_mb_per_interpreter << std::setw(10)
+              << round.infer_us << std::setw(9) << round.copy_us << "  "
+              << Contention(round, solo) << "\n";
+  }
+  return 0;
+}
+
+}  // namespace
+}  // namespace openvinodelegate
+}  // namespace tflite
+
+int main(int argc, char **argv) {
+  return tflite::openvinodelegate::Run(argc, argv);
+}
@@ -0,0 +1,286 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "tensorflow/lite/delegates/intel_openvino/openvino_synthetic_models.h"
+
+#include <cmath>
+
+namespace tflite {
+namespace openvinodelegate {
+
+namespace {
+
+std::vector<uint8_t> ToBytes(const void *data, size_t bytes) {
+  const auto *begin = static_cast<const uint8_t *>(data);
+  return std::vector<uint8_t>(begin, begin + bytes);
+}
+
+// Uniform bound giving the variance He initialization uses for ReLU.
+float HeScale(int fan_in) { return std::sqrt(6.0f / fan_in); }
+
+}  // namespace
+
+SyntheticGraphBuilder::SyntheticGraphBuilder(
+    const std::vector<int32_t> &input_shape) {
+  input_ = AddActivation(input_shape);
+}
+
+int SyntheticGraphBuilder::AddActivation(const std::vector<int32_t> &shape) {
+  const int tensor = builder_.AddTensor(shape, TensorType_FLOAT32);
+  shapes_[tensor] = shape;
+  return tensor;
+}
+
+int SyntheticGraphBuilder::AddWeights(const std::vector<int32_t> &shape,
+                                      float scale) {
+  size_t count = 1;
+  for (int32_t dim : shape) count *= dim;
+  std::vector<float> values(count);
+  for (float &value : values) {
+    // Linear congruential generator: deterministic across platforms.
+    seed_ = seed_ * 1664525u + 1013904223u;
+    value = ((seed_ >> 8) / static_cast<float>(1 << 24) * 2 - 1) * scale;
+  }
+  return builder_.AddTensor(shape, TensorType_FLOAT32, {},
+                            ToBytes(values.data(), count * sizeof(float)));
+}
+
+int SyntheticGraphBuilder::Conv(int input, int out_channels, int kernel,
+                                int stride, ActivationFunctionType activation) {
+  const std::vector<int32_t> &in = shapes_.at(input);
+  const int filter = AddWeights({out_channels, kernel, kernel, in[3]},
+                                HeScale(kernel * kernel * in[3]));
+  const int bias = AddWeights({out_channels}, 1e-2f);
+  const int output =
+      AddActivation({1, (in[1] + stride - 1) / stride,
+                     (in[2] + stride - 1) / stride, out_channels});
+  builder_.AddOperator(BuiltinOperator_CONV_2D, {input, filter, bias},
+                       {output}, BuiltinOptions_Conv2DOptions,
+                       CreateConv2DOptions(builder_.builder(), Padding_SAME,
+                                           stride, stride, activation)
+                           .Union());
+  return output;
+}
+
+int SyntheticGraphBuilder::DepthwiseConv(int input, int kernel, int stride,
+                                         ActivationFunctionType activation) {
+  const std::vector<int32_t> &in = shapes_.at(input);
+  const int filter =
+      AddWeights({1, kernel, kernel, in[3]}, HeScale(kernel * kernel));
+  const int bias = AddWeights({in[3]}, 1e-2f);
+  const int output = AddActivation(
+      {1, (in[1] + stride - 1) / stride, (in[2] + stride - 1) / stride, in[3]});
+  builder_.AddOperator(
+      BuiltinOperator_DEPTHWISE_CONV_2D, {input, filter, bias}, {output},
+      BuiltinOptions_DepthwiseConv2DOptions,
+      CreateDepthwiseConv2DOptions(builder_.builder(), Padding_SAME, stride,
+                                   stride, /*depth_multiplier=*/1, activation)
+          .Union());
+  return output;
+}
+
+int SyntheticGraphBuilder::TransposeConv(int input, int out_channels) {
+  const std::vector<int32_t> &in = shapes_.at(input);
+  const std::vector<int32_t> output_shape = {1, in[1] * 2, in[2] * 2,
+                                             out_channels};
+  const int output_shape_tensor = builder_.AddTensor(
+      {4}, TensorType_INT32, {},
+      ToBytes(output_shape.data(), output_shape.size() * sizeof(int32_t)));
+  const int filter =
+      AddWeights({out_channels, 2, 2, in[3]}, HeScale(in[3]));
+  const int output = AddActivation(output_shape);
+  builder_.AddOperator(
+      BuiltinOperator_TRANSPOSE_CONV, {output_shape_tensor, filter, input},
+      {output}, BuiltinOptions_TransposeConvOptions,
+      CreateTransposeConvOptions(builder_.builder(), Padding_SAME, 2, 2)
+          .Union());
+  return output;
+}
+
+int SyntheticGraphBuilder::ResizeBilinear(int input, int scale) {
+  const std::vector<int32_t> &in = shapes_.at(input);
+  const int32_t size[2] = {in[1] * scale, in[2] * scale};
+  const int size_tensor = builder_.AddTensor({2}, TensorType_INT32, {},
+                                             ToBytes(size, sizeof(size)));
+  const int output = AddActivation({1, size[0], size[1], in[3]});
+  builder_.AddOperator(
+      BuiltinOperator_RESIZE_BILINEAR, {input, size_tensor}, {output},
+      BuiltinOptions_ResizeBilinearOptions,
+      CreateResizeBilinearOptions(builder_.builder(), /*align_corners=*/false,
+                                  /*half_pixel_centers=*/true)
+          .Union());
+  return output;
+}
+
+int SyntheticGraphBuilder::MaxPool(int input, int size) {
+  const std::vector<int32_t> &in = shapes_.at(input);
+  const int output = AddActivation(
+      {1, (in[1] + size - 1) / size, (in[2] + size - 1) / size, in[3]});
+  builder_.AddOperator(BuiltinOperator_MAX_POOL_2D, {input}, {output},
+                       BuiltinOptions_Pool2DOptions,
+                       CreatePool2DOptions(builder_.builder(), Padding_SAME,
+                                           size, size, size, size)
+                           .Union());
+  return output;
+}
+
+int SyntheticGraphBuilder::Mean(int input) {
+  const std::vector<int32_t> &in = shapes_.at(input);
+  const int32_t axes[2] = {1, 2};
+  const int axes_tensor = builder_.AddTensor({2}, TensorType_INT32, {},
+                                             ToBytes(axes, sizeof(axes)));
+  const int output = AddActivation({1, 1, 1, in[3]});
+  builder_.AddOperator(
+      BuiltinOperator_MEAN, {input, axes_tensor}, {output},
+      BuiltinOptions_ReducerOptions,
+      CreateReducerOptions(builder_.builder(), /*keep_dims=*/true).Union());
+  return output;
+}
+
+int SyntheticGraphBuilder::Add(int input0, int input1) {
+  const int output = AddActivation(shapes_.at(input0));
+  builder_.AddOperator(BuiltinOperator_ADD, {input0, input1}, {output},
+                       BuiltinOptions_AddOptions,
+                       CreateAddOptions(builder_.builder()).Union());
+  return output;
+}
+
+int SyntheticGraphBuilder::Concat(const std::vector<int> &inputs, int axis) {
+  std::vector<int32_t> output_shape = shapes_.at(inputs[0]);
+  for (size_t i = 1; i < inputs.size(); i++)
+    output_shape[axis] += shapes_.at(inputs[i])[axis];
+  const int output = AddActivation(output_shape);
+  builder_.AddOperator(
+      BuiltinOperator_CONCATENATION,
+      std::vector<int32_t>(inputs.begin(), inputs.end()), {output},
+      BuiltinOptions_ConcatenationOptions,
+      CreateConcatenationOptions(builder_.builder(), axis).Union());
+  return output;
+}
+
+int SyntheticGraphBuilder::Reshape(int input,
+                                   const std::vector<int32_t> &shape) {
+  const int shape_tensor = builder_.AddTensor(
+      {static_cast<int32_t>(shape.size())}, TensorType_INT32, {},
+      ToBytes(shape.data(), shape.size() * sizeof(int32_t)));
+  const int output = AddActivation(shape);
+  builder_.AddOperator(BuiltinOperator_RESHAPE, {input, shape_tensor},
+                       {output});
+  return output;
+}
+
+int SyntheticGraphBuilder::Logistic(int input) {
+  const int output = AddActivation(shapes_.at(input));
+  builder_.AddOperator(BuiltinOperator_LOGISTIC, {input}, {output});
+  return output;
+}
+
+int SyntheticGraphBuilder::Softmax(int input) {
+  const int output = AddActivation(shapes_.at(input));
+  builder_.AddOperator(BuiltinOperator_SOFTMAX, {input}, {output},
+                       BuiltinOptions_SoftmaxOptions,
+                       CreateSoftmaxOptions(builder_.builder(), 1.0f).Union());
+  return output;
+}
+
+std::vector<char> SyntheticGraphBuilder::Finish(
+    const std::vector<int> &outputs) {
+  return builder_.Finish({input_},
+                         std::vector<int32_t>(outputs.begin(), outputs.end()));
+}
+
+std::vector<char> BuildMobileNetV2LikeModel() {
+  SyntheticGraphBuilder graph({1, 224, 224, 3});
+  int x = graph.Conv(graph.input(), 32, 3, 2, ActivationFunctionType_RELU6);
+  // Inverted residual stages: expansion, output channels, blocks, stride.
+  struct Stage {
+    int expansion, channels, blocks, stride;
+  };
+  const Stage stages[] = {{1, 16, 1, 1},  {6, 24, 2, 2}, {6, 32, 3, 2},
+                          {6, 64, 4, 2},  {6, 96, 3, 1}, {6, 160, 3, 2},
+                          {6, 320, 1, 1}};
+  for (const Stage &stage : stages) {
+    for (int block = 0; block < stage.blocks; block++) {
+      const int stride = block == 0 ? stage.stride : 1;
+      const int in_channels = graph.shape(x)[3];
+      int y = x;
+      if (stage.expansion != 1) {
+        y = graph.Conv(y, in_channels * stage.expansion, 1, 1,
+                       ActivationFunctionType_RELU6);
+      }
+      y = graph.DepthwiseConv(y, 3, stride, ActivationFunctionType_RELU6);
+      y = graph.Conv(y, stage.channels, 1, 1, ActivationFunctionType_NONE);
+      x = stride == 1 && in_channels == stage.channels ? graph.Add(x, y) : y;
+    }
+  }
+  x = graph.Conv(x, 1280, 1, 1, ActivationFunctionType_RELU6);
+  x = graph.Mean(x);
+  // 1x1 convolution as the classifier; FULLY_CONNECTED is not converted.
+  x = graph.Conv(x, 1000, 1, 1, ActivationFunctionType_NONE);
+  x = graph.Reshape(x, {1, 1000});
+  return graph.Finish({graph.Softmax(x)});
+}
+
+std::vector<char> BuildSsdHeadLikeModel() {
+  constexpr int kAnchors = 6;
+  constexpr int kClasses = 21;
+  SyntheticGraphBuilder graph({1, 256, 256, 3});
+  int x = graph.Conv(graph.input(), 32, 3, 2, ActivationFunctionType_RELU6);
+  x = graph.DepthwiseConv(x, 3, 2, ActivationFunctionType_RELU6);
+  x = graph.Conv(x, 64, 1, 1, ActivationFunctionType_RELU6);
+  x = graph.DepthwiseConv(x, 3, 2, ActivationFunctionType_RELU6);
+  x = graph.Conv(x, 128, 1, 1, ActivationFunctionType_RELU6);
+
+  std::vector<int> boxes;
+  std::vector<int> scores;
+  // Feature maps of 32x32, 16x16 and 8x8.
+  for (int scale = 0; scale < 3; scale++) {
+    if (scale > 0) {
+      x = graph.DepthwiseConv(x, 3, 2, ActivationFunctionType_RELU6);
+      x = graph.Conv(x, graph.shape(x)[3] * 2, 1, 1,
+                     ActivationFunctionType_RELU6);
+    }
+    const int cells = graph.shape(x)[1] * graph.shape(x)[2];
+    const int box = graph.Conv(x, kAnchors * 4, 3, 1,
+                               ActivationFunctionType_NONE);
+    boxes.push_back(graph.Reshape(box, {1, cells * kAnchors, 4}));
+    const int score = graph.Conv(x, kAnchors * kClasses, 3, 1,
+                                 ActivationFunctionType_NONE);
+    scores.push_back(graph.Reshape(score, {1, cells * kAnchors, kClasses}));
+  }
+  const int all_boxes = graph.Concat(boxes, 1);
+  const int all_scores = graph.Logistic(graph.Concat(scores, 1));
+  return graph.Finish({all_boxes, all_scores});
+}
+
+std::vector<char> BuildUNetLikeModel() {
+  SyntheticGraphBuilder graph({1, 128, 128, 3});
+  auto conv_block = [&graph](int x, int channels) {
+    x = graph.Conv(x, channels, 3, 1, ActivationFunctionType_RELU);
+    return graph.Conv(x, channels, 3, 1, ActivationFunctionType_RELU);
+  };
+  const int skip0 = conv_block(graph.input(), 16);
+  const int skip1 = conv_block(graph.MaxPool(skip0, 2), 32);
+  int x = conv_block(graph.MaxPool(skip1, 2), 64);
+
+  x = graph.TransposeConv(x, 32);
+  x = conv_block(graph.Concat({x, skip1}, 3), 32);
+  x = graph.ResizeBilinear(x, 2);
+  x = conv_block(graph.Concat({x, skip0}, 3), 16);
+  x = graph.Conv(x, 1, 1, 1, ActivationFunctionType_NONE);
+  return graph.Finish({graph.Logistic(x)});
+}
+
+const std::vector<SyntheticModel> &GetSyntheticModels() {
+  static const auto *models = new std::vector<SyntheticModel>{
+      {"mobilenet_v2", BuildMobileNetV2LikeModel},
+      {"ssd_head", BuildSsdHeadLikeModel},
+      {"unet", BuildUNetLikeModel},
+  };
+  return *models;
+}
+
+}  // namespace openvinodelegate
+}  // namespace tflite
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef DELEGATE_INTEL_OPENVINO_OPENVINO_SYNTHETIC_MODELS_H_
+#define DELEGATE_INTEL_OPENVINO_OPENVINO_SYNTHETIC_MODELS_H_
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "tensorflow/lite/delegates/intel_openvino/openvino_test_model_builder.h"
+#include "tensorflow/lite/schema/schema_generated.h"
+
+namespace tflite {
+namespace openvinodelegate {
+
+// Float NHWC graphs shaped like common vision models, built only from ops
+// the delegate converts, with deterministic weights scaled by fan-in so
+// activations stay in range. They need no model files, so benchmarks and
+// accuracy checks run on any host that builds the delegate.
+std::vector<char> BuildMobileNetV2LikeModel();
+// Backbone feeding box and class heads at three scales, with the per-anchor
+// outputs reshaped and concatenated like an SSD head.
+std::vector<char> BuildSsdHeadLikeModel();
+// Encoder-decoder with skip connections; the decoder upsamples once with
+// TRANSPOSE_CONV and once with RESIZE_BILINEAR.
+std::vector<char> BuildUNetLikeModel();
+
+struct SyntheticModel {
+  std::string name;
+  std::vector<char> (*build)();
+};
+
+// All synthetic models, by name.
+const std::vector<SyntheticModel> &GetSyntheticModels();
+
+// Tracks tensor shapes on top of TestModelBuilder so that layers can be
+// stacked without spelling out every intermediate shape. Convolutions and
+// pools use SAME padding.
+class SyntheticGraphBuilder {
+ public:
+  explicit SyntheticGraphBuilder(const std::vector<int32_t> &input_shape);
+
+  int input() const { return input_; }
+  const std::vector<int32_t> &shape(int tensor) const {
+    return shapes_.at(tensor);
+  }
+
+  int Conv(int input, int out_channels, int kernel, int stride,
+           ActivationFunctionType activation);
+  int DepthwiseConv(int input, int kernel, int stride,
+                    ActivationFunctionType activation);
+  // 2x upsampling with a 2x2, stride 2 kernel.
+  int TransposeConv(int input, int out_channels);
+  int ResizeBilinear(int input, int scale);
+  int MaxPool(int input, int size);
+  // Global average over H and W, keeping the dimensions.
+  int Mean(int input);
+  int Add(int input0, int input1);
+  int Concat(const std::vector<int> &inputs, int axis);
+  int Reshape(int input, const std::vector<int32_t> &shape);
+  int Logistic(int input);
+  int Softmax(int input);
+
+  // Serializes the model. The builder must not be used afterwards.
+  std::vector<char> Finish(const std::vector<int> &outputs);
+
+ private:
+  int AddActivation(const std::vector<int32_t> &shape);
+  // Float constant of |shape| with values uniform in [-scale, scale].
+  int AddWeights(const std::vector<int32_t> &shape, float scale);
+
+  TestModelBuilder builder_;
+  std::map<int, std::vector<int32_t>> shapes_;
+  int input_;
+  uint32_t seed_ = 1;
+};
+
+}  // namespace openvinodelegate
+}  // namespace tflite
+
+#endif  // DELEGATE_INTEL_OPENVINO_OPENVINO_SYNTHETIC_MODELS_H_
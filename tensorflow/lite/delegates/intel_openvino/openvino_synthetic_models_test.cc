@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "tensorflow/lite/delegates/intel_openvino/openvino_synthetic_models.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "tensorflow/lite/delegates/intel_openvino/openvino_delegate.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_delegate_metrics.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_test_model_builder.h"
+#include "tensorflow/lite/delegates/utils/simple_opaque_delegate.h"
+#include "tensorflow/lite/interpreter.h"
+#include "tensorflow/lite/kernels/register.h"
+#include "tensorflow/lite/model_builder.h"
+
+/* The synthetic model zoo is delegated as a whole and matches TfLite with
+ * either conversion backend */
+
+namespace tflite {
+namespace openvinodelegate {
+namespace {
+
+// A model and the conversion backend to delegate it with.
+class SyntheticModelsTest
+    : public testing::TestWithParam<std::tuple<SyntheticModel, std::string>> {
+};
+
+// Runs |model| once on the builtin kernels, or on the delegate if it is set,
+// and returns its outputs.
+std::vector<std::vector<float>> Invoke(const FlatBufferModel &model,
+                                       TfLiteOpaqueDelegate *delegate) {
+  std::unique_ptr<Interpreter> interpreter = BuildInterpreter(
+      model, ops::builtin::BuiltinOpResolverWithoutDefaultDelegates(),
+      delegate);
+  std::vector<std::vector<float>> outputs;
+  if (interpreter == nullptr) return outputs;
+  if (delegate != nullptr) EXPECT_EQ(1u, interpreter->execution_plan().size());
+
+  for (int input : interpreter->inputs()) {
+    TfLiteTensor *tensor = interpreter->tensor(input);
+    float *data = reinterpret_cast<float *>(tensor->data.raw);
+    for (size_t i = 0; i < tensor->bytes / sizeof(float); i++)
+      data[i] = std::sin(i * 0.01f);
+  }
+  if (interpreter->Invoke() != kTfLiteOk) return outputs;
+  for (int output : interpreter->outputs()) {
+    const TfLiteTensor *tensor = interpreter->tensor(output);
+    const float *data = reinterpret_cast<const float *>(tensor->data.raw);
+    outputs.emplace_back(data, data + tensor->bytes / sizeof(float));
+  }
+  return outputs;
+}
+
+TEST_P(SyntheticModelsTest, MatchesBuiltinKernels) {
+  const std::string &backend = std::get<1>(GetParam());
+  const std::vector<char> model_data = std::get<0>(GetParam()).build();
+  std::unique_ptr<FlatBufferModel> model =
+      FlatBufferModel::BuildFromBuffer(model_data.data(), model_data.size());
+  ASSERT_NE(model, nullptr);
+
+  const std::vector<std::vector<float>> expected = Invoke(*model, nullptr);
+  ASSERT_FALSE(expected.empty());
+  TfLiteOpenVINODelegateOptions options;
+  options.inference_precision = "f32";
+  options.conversion_backend = backend;
+  TfLiteOpaqueDelegateUniquePtr delegate = CreateOpenVINODelegate(options);
+  const std::vector<std::vector<float>> actual =
+      Invoke(*model, delegate.get());
+  // Both backends convert every op in the zoo, so the partition is built by
+  // the requested one and the graph builder never falls back to the frontend.
+  TfLiteOpenVINOPartitionMetrics metrics;
+  ASSERT_EQ(kTfLiteOk, TfLiteOpenVINODelegateGetPartitionMetrics(
+                           delegate.get(), 0, &metrics));
+  ASSERT_GE(metrics.compile_ms, 0);
+  EXPECT_EQ(backend == "graph_builder" ? 1 : 0, metrics.graph_builder);
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t o = 0; o < expected.size(); o++) {
+    ASSERT_EQ(expected[o].size(), actual[o].size());
+    for (size_t i = 0; i < expected[o].size(); i++)
+      ASSERT_NEAR(expected[o][i], actual[o][i], 1e-3) << "output " << o;
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Zoo, SyntheticModelsTest,
+    testing::Combine(testing::ValuesIn(GetSyntheticModels()),
+                     testing::Values(std::string("frontend"),
+                                     std::string("graph_builder"))),
+    [](const testing::TestParamInfo<SyntheticModelsTest::ParamType> &info) {
+      return std::get<0>(info.param).name + "_" + std::get<1>(info.param);
+    });
+
+}  // namespace
+}  // namespace openvinodelegate
+}  // namespace tflite
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "tensorflow/lite/delegates/intel_openvino/openvino_test_model_builder.h"
+
+#include <algorithm>
+#include <string>
+
+#include "tensorflow/lite/interpreter_builder.h"
+#include "tensorflow/lite/kernels/register.h"
+#include "tensorflow/lite/version.h"
+
+namespace tflite {
+namespace openvinodelegate {
+
+TestModelBuilder::TestModelBuilder() {
+  // Buffer 0 is the empty sentinel referenced by all non-constant tensors.
+  buffers_.push_back(
+      CreateBuffer(builder_, builder_.CreateVector(std::vector<uint8_t>())));
+}
+
+int TestModelBuilder::AddTensor(const std::vector<int32_t> &shape,
+                                TensorType type,
+                                const TestQuantization &quantization,
+                                const std::vector<uint8_t> &data) {
+  uint32_t buffer_index = 0;
+  if (!data.empty()) {
+    buffer_index = buffers_.size();
+    buffers_.push_back(CreateBuffer(builder_, builder_.CreateVector(data)));
+  }
+
+  flatbuffers::Offset<QuantizationParameters> quantization_params = 0;
+  if (!quantization.scale.empty()) {
+    std::vector<int64_t> zero_point = quantization.zero_point;
+    zero_point.resize(quantization.scale.size(), 0);
+    quantization_params = CreateQuantizationParameters(
+        builder_, /*min=*/0, /*max=*/0,
+        builder_.CreateVector(quantization.scale),
+        builder_.CreateVector(zero_point), QuantizationDetails_NONE,
+        /*details=*/0, quantization.quantized_dimension);
+  }
+
+  const int index = tensors_.size();
+  tensors_.push_back(CreateTensor(
+      builder_, builder_.CreateVector(shape), type, buffer_index,
+      builder_.CreateString("tensor_" + std::to_string(index)),
+      quantization_params));
+  return index;
+}
+
+int TestModelBuilder::AddSparseTensor(const std::vector<int32_t> &shape,
+                                      const std::vector<float> &dense_values) {
+  const int columns = shape.back();
+  const int rows = dense_values.size() / columns;
+  std::vector<int32_t> segments = {0};
+  std::vector<int32_t> indices;
+  std::vector<float> values;
+  for (int r = 0; r < rows; r++) {
+    for (int c = 0; c < columns; c++) {
+      const float value = dense_values[r * columns + c];
+      if (value == 0) continue;
+      indices.push_back(c);
+      values.push_back(value);
+    }
+    segments.push_back(indices.size());
+  }
+
+  std::vector<int32_t> traversal_order;
+  std::vector<flatbuffers::Offset<DimensionMetadata>> dim_metadata;
+  for (int i = 0; i < shape.size(); i++) {
+    traversal_order.push_back(i);
+    if (i + 1 < shape.size()) {
+      dim_metadata.push_back(CreateDimensionMetadata(
+          builder_, DimensionType_DENSE, /*dense_size=*/shape[i]));
+    } else {
+      dim_metadata.push_back(CreateDimensionMetadata(
+          builder_, DimensionType_SPARSE_CSR, /*dense_size=*/0,
+          SparseIndexVector_Int32Vector,
+          CreateInt32Vector(builder_, builder_.CreateVector(segments)).Union(),
+          SparseIndexVector_Int32Vector,
+          CreateInt32Vector(builder_, builder_.CreateVector(indices))
+              .Union()));
+    }
+  }
+  const auto sparsity = CreateSparsityParameters(
+      builder_, builder_.CreateVector(traversal_order),
+      /*block_map=*/0, builder_.CreateVector(dim_metadata));
+
+  const uint8_t *bytes = reinterpret_cast<const uint8_t *>(values.data());
+  const std::vector<uint8_t> data(bytes, bytes + values.size() * sizeof(float));
+  const uint32_t buffer_index = buffers_.size();
+  buffers_.push_back(CreateBuffer(builder_, builder_.CreateVector(data)));
+
+  const int index = tensors_.size();
+  tensors_.push_back(CreateTensor(
+      builder_, builder_.CreateVector(shape), TensorType_FLOAT32, buffer_index,
+      builder_.CreateString("tensor_" + std::to_string(index)),
+      /*quantization=*/0, /*is_variable=*/false, sparsity));
+  return index;
+}
+
+void TestModelBuilder::AddOperator(BuiltinOperator op,
+                                   const std::vector<int32_t> &inputs,
+                                   const std::vector<int32_t> &outputs,
+                                   BuiltinOptions options_type,
+                                   flatbuffers::Offset<void> options) {
+  operators_.push_back(CreateOperator(
+      builder_, GetOperatorCodeIndex(op), builder_.CreateVector(inputs),
+      builder_.CreateVector(outputs), options_type, options));
+}
+
+int TestModelBuilder::GetOperatorCodeIndex(BuiltinOperator op) {
+  auto it = std::find(operator_codes_.begin(), operator_codes_.end(), op);
+  if (it != operator_codes_.end()) return it - operator_codes_.begin();
+  operator_codes_.push_back(op);
+  return operator_codes_.size() - 1;
+}
+
+std::vector<char> TestModelBuilder::Finish(
+    const std::vector<int32_t> &inputs, const std::vector<int32_t> &outputs) {
+  std::vector<flatbuffers::Offset<OperatorCode>> operator_codes;
+  for (BuiltinOperator op : operator_codes_) {
+    const int8_t deprecated_code = static_cast<int8_t>(
+        std::min<int>(op, BuiltinOperator_PLACEHOLDER_FOR_GREATER_OP_CODES));
+    operator_codes.push_back(CreateOperatorCode(
+        builder_, deprecated_code, /*custom_code=*/0, /*version=*/1, op));
+  }
+
+  const auto subgraph = CreateSubGraph(
+      builder_, builder_.CreateVector(tensors_), builder_.CreateVector(inputs),
+      builder_.CreateVector(outputs), builder_.CreateVector(operators_));
+  const auto model = CreateModel(
+      builder_, TFLITE_SCHEMA_VERSION, builder_.CreateVector(operator_codes),
+      builder_.CreateVector(&subgraph, 1),
+      builder_.CreateString("openvino delegate test model"),
+      builder_.CreateVector(buffers_));
+  FinishModelBuffer(builder_, model);
+
+  const char *buffer =
+      reinterpret_cast<const char *>(builder_.GetBufferPointer());
+  return std::vector<char>(buffer, buffer + builder_.GetSize());
+}
+
+std::vector<char> BuildAddModel(const std::vector<int32_t> &shape) {
+  TestModelBuilder builder;
+  const int input0 = builder.AddTensor(shape, TensorType_FLOAT32);
+  const int input1 = builder.AddTensor(shape, TensorType_FLOAT32);
+  const int output = builder.AddTensor(shape, TensorType_FLOAT32);
+  builder.AddOperator(BuiltinOperator_ADD, {input0, input1}, {output},
+                      BuiltinOptions_AddOptions,
+                      CreateAddOptions(builder.builder()).Union());
+  return builder.Finish({input0, input1}, {output});
+}
+
+TfLiteOpaqueDelegateUniquePtr CreateOpenVINODelegate(
+    const TfLiteOpenVINODelegateOptions &options) {
+  return TfLiteOpaqueDelegateFactory::Create(
+      std::make_unique<OpenVINODelegate>(&options));
+}
+
+std::unique_ptr<Interpreter> BuildInterpreter(const FlatBufferModel &model,
+                                              TfLiteOpaqueDelegate *delegate) {
+  return BuildInterpreter(model, ops::builtin::BuiltinOpResolver(), delegate);
+}
+
+std::unique_ptr<Interpreter> BuildInterpreter(const FlatBufferModel &model,
+                                              const OpResolver &resolver,
+                                              TfLiteOpaqueDelegate *delegate,
+                                              int num_threads) {
+  InterpreterBuilder builder(model, resolver);
+  if (delegate != nullptr) builder.AddDelegate(delegate);
+  builder.SetNumThreads(num_threads);
+  std::unique_ptr<Interpreter> interpreter;
+  if (builder(&interpreter) != kTfLiteOk || interpreter == nullptr ||
+      interpreter->AllocateTensors() != kTfLiteOk)
+    return nullptr;
+  return interpreter;
+}
+
+}  // namespace openvinodelegate
+}  // namespace tflite
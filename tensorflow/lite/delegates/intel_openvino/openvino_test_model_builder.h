@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef DELEGATE_INTEL_OPENVINO_OPENVINO_TEST_MODEL_BUILDER_H_
+#define DELEGATE_INTEL_OPENVINO_OPENVINO_TEST_MODEL_BUILDER_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "flatbuffers/flatbuffers.h"
+#include "tensorflow/lite/delegates/intel_openvino/openvino_delegate.h"
+#include "tensorflow/lite/delegates/utils/simple_opaque_delegate.h"
+#include "tensorflow/lite/core/api/op_resolver.h"
+#include "tensorflow/lite/interpreter.h"
+#include "tensorflow/lite/model_builder.h"
+#include "tensorflow/lite/schema/schema_generated.h"
+
+namespace tflite {
+namespace openvinodelegate {
+
+// Quantization parameters of a test tensor. An empty |scale| leaves the
+// tensor unquantized.
+struct TestQuantization {
+  std::vector<float> scale;
+  std::vector<int64_t> zero_point;
+  int quantized_dimension = 0;
+};
+
+// Builds single-subgraph TfLite flatbuffer models for tests, so that the
+// delegate can be exercised on graphs that are not in testdata.
+class TestModelBuilder {
+ public:
+  TestModelBuilder();
+
+  // Adds a tensor and returns its index. Tensors with |data| are constants.
+  int AddTensor(const std::vector<int32_t> &shape, TensorType type,
+                const TestQuantization &quantization = {},
+                const std::vector<uint8_t> &data = {});
+
+  // Adds a float constant stored in TfLite's sparse format: all dimensions
+  // dense except the innermost, which is CSR-compressed. Zeros in
+  // |dense_values| are dropped.
+  int AddSparseTensor(const std::vector<int32_t> &shape,
+                      const std::vector<float> &dense_values);
+
+  // Adds an operator; |options| is built with builder().
+  void AddOperator(BuiltinOperator op, const std::vector<int32_t> &inputs,
+                   const std::vector<int32_t> &outputs,
+                   BuiltinOptions options_type = BuiltinOptions_NONE,
+                   flatbuffers::Offset<void> options = 0);
+
+  flatbuffers::FlatBufferBuilder &builder() { return builder_; }
+
+  // Serializes the model. The builder must not be used afterwards.
+  std::vector<char> Finish(const std::vector<int32_t> &inputs,
+                           const std::vector<int32_t> &outputs);
+
+ private:
+  int GetOperatorCodeIndex(BuiltinOperator op);
+
+  flatbuffers::FlatBufferBuilder builder_;
+  std::vector<flatbuffers::Offset<Buffer>> buffers_;
+  std::vector<flatbuffers::Offset<Tensor>> tensors_;
+  std::vector<flatbuffers::Offset<Operator>> operators_;
+  std::vector<BuiltinOperator> operator_codes_;
+};
+
+// input0 + input1, both of |shape|.
+std::vector<char> BuildAddModel(
+    const std::vector<int32_t> &shape = {1, 8, 8, 16});
+
+// An OpenVINODelegate configured by |options|.
+TfLiteOpaqueDelegateUniquePtr CreateOpenVINODelegate(
+    const TfLiteOpenVINODelegateOptions &options);
+
+// Builds an interpreter for |model| with |delegate| applied, or on TfLite's
+// builtin kernels alone if |delegate| is null, and allocates its tensors.
+// Returns nullptr if any step fails. |model| and |delegate| must outlive it.
+std::unique_ptr<Interpreter> BuildInterpreter(const FlatBufferModel &model,
+                                              TfLiteOpaqueDelegate *delegate);
+// Same, with the kernels of |resolver| running on |num_threads| threads (-1
+// lets TfLite decide).
+std::unique_ptr<Interpreter> BuildInterpreter(const FlatBufferModel &model,
+                                              const OpResolver &resolver,
+                                              TfLiteOpaqueDelegate *delegate,
+                                              int num_threads = -1);
+
+}  // namespace openvinodelegate
+}  // namespace tflite
+
+#endif  // DELEGATE_INTEL_OPENVINO_OPENVINO_TEST_MODEL_BUILDER_H_
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "tensorflow/lite/delegates/intel_openvino/openvino_tracer.h"
+
+#include <unistd.h>
+
+#include <atomic>
+#include <fstream>
+#include <sstream>
+
+#ifdef OPENVINO_DELEGATE_ITT
+#include <ittnotify.h>
+#endif
+
+namespace tflite {
+namespace openvinodelegate {
+
+namespace {
+
+// Small, stable ids read better in trace viewers than native thread ids.
+int CurrentThreadId() {
+  static std::atomic<int> next_thread_id{1};
+  thread_local const int thread_id = next_thread_id.fetch_add(1);
+  return thread_id;
+}
+
+double MicrosecondsBetween(Tracer::Clock::time_point start,
+                           Tracer::Clock::time_point end) {
+  return std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+#ifdef OPENVINO_DELEGATE_ITT
+__itt_domain *GetIttDomain() {
+  static __itt_domain *domain = __itt_domain_create("tflite.openvino");
+  return domain;
+}
+#endif
+
+}  // namespace
+
+Tracer::Tracer(size_t max_events)
+    : origin_(Clock::now()), max_events_(max_events) {}
+
+void Tracer::AddEvent(const char *name, const char *category,
+                      int partition_index, Clock::time_point start,
+                      Clock::time_point end) {
+  const Event event = {name,
+                       category,
+                       partition_index,
+                       CurrentThreadId(),
+                       MicrosecondsBetween(origin_, start),
+                       MicrosecondsBetween(start, end)};
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (events_.size() >= max_events_) {
+    dropped_events_++;
+    return;
+  }
+  events_.push_back(event);
+}
+
+std::string Tracer::ToChromeTraceJson() const {
+  const int pid = getpid();
+  std::ostringstream json;
+  json << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (size_t i = 0; i < events_.size(); i++) {
+    const Event &event = events_[i];
+    if (i > 0) json << ",";
+    // Names and categories are identifiers; nothing to escape.
+    json << "\n{\"name\":\"" << event.name << "\",\"cat\":\""
+         << event.category << "\",\"ph\":\"X\",\"ts\":" << event.start_us
+         << ",\"dur\":" << event.duration_us << ",\"pid\":" << pid
+         << ",\"tid\":" << event.thread_id;
+    if (event.partition_index >= 0)
+      json << ",\"args\":{\"partition\":" << event.partition_index << "}";
+    json << "}";
+  }
+  json << "\n]}\n";
+  return json.str();
+}
+
+TfLiteStatus Tracer::WriteChromeTrace(const std::string &path) const {
+  std::ofstream file(path);
+  if (!file) return kTfLiteError;
+  file << ToChromeTraceJson();
+  return file ? kTfLiteOk : kTfLiteError;
+}
+
+size_t Tracer::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return events_.size();
+}
+
+uint64_t Tracer::getDroppedEvents() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return dropped_events_;
+}
+
+ScopedTrace::ScopedTrace(Tracer *tracer, const char *name,
+                         const char *category, int partition_index)
+    : tracer_(tracer),
+      name_(name),
+      category_(category),
+      partition_index_(partition_index) {
+  if (tracer_ == nullptr) return;
+#ifdef OPENVINO_DELEGATE_ITT
+  __itt_task_begin(GetIttDomain(), __itt_null, __itt_null,
+                   __itt_string_handle_create(name_));
+#endif
+  start_ = Tracer::Clock::now();
+}
+
+ScopedTrace::~ScopedTrace() {
+  if (tracer_ == nullptr) return;
+  tracer_->AddEvent(name_, category_, partition_index_, start_,
+                    Tracer::Clock::now());
+#ifdef OPENVINO_DELEGATE_ITT
+  __itt_task_end(GetIttDomain());
+#endif
+}
+
+}  // namespace openvinodelegate
+}  // namespace tflite
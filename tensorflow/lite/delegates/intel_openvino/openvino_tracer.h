@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef DELEGATE_INTEL_OPENVINO_OPENVINO_TRACER_H_
+#define DELEGATE_INTEL_OPENVINO_OPENVINO_TRACER_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "tensorflow/lite/c/common.h"
+
+namespace tflite {
+namespace openvinodelegate {
+
+// Collects the phases of delegate startup and of every Eval as complete
+// events, exportable as Chrome trace JSON (chrome://tracing, Perfetto).
+// Built with --define=openvino_delegate_itt=true, every phase is also an ITT
+// task, so VTune shows it on the thread that ran it.
+class Tracer {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  // Events beyond |max_events| are dropped and counted.
+  explicit Tracer(size_t max_events = 1 << 20);
+
+  // |name| and |category| must outlive the tracer; string literals do.
+  // |partition_index| is -1 for phases of the whole delegate.
+  void AddEvent(const char *name, const char *category, int partition_index,
+                Clock::time_point start, Clock::time_point end);
+
+  std::string ToChromeTraceJson() const;
+  TfLiteStatus WriteChromeTrace(const std::string &path) const;
+
+  size_t size() const;
+  uint64_t getDroppedEvents() const;
+
+ private:
+  struct Event {
+    const char *name;
+    const char *category;
+    int partition_index;
+    int thread_id;
+    double start_us;
+    double duration_us;
+  };
+
+  const Clock::time_point origin_;
+  const size_t max_events_;
+  mutable std::mutex mutex_;
+  std::vector<Event> events_;
+  uint64_t dropped_events_ = 0;
+};
+
+// Traces the enclosing scope. A null tracer costs a branch, not a clock read.
+class ScopedTrace {
+ public:
+  ScopedTrace(Tracer *tracer, const char *name, const char *category,
+              int partition_index = -1);
+  ~ScopedTrace();
+
+  ScopedTrace(const ScopedTrace &) = delete;
+  ScopedTrace &operator=(const ScopedTrace &) = delete;
+
+ private:
+  Tracer *tracer_;
+  const char *name_;
+  const char *category_;
+  int partition_index_;
+  Tracer::Clock::time_point start_;
+};
+
+// Categories of the trace events.
+constexpr char kTraceStartup[] = "startup";
+constexpr char kTraceEval[] = "eval";
+
+}  // namespace openvinodelegate
+}  // namespace tflite
+
+#endif  // DELEGATE_INTEL_OPENVINO_OPENVINO_TRACER_H_
@@ -7,29 +7,104 @@
 #define DELEGATE_INTEL_OPENVINO_OPERATIONS_OPENVINO_NODE_MANAGER_H_
 
 #include <openvino/openvino.hpp>
+#include <openvino/opsets/opset8.hpp>
 
-#include <map>
 #include <memory>
-#include <unordered_set>
+#include <vector>
 
+// Layout a rank-4 activation is produced in. TfLite tensors are NHWC; the
+// layout-sensitive converters (convolutions, pools, resize) compute in NCHW
+// and leave their output there, so that a chain of them needs no Transpose
+// between layers.
+enum class TensorLayout { kNHWC = 0, kNCHW = 1 };
+
+// Outputs of the tensors of one TfLite context, indexed by tensor id.
 class NodeManager {
  public:
   NodeManager() {}
-  std::shared_ptr<ov::Node> getInterimNodeOutput(int index) {
-    auto node = output_at_op_index_[index];
-    return node.get_node_shared_ptr();
+  // Sized for a context of |num_tensors| tensors, so that storing outputs
+  // never reallocates.
+  explicit NodeManager(size_t num_tensors) : outputs_(num_tensors) {}
+
+  // Whether tensor |index| has been given an output.
+  bool hasOutput(int index) const {
+    return index >= 0 && static_cast<size_t>(index) < outputs_.size() &&
+           outputs_[index].defined();
   }
-  void setOutputAtOperandIndex(int index, ov::Output<ov::Node> output) {
-    output_at_op_index_.emplace(index, output);
+
+  // Output of tensor |index| in |layout|, or nullptr if the tensor has no
+  // output yet. A Transpose is inserted on the first request for the layout
+  // the tensor was not produced in and is shared by all later requests.
+  // Tensors that are not rank 4 have no layout and are returned as produced.
+  std::shared_ptr<ov::Node> getInterimNodeOutput(
+      int index, TensorLayout layout = TensorLayout::kNHWC) {
+    if (!hasOutput(index)) return nullptr;
+    TensorOutputs &tensor = outputs_[index];
+    ov::Output<ov::Node> &output = tensor.in_layout[static_cast<int>(layout)];
+    if (output.get_node() != nullptr) return output.get_node_shared_ptr();
+    const ov::Output<ov::Node> &produced =
+        tensor.in_layout[static_cast<int>(tensor.layout)];
+    if (produced.get_partial_shape().rank() != 4)
+      return produced.get_node_shared_ptr();
+
+    const std::vector<int32_t> order = layout == TensorLayout::kNCHW
+                                           ? std::vector<int32_t>{0, 3, 1, 2}
+                                           : std::vector<int32_t>{0, 2, 3, 1};
+    output = std::make_shared<ov::opset8::Transpose>(
+        produced, ov::opset8::Constant::create(ov::element::i32,
+                                               ov::Shape{4}, order));
+    layout_transposes_++;
+    return output.get_node_shared_ptr();
   }
 
-  size_t getNodeCount() const { return output_at_op_index_.size(); }
+  // Sets the output of tensor |index| unless it already has one.
+  void setOutputAtOperandIndex(int index, ov::Output<ov::Node> output,
+                               TensorLayout layout = TensorLayout::kNHWC) {
+    if (index < 0 || hasOutput(index)) return;
+    if (static_cast<size_t>(index) >= outputs_.size())
+      outputs_.resize(index + 1);
+    TensorOutputs &tensor = outputs_[index];
+    tensor.layout = layout;
+    tensor.in_layout[static_cast<int>(layout)] = output;
+    num_outputs_++;
+  }
+
+  // Layout tensor |index| was produced in.
+  TensorLayout getLayout(int index) const {
+    return hasOutput(index) ? outputs_[index].layout : TensorLayout::kNHWC;
+  }
 
-  bool isIndexAParam(int index) { return index_parameters_.count(index); }
-  void insertIndexParameters(int index) { index_parameters_.insert(index); }
+  size_t getNodeCount() const { return num_outputs_; }
+
+  // Transposes inserted between tensors and consumers that disagree on the
+  // layout, including those at the partition's inputs and outputs.
+  size_t getLayoutTransposeCount() const { return layout_transposes_; }
+
+  bool isIndexAParam(int index) const {
+    return index >= 0 && static_cast<size_t>(index) < outputs_.size() &&
+           outputs_[index].is_param;
+  }
+  void insertIndexParameters(int index) {
+    if (index < 0) return;
+    if (static_cast<size_t>(index) >= outputs_.size())
+      outputs_.resize(index + 1);
+    outputs_[index].is_param = true;
+  }
 
  private:
-  std::map<int, ov::Output<ov::Node>> output_at_op_index_;
-  std::unordered_set<int> index_parameters_;
+  struct TensorOutputs {
+    bool defined() const {
+      return in_layout[static_cast<int>(layout)].get_node() != nullptr;
+    }
+
+    TensorLayout layout = TensorLayout::kNHWC;
+    bool is_param = false;
+    // Indexed by TensorLayout.
+    ov::Output<ov::Node> in_layout[2];
+  };
+
+  std::vector<TensorOutputs> outputs_;
+  size_t num_outputs_ = 0;
+  size_t layout_transposes_ = 0;
 };
 #endif  // DELEGATE_INTEL_OPENVINO_OPERATIONS_OPENVINO_NODE_MANAGER_H_
@@ -5,6 +5,9 @@
 
 #include "tensorflow/lite/delegates/intel_openvino/operations/operations_base.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -13,6 +16,71 @@
 
 namespace tflite {
 namespace openvinodelegate {
+namespace {
+
+// Transposes |batches| row-major |rows| x |cols| matrices. Square tiles keep
+// the strided side in cache and give the compiler contiguous runs to
+// vectorize.
+template <typename T>
+void TransposeMatrices(const T *in, T *out, size_t batches, size_t rows,
+                       size_t cols) {
+  constexpr size_t kTile = 16;
+  const size_t matrix_size = rows * cols;
+  for (size_t b = 0; b < batches; b++) {
+    const T *src = in + b * matrix_size;
+    T *dst = out + b * matrix_size;
+    for (size_t c0 = 0; c0 < cols; c0 += kTile) {
+      const size_t c1 = std::min(cols, c0 + kTile);
+      for (size_t r0 = 0; r0 < rows; r0 += kTile) {
+        const size_t r1 = std::min(rows, r0 + kTile);
+        for (size_t c = c0; c < c1; c++) {
+          for (size_t r = r0; r < r1; r++)
+            dst[c * rows + r] = src[r * cols + c];
+        }
+      }
+    }
+  }
+}
+
+// Reorders a 4D filter of |shape| by |order| ({0, 3, 1, 2} or {3, 0, 1, 2},
+// both of which move the last axis in front of the spatial ones) into |out|.
+// Returns false for element types that are not a whole number of bytes.
+bool ReorderFilter(const void *in, void *out, const ov::Shape &shape,
+                   const ov::AxisVector &order, ov::element::Type type) {
+  if (type.bitwidth() % 8 != 0) return false;
+  // The moved axis becomes the columns of a matrix whose rows are the axes
+  // it jumps over; the axes before those are batches.
+  const size_t cols = shape[3];
+  const size_t rows = order[0] == 3 ? shape[0] * shape[1] * shape[2]
+                                    : shape[1] * shape[2];
+  const size_t batches = order[0] == 3 ? 1 : shape[0];
+  if (rows == 1 || cols == 1) {
+    std::memcpy(out, in, batches * rows * cols * type.size());
+    return true;
+  }
+  switch (type.size()) {
+    case 1:
+      TransposeMatrices(static_cast<const uint8_t *>(in),
+                        static_cast<uint8_t *>(out), batches, rows, cols);
+      return true;
+    case 2:
+      TransposeMatrices(static_cast<const uint16_t *>(in),
+                        static_cast<uint16_t *>(out), batches, rows, cols);
+      return true;
+    case 4:
+      TransposeMatrices(static_cast<const uint32_t *>(in),
+                        static_cast<uint32_t *>(out), batches, rows, cols);
+      return true;
+    case 8:
+      TransposeMatrices(static_cast<const uint64_t *>(in),
+                        static_cast<uint64_t *>(out), batches, rows, cols);
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
 
 void OperationsBase::UpdateNodeInfo(const int *tensor_indices, int size,
                                     void *builtin_data) {
@@ -54,6 +122,78 @@ TfLiteStatus OperationsBase::Transpose(
   return kTfLiteOk;
 }
 
+TfLiteStatus OperationsBase::TransposeFilter(
+    LayoutConversion type, std::shared_ptr<ov::Node> filter,
+    const ov::Shape &group_shape,
+    std::shared_ptr<ov::Node> &transposed_filter) {
+  if (type != IHWO_OIHW && type != OHWI_OIHW) return kTfLiteError;
+  const ov::AxisVector order = type == IHWO_OIHW
+                                   ? ov::AxisVector{3, 0, 1, 2}
+                                   : ov::AxisVector{0, 3, 1, 2};
+
+  auto constant = ov::as_type_ptr<ov::opset8::Constant>(filter);
+  if (constant != nullptr && constant->get_shape().size() == 4) {
+    const ov::Shape &shape = constant->get_shape();
+    ov::Shape target_shape = group_shape;
+    if (target_shape.empty()) {
+      for (size_t axis : order) target_shape.push_back(shape[axis]);
+    }
+    if (ov::shape_size(target_shape) != ov::shape_size(shape))
+      return kTfLiteError;
+    ov::Tensor reordered(constant->get_element_type(), target_shape);
+    if (ReorderFilter(constant->get_data_ptr(), reordered.data(), shape, order,
+                      constant->get_element_type())) {
+      transposed_filter = std::make_shared<ov::opset8::Constant>(reordered);
+      return kTfLiteOk;
+    }
+  }
+
+  // Filters computed in the graph, e.g. behind a dequantization, are
+  // transposed at runtime.
+  if (Transpose(type, filter, transposed_filter) != kTfLiteOk)
+    return kTfLiteError;
+  if (!group_shape.empty()) {
+    auto shape_node = CreateConstNode(ov::element::i64,
+                                      ov::Shape{group_shape.size()},
+                                      std::vector<int64_t>(group_shape.begin(),
+                                                           group_shape.end()));
+    transposed_filter = std::make_shared<ov::opset8::Reshape>(
+        transposed_filter, shape_node, /*special_zero=*/false);
+  }
+  return kTfLiteOk;
+}
+
+TensorLayout OperationsBase::GetElementwiseLayout(
+    const std::vector<int> &indices) {
+  bool any_nchw = false;
+  for (int index : indices) {
+    if (GetDims(index).size() != 4) return TensorLayout::kNHWC;
+    any_nchw |= node_manager_->getLayout(index) == TensorLayout::kNCHW;
+  }
+  return any_nchw ? TensorLayout::kNCHW : TensorLayout::kNHWC;
+}
+
+std::shared_ptr<ov::Node> OperationsBase::AddChannelBias(
+    std::shared_ptr<ov::Node> input, ov::Output<ov::Node> bias) {
+  auto constant =
+      ov::as_type_ptr<ov::opset8::Constant>(bias.get_node_shared_ptr());
+  if (constant != nullptr) {
+    // Same data, already in the broadcastable shape.
+    auto channel_bias = std::make_shared<ov::opset8::Constant>(
+        constant->get_element_type(),
+        ov::Shape{1, ov::shape_size(constant->get_shape()), 1, 1},
+        constant->get_data_ptr());
+    return std::make_shared<ov::opset8::Add>(input, channel_bias,
+                                             ov::op::AutoBroadcastType::NUMPY);
+  }
+  auto shape_node = CreateConstNode(ov::element::i64, ov::Shape{4},
+                                    std::vector<int64_t>{1, -1, 1, 1});
+  auto channel_bias = std::make_shared<ov::opset8::Reshape>(
+      bias, shape_node, /*special_zero=*/false);
+  return std::make_shared<ov::opset8::Add>(input, channel_bias,
+                                           ov::op::AutoBroadcastType::NUMPY);
+}
+
 TfLiteStatus OperationsBase::CalculatePadding(TfLitePadding padding,
                                               ov::op::PadType &auto_pad) {
   switch (padding) {
@@ -128,5 +268,30 @@ std::pair<void *, int> OperationsBase::GetTensorDataPtrAndCount(int index) {
   return std::make_pair(tensor_data, count);
 }
 
+TfLiteStatus OperationsBase::GetQuantizationParams(
+    int index, std::vector<float> &scale, std::vector<int64_t> &zero_point,
+    int &quantized_dimension) {
+  auto opaque_tensor = TfLiteOpaqueContextGetOpaqueTensor(context_, index);
+  const TfLiteQuantization quantization =
+      TfLiteOpaqueTensorGetQuantization(opaque_tensor);
+  if (quantization.type != kTfLiteAffineQuantization ||
+      quantization.params == nullptr)
+    return kTfLiteError;
+  const auto *affine_quantization =
+      reinterpret_cast<const TfLiteAffineQuantization *>(quantization.params);
+  if (affine_quantization->scale == nullptr ||
+      affine_quantization->scale->size == 0)
+    return kTfLiteError;
+
+  const TfLiteFloatArray *scales = affine_quantization->scale;
+  scale.assign(scales->data, scales->data + scales->size);
+  zero_point.assign(scale.size(), 0);
+  const TfLiteIntArray *zero_points = affine_quantization->zero_point;
+  if (zero_points != nullptr && zero_points->size == scales->size)
+    zero_point.assign(zero_points->data, zero_points->data + zero_points->size);
+  quantized_dimension = affine_quantization->quantized_dimension;
+  return kTfLiteOk;
+}
+
 }  // namespace openvinodelegate
 }  // namespace tflite
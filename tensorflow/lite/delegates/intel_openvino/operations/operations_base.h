@@ -44,6 +44,8 @@ class OperationsBase {
                     NodeManager *node_manager);
 
   std::shared_ptr<ov::Node> GetOpResultNode() { return output_node_; }
+  // Layout of the result node; see TensorLayout.
+  TensorLayout GetOpResultLayout() const { return output_layout_; }
   virtual TfLiteStatus CreateNode() = 0;
   virtual ~OperationsBase() {}
 
@@ -56,6 +58,8 @@ class OperationsBase {
   } LayoutConversion;
 
   std::shared_ptr<ov::Node> output_node_;
+  // Converters that leave |output_node_| in NCHW set this accordingly.
+  TensorLayout output_layout_ = TensorLayout::kNHWC;
   template <typename T>
   T *GetBuiltinData() {
     return reinterpret_cast<T *>(builtin_data_);
@@ -64,6 +68,13 @@ class OperationsBase {
   std::shared_ptr<ov::Node> getInputNode(int index) {
     return node_manager_->getInterimNodeOutput(index);
   }
+  std::shared_ptr<ov::Node> getInputNode(int index, TensorLayout layout) {
+    return node_manager_->getInterimNodeOutput(index, layout);
+  }
+  // Layout for an op that is indifferent to it, over the tensors |indices|:
+  // NCHW if one of them already is and all of them are rank 4, so that
+  // broadcasting between them is unaffected by the permutation.
+  TensorLayout GetElementwiseLayout(const std::vector<int> &indices);
   NodeManager *GetGraphNodeManager() { return node_manager_; }
 
   template <typename T>
@@ -79,6 +90,19 @@ class OperationsBase {
   TfLiteStatus Transpose(LayoutConversion type, std::shared_ptr<ov::Node> input,
                          std::shared_ptr<ov::Node> &transposed_node);
 
+  // |filter| transposed by |type| (IHWO_OIHW or OHWI_OIHW) and, unless
+  // |group_shape| is empty, reshaped to it. A Constant filter is reordered
+  // once here into a single Constant in the target shape, so the compiled
+  // model does not fold a Transpose or keep both layouts resident.
+  TfLiteStatus TransposeFilter(LayoutConversion type,
+                               std::shared_ptr<ov::Node> filter,
+                               const ov::Shape &group_shape,
+                               std::shared_ptr<ov::Node> &transposed_filter);
+
+  // Adds |bias| of shape [C] to the NCHW |input|.
+  std::shared_ptr<ov::Node> AddChannelBias(std::shared_ptr<ov::Node> input,
+                                           ov::Output<ov::Node> bias);
+
   std::shared_ptr<ov::Node> ApplyActivation(std::shared_ptr<ov::Node> input,
                                             TfLiteFusedActivation activation);
 
@@ -90,6 +114,12 @@ class OperationsBase {
 
   std::pair<void *, int> GetTensorDataPtrAndCount(int index);
 
+  // Affine quantization parameters of tensor |index|. Missing zero points
+  // are returned as 0.
+  TfLiteStatus GetQuantizationParams(int index, std::vector<float> &scale,
+                                     std::vector<int64_t> &zero_point,
+                                     int &quantized_dimension);
+
   const int *tensor_indices_;
   int tensor_indices_size_;
 
@@ -10,7 +10,8 @@ namespace openvinodelegate {
 
 TfLiteStatus AveragePool2D::CreateNode() {
   auto *avg_pool_params = GetBuiltinData<TfLitePoolParams>();
-  auto input_node = getInputNode(tensor_indices_[INPUT_NODE_1]);
+  auto input_node =
+      getInputNode(tensor_indices_[INPUT_NODE_1], TensorLayout::kNCHW);
   if (input_node == nullptr) {
     // // // TFLITE_LOG(ERROR) << "input node is null";
     return kTfLiteError;
@@ -30,18 +31,13 @@ TfLiteStatus AveragePool2D::CreateNode() {
     return kTfLiteError;
   }
 
-  std::shared_ptr<ov::Node> transposed_input_node;
-  if (Transpose(NHWC_NCHW, input_node, transposed_input_node) != kTfLiteOk)
-    return kTfLiteError;
-
   auto average_pool_2d_node = std::make_shared<ov::opset8::AvgPool>(
-      transposed_input_node, strides, padding_begin, padding_end, kernel,
+      input_node, strides, padding_begin, padding_end, kernel,
       /*exclude_pad=*/true, ov::op::RoundingType::FLOOR, auto_pad);
 
-  if (Transpose(NCHW_NHWC, average_pool_2d_node, output_node_) != kTfLiteOk)
-    return kTfLiteError;
-
-  output_node_ = ApplyActivation(output_node_, avg_pool_params->activation);
+  output_layout_ = TensorLayout::kNCHW;
+  output_node_ =
+      ApplyActivation(average_pool_2d_node, avg_pool_params->activation);
 
   return kTfLiteOk;
 }
@@ -12,14 +12,22 @@ TfLiteStatus Concat::CreateNode() {
   auto *concat_params = GetBuiltinData<TfLiteConcatenationParams>();
 
   size_t n = tensor_indices_size_;
+  std::vector<int> indices(tensor_indices_, tensor_indices_ + n);
+  output_layout_ = GetElementwiseLayout(indices);
+  int64_t axis = concat_params->axis;
+  if (output_layout_ == TensorLayout::kNCHW) {
+    // Concatenate the NCHW inputs along the same logical axis.
+    static const int64_t kNHWCAxisInNCHW[] = {0, 2, 3, 1};
+    axis = kNHWCAxisInNCHW[axis < 0 ? axis + 4 : axis];
+  }
+
   std::vector<ov::Output<ov::Node>> inputs;
   for (size_t i = 0; i < n; i++) {
-    auto inputOp = getInputNode(tensor_indices_[i]);
+    auto inputOp = getInputNode(tensor_indices_[i], output_layout_);
     inputs.push_back(inputOp);
   }
 
-  auto concatNode =
-      std::make_shared<ov::opset8::Concat>(inputs, concat_params->axis);
+  auto concatNode = std::make_shared<ov::opset8::Concat>(inputs, axis);
   output_node_ = ApplyActivation(concatNode, concat_params->activation);
 
   return kTfLiteOk;
@@ -33,43 +33,40 @@ TfLiteStatus Conv2D::CreateNode() {
     return kTfLiteError;
   }
 
-  auto input_node = getInputNode(tensor_indices_[INPUT_NODE_1]);
+  auto input_node =
+      getInputNode(tensor_indices_[INPUT_NODE_1], TensorLayout::kNCHW);
   auto filter_node = getInputNode(tensor_indices_[FILTER_NODE]);
 
-  std::shared_ptr<ov::Node> transposed_filter_node, transposed_input_node;
-  if (Transpose(OHWI_OIHW, filter_node, transposed_filter_node) != kTfLiteOk)
-    return kTfLiteError;
-  if (Transpose(NHWC_NCHW, input_node, transposed_input_node) != kTfLiteOk)
+  auto input_shape = input_node->get_shape();          // NCHW
+  auto filter_shape = filter_node->get_shape();        // G*Cout,H,W,Cin
+  auto num_groups = input_shape[1] / filter_shape[3];  // G = C/Cin
+  ov::Shape group_shape;
+  if (num_groups > 1) {
+    // G, Cout, Cin, H, W
+    group_shape = {num_groups, filter_shape[0] / num_groups, filter_shape[3],
+                   filter_shape[1], filter_shape[2]};
+  }
+  std::shared_ptr<ov::Node> transposed_filter_node;
+  if (TransposeFilter(OHWI_OIHW, filter_node, group_shape,
+                      transposed_filter_node) != kTfLiteOk)
     return kTfLiteError;
 
-  auto input_shape = transposed_input_node->get_shape();    // NCHW
-  auto filter_shape = transposed_filter_node->get_shape();  // G*Cout,Cin,H,W
-  auto num_groups = input_shape[1] / filter_shape[1];       // G = C/Cin
   std::shared_ptr<ov::Node> conv_node;
   if (num_groups > 1) {
-    filter_shape[0] /= num_groups;  // G*Cout/G
-    filter_shape.insert(filter_shape.begin(), num_groups);
-    auto shape_node = CreateConstNode(
-        ov::element::i32, ov::Shape{filter_shape.size()}, filter_shape);
-    transposed_filter_node = std::make_shared<ov::opset3::Reshape>(
-        transposed_filter_node, shape_node, /*special_zero=*/false);
     // Perform group convolution since no. of groups > 1
     conv_node = std::make_shared<ov::opset3::GroupConvolution>(
-        transposed_input_node, transposed_filter_node, strides, padding_begin,
+        input_node, transposed_filter_node, strides, padding_begin,
         padding_end, dilations, auto_pad);
   } else {
     conv_node = std::make_shared<ov::opset8::Convolution>(
-        transposed_input_node, transposed_filter_node, strides, padding_begin,
+        input_node, transposed_filter_node, strides, padding_begin,
         padding_end, dilations, auto_pad);
   }
 
-  if (Transpose(NCHW_NHWC, conv_node, output_node_) != kTfLiteOk)
-    return kTfLiteError;
-
-  if (has_bias) {
-    output_node_ = std::make_shared<ov::opset3::Add>(
-        output_node_, bias_node, ov::op::AutoBroadcastType::NUMPY);
-  }
+  // The output stays NCHW for the next layout-sensitive consumer.
+  output_node_ = conv_node;
+  output_layout_ = TensorLayout::kNCHW;
+  if (has_bias) output_node_ = AddChannelBias(output_node_, bias_node);
 
   output_node_ = ApplyActivation(output_node_, conv2d_params->activation);
   return kTfLiteOk;
@@ -11,7 +11,8 @@ namespace openvinodelegate {
 TfLiteStatus DepthwiseConv2D::CreateNode() {
   auto *depth_conv2dParams = GetBuiltinData<TfLiteDepthwiseConvParams>();
   // TODO: check for datatypes, tensor shapes, and non dynamic allocation
-  auto input_node = getInputNode(tensor_indices_[INPUT_NODE_1]);
+  auto input_node =
+      getInputNode(tensor_indices_[INPUT_NODE_1], TensorLayout::kNCHW);
   auto filter_node = getInputNode(tensor_indices_[FILTER_NODE]);
   bool has_bias = false;
   ov::Output<ov::Node> bias_node;
@@ -36,35 +37,25 @@ TfLiteStatus DepthwiseConv2D::CreateNode() {
     return kTfLiteError;
   }
 
-  std::shared_ptr<ov::Node> transposed_filter_node, transposed_input_node;
-  if (Transpose(IHWO_OIHW, filter_node, transposed_filter_node) != kTfLiteOk)
+  // I,H,W,O with O = C * depth_multiplier, grouped as G, O/G, I, H, W.
+  const ov::Shape &filter_shape = filter_node->get_shape();
+  size_t num_groups = input_dims[3] / filter_shape[0];
+  const ov::Shape group_shape = {num_groups, filter_shape[3] / num_groups,
+                                 filter_shape[0], filter_shape[1],
+                                 filter_shape[2]};
+  std::shared_ptr<ov::Node> transposed_filter_node;
+  if (TransposeFilter(IHWO_OIHW, filter_node, group_shape,
+                      transposed_filter_node) != kTfLiteOk)
     return kTfLiteError;
-  if (Transpose(NHWC_NCHW, input_node, transposed_input_node) != kTfLiteOk)
-    return kTfLiteError;
-
-  std::vector<size_t> shape(&transposed_filter_node->get_shape()[0],
-                            &transposed_filter_node->get_shape()[0] + 4);
-  auto num_groups = input_dims[3] / transposed_filter_node->get_shape()[1];
-  shape.insert(shape.begin(), num_groups);
-  shape[1] = transposed_filter_node->get_shape()[0] / num_groups;
-  auto shape_node =
-      CreateConstNode(ov::element::i32, ov::Shape{shape.size()}, shape);
-
-  transposed_filter_node = std::make_shared<ov::opset3::Reshape>(
-      transposed_filter_node, shape_node, true);
 
   auto depthwise_conv_node = std::make_shared<ov::opset3::GroupConvolution>(
-      transposed_input_node, transposed_filter_node, ov::Strides(strides),
+      input_node, transposed_filter_node, ov::Strides(strides),
       ov::CoordinateDiff(0, 0), ov::CoordinateDiff(0, 0),
       ov::Strides(dilations), auto_pad);
 
-  if (Transpose(NCHW_NHWC, depthwise_conv_node, output_node_) != kTfLiteOk)
-    return kTfLiteError;
-
-  if (has_bias) {
-    output_node_ = std::make_shared<ov::opset3::Add>(
-        output_node_, bias_node, ov::op::AutoBroadcastType::NUMPY);
-  }
+  output_node_ = depthwise_conv_node;
+  output_layout_ = TensorLayout::kNCHW;
+  if (has_bias) output_node_ = AddChannelBias(output_node_, bias_node);
 
   output_node_ = ApplyActivation(output_node_, depth_conv2dParams->activation);
   return kTfLiteOk;
@@ -5,6 +5,8 @@
 
 #include "../include/dequantize.h"
 
+#include "../utility.h"
+
 namespace tflite {
 namespace openvinodelegate {
 
@@ -15,8 +17,60 @@ TfLiteStatus Dequantize::CreateNode() {
     return kTfLiteError;
   }
 
-  output_node_ =
+  ov::element::Type input_type = GetTensorType(tensor_indices_[INPUT_NODE_1]);
+  if (input_type == ov::element::f16) {
+    // fp16 weights stay resident as f16; the plugin decompresses them or
+    // computes in f16 directly.
+    output_node_ =
+        std::make_shared<ov::opset8::Convert>(inputNode, ov::element::f32);
+    if (ov::is_type<ov::opset8::Constant>(inputNode))
+      MarkAsDecompression(inputNode, output_node_);
+    return kTfLiteOk;
+  }
+  if (input_type != ov::element::i8 && input_type != ov::element::u8 &&
+      input_type != ov::element::i4)
+    return kTfLiteError;
+
+  std::vector<float> scale;
+  std::vector<int64_t> zero_point;
+  int axis;
+  if (GetQuantizationParams(tensor_indices_[INPUT_NODE_1], scale, zero_point,
+                            axis) != kTfLiteOk)
+    return kTfLiteError;
+
+  // Per-channel parameters broadcast along |axis| of the weights.
+  std::vector<int> dims = GetDims(tensor_indices_[INPUT_NODE_1]);
+  ov::Shape param_shape{1};
+  if (scale.size() > 1) {
+    if (axis < 0 || static_cast<size_t>(axis) >= dims.size() ||
+        static_cast<size_t>(dims[axis]) != scale.size())
+      return kTfLiteError;
+    param_shape = ov::Shape(dims.size(), 1);
+    param_shape[axis] = scale.size();
+  }
+
+  // Convert -> Subtract(zero point) -> Multiply(scale) over the compressed
+  // constant is the decompression pattern the CPU plugin executes on the fly,
+  // keeping the weights in their int8/int4 storage type.
+  auto convert =
       std::make_shared<ov::opset8::Convert>(inputNode, ov::element::f32);
+  if (ov::is_type<ov::opset8::Constant>(inputNode))
+    MarkAsDecompression(inputNode, convert);
+
+  std::shared_ptr<ov::Node> decompressed = convert;
+  bool has_zero_point = false;
+  for (int64_t zp : zero_point) has_zero_point |= zp != 0;
+  if (has_zero_point) {
+    auto zero_point_node =
+        CreateConstNode(input_type, param_shape, zero_point);
+    auto zero_point_convert = std::make_shared<ov::opset8::Convert>(
+        zero_point_node, ov::element::f32);
+    MarkAsDecompression(zero_point_node, zero_point_convert);
+    decompressed =
+        std::make_shared<ov::opset8::Subtract>(decompressed, zero_point_convert);
+  }
+  auto scale_node = CreateConstNode(ov::element::f32, param_shape, scale);
+  output_node_ = std::make_shared<ov::opset8::Multiply>(decompressed, scale_node);
 
   return kTfLiteOk;
 }
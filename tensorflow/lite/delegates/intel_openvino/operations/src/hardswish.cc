@@ -9,7 +9,9 @@ namespace tflite {
 namespace openvinodelegate {
 
 TfLiteStatus HardSwish::CreateNode() {
-  auto input_node = getInputNode(tensor_indices_[INPUT_NODE_1]);
+  output_layout_ = GetElementwiseLayout({tensor_indices_[INPUT_NODE_1]});
+  auto input_node =
+      getInputNode(tensor_indices_[INPUT_NODE_1], output_layout_);
   if (input_node == nullptr) {
     return kTfLiteError;
   }
@@ -10,12 +10,16 @@ namespace openvinodelegate {
 
 TfLiteStatus Mul::CreateNode() {
   auto *mul_params = GetBuiltinData<TfLiteMulParams>();
-  auto input_node_1 = getInputNode(tensor_indices_[INPUT_NODE_1]);
+  output_layout_ = GetElementwiseLayout(
+      {tensor_indices_[INPUT_NODE_1], tensor_indices_[INPUT_NODE_2]});
+  auto input_node_1 =
+      getInputNode(tensor_indices_[INPUT_NODE_1], output_layout_);
   if (input_node_1 == nullptr) {
     // // // TFLITE_LOG(INFO) << "input node 1 is null";
     return kTfLiteError;
   }
-  auto input_node_2 = getInputNode(tensor_indices_[INPUT_NODE_2]);
+  auto input_node_2 =
+      getInputNode(tensor_indices_[INPUT_NODE_2], output_layout_);
   if (input_node_2 == nullptr) {
     // // // TFLITE_LOG(INFO) << "input Node 2 is null";
     return kTfLiteError;
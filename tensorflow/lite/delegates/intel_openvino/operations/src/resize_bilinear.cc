@@ -10,7 +10,8 @@ namespace openvinodelegate {
 
 TfLiteStatus ResizeBilinear::CreateNode() {
   auto *resize_bilinearParams = GetBuiltinData<TfLiteResizeBilinearParams>();
-  auto input_node = getInputNode(tensor_indices_[INPUT_NODE_1]);
+  auto input_node =
+      getInputNode(tensor_indices_[INPUT_NODE_1], TensorLayout::kNCHW);
   auto shape_node = getInputNode(tensor_indices_[INPUT_NODE_2]);
   struct ov::op::v11::Interpolate::InterpolateAttrs attrs;
 
@@ -28,18 +29,12 @@ TfLiteStatus ResizeBilinear::CreateNode() {
         ov::op::v11::Interpolate::CoordinateTransformMode::ASYMMETRIC;
   }
 
-  std::shared_ptr<ov::Node> transposed_input_node;
-  if (Transpose(NHWC_NCHW, input_node, transposed_input_node) != kTfLiteOk)
-    return kTfLiteError;
-
   std::vector<int32_t> axes_vec = {2, 3};
   auto axes_node = CreateConstNode(ov::element::i32, /*size=*/{2}, axes_vec);
 
   output_node_ = std::make_shared<ov::op::v11::Interpolate>(
-      transposed_input_node, shape_node, axes_node, attrs);
-
-  if (Transpose(NCHW_NHWC, output_node_, output_node_) != kTfLiteOk)
-    return kTfLiteError;
+      input_node, shape_node, axes_node, attrs);
+  output_layout_ = TensorLayout::kNCHW;
 
   return kTfLiteOk;
 }
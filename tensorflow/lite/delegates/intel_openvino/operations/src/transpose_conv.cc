@@ -13,7 +13,8 @@ TfLiteStatus TransposeConv::CreateNode() {
   std::shared_ptr<ov::Node> weights_node = nullptr;
   std::shared_ptr<ov::Node> input_node = nullptr;
   weights_node = getInputNode(tensor_indices_[TRANSPOSE_CONV_WEIGHTS]);
-  input_node = getInputNode(tensor_indices_[TRANSPOSE_CONV_INPUT]);
+  input_node =
+      getInputNode(tensor_indices_[TRANSPOSE_CONV_INPUT], TensorLayout::kNCHW);
   bool has_bias = false;
   std::shared_ptr<ov::Node> bias_node = nullptr;
   if (tensor_indices_size_ >= 4) {
@@ -46,26 +47,18 @@ TfLiteStatus TransposeConv::CreateNode() {
   auto output_shape_node = std::make_shared<ov::opset8::Constant>(
       ov::element::i32, ov::Shape{spatial_dimensions_size}, spatial_dimensions);
 
-  std::shared_ptr<ov::Node> transposed_weights_node, transposed_input_node;
-  if (Transpose(IHWO_OIHW, weights_node, transposed_weights_node) != kTfLiteOk)
-    return kTfLiteError;
-  if (Transpose(NHWC_NCHW, input_node, transposed_input_node) != kTfLiteOk)
+  std::shared_ptr<ov::Node> transposed_weights_node;
+  if (TransposeFilter(IHWO_OIHW, weights_node, /*group_shape=*/{},
+                      transposed_weights_node) != kTfLiteOk)
     return kTfLiteError;
 
   transpose_conv_node = std::make_shared<ov::opset3::ConvolutionBackpropData>(
-      transposed_input_node, transposed_weights_node, output_shape_node,
-      strides, padding_begin, padding_end, dilations, auto_pad);
-
-  if (Transpose(NCHW_NHWC, transpose_conv_node, transpose_conv_node) !=
-      kTfLiteOk)
-    return kTfLiteError;
+      input_node, transposed_weights_node, output_shape_node, strides,
+      padding_begin, padding_end, dilations, auto_pad);
 
-  if (has_bias) {
-    output_node_ = std::make_shared<ov::opset3::Add>(
-        transpose_conv_node, bias_node, ov::op::AutoBroadcastType::NUMPY);
-  } else {
-    output_node_ = transpose_conv_node;
-  }
+  output_node_ = transpose_conv_node;
+  output_layout_ = TensorLayout::kNCHW;
+  if (has_bias) output_node_ = AddChannelBias(output_node_, bias_node);
   output_node_ =
       ApplyActivation(output_node_, transpose_conv_params->activation);
   return kTfLiteOk;
@@ -7,7 +7,14 @@
 #define DELEGATE_INTEL_OPENVINO_OPERATIONS_UTILITY_H_
 
 #include <openvino/openvino.hpp>
+#include <transformations/rt_info/decompression.hpp>
+#include <transformations/rt_info/disable_fp16_compression.hpp>
+#include <transformations/rt_info/keep_const_precision.hpp>
 
+#include <memory>
+#include <string>
+
+#include "tensorflow/lite/c/builtin_op_data.h"
 #include "tensorflow/lite/c/c_api_types.h"
 
 namespace tflite {
@@ -33,6 +40,17 @@ inline std::string get_activation_string(TfLiteFusedActivation activation) {
   }
   }
 
+inline std::string get_padding_string(TfLitePadding padding) {
+  switch (padding) {
+    case kTfLitePaddingSame:
+      return "SAME";
+    case kTfLitePaddingValid:
+      return "VALID";
+    default:
+      return "UNKNOWN";
+  }
+}
+
 inline ov::element::Type GetOVElementType(TfLiteType tensor_type) {
   ov::element::Type ov_element_type;
   switch (tensor_type) {
@@ -81,6 +99,41 @@ inline ov::element::Type GetOVElementType(TfLiteType tensor_type) {
   return ov_element_type;
 }
 
+// Runtime info understood by OpenVINO's common transformations: a Convert
+// marked as decompression is kept out of constant folding and fused into the
+// consuming MatMul/Convolution by the CPU plugin, and keep_const_precision
+// stops the low precision weights from being converted to f32 up front. Both
+// survive serialization into the cache.
+inline void MarkAsDecompression(const std::shared_ptr<ov::Node> &weights,
+                                const std::shared_ptr<ov::Node> &convert) {
+  ov::enable_keep_const_precision(weights);
+  ov::mark_as_decompression(convert);
+}
+
+// Keeps |node| in f32 when the model is compiled with a reduced inference
+// precision (bf16 or f16).
+inline void KeepInF32(const std::shared_ptr<ov::Node> &node) {
+  ov::disable_fp16_compression(node);
+}
+
+// Marks every Convert of a low precision (f16 or integer) constant to f32 in
+// |model| as decompression, so the weights stay resident in their stored
+// precision no matter which path built the model.
+inline void KeepCompressedWeights(const std::shared_ptr<ov::Model> &model) {
+  for (const auto &op : model->get_ordered_ops()) {
+    if (!ov::is_type<ov::op::v0::Convert>(op) ||
+        op->get_output_element_type(0) != ov::element::f32)
+      continue;
+    auto weights = op->get_input_node_shared_ptr(0);
+    if (!ov::is_type<ov::op::v0::Constant>(weights)) continue;
+    const ov::element::Type type = weights->get_output_element_type(0);
+    if (type == ov::element::f16 || type == ov::element::i8 ||
+        type == ov::element::u8 || type == ov::element::i4 ||
+        type == ov::element::u4)
+      MarkAsDecompression(weights, op);
+  }
+}
+
 }  // namespace openvinodelegate
 }  // namespace tflite
 